@@ -31,6 +31,79 @@
 #include "player-timed.h"
 #include "trap.h"
 
+/**
+ * Bumped to throw away every cell of the render cache at once
+ */
+static u32b render_stamp = 1;
+
+/**
+ * Forget the cached look of a grid on the player's map, because the player's
+ * knowledge of it has changed.
+ */
+void map_render_forget(struct chunk *c, struct loc grid)
+{
+	if (c->render) c->render[grid.y * c->width + grid.x].stamp = 0;
+}
+
+/**
+ * Forget the cached look of every grid, because something that affects how
+ * all of them look (such as which objects are ignored) has changed.
+ */
+void map_render_forget_all(void)
+{
+	/* Zero marks a forgotten cell */
+	if (++render_stamp == 0) ++render_stamp;
+}
+
+/**
+ * Get a number that changes whenever the whole render cache is forgotten, for
+ * other caches built from what the player knows.
+ */
+u32b map_render_generation(void)
+{
+	return render_stamp;
+}
+
+/**
+ * Get the look of a grid on the player's map which only depends on what the
+ * player knows - the feature and the objects - working it out if it isn't
+ * already in the render cache.
+ */
+static const struct render_cell *map_render_cell(struct chunk *c,
+		struct loc grid)
+{
+	struct render_cell *cell;
+
+	if (!c->render)
+		c->render = mem_zalloc(c->height * c->width * sizeof(*c->render));
+	cell = &c->render[grid.y * c->width + grid.x];
+
+	if (cell->stamp != render_stamp) {
+		struct object *obj;
+
+		cell->feat = f_info[square(c, grid)->feat].mimic_idx;
+		cell->kidx = 0;
+		cell->flags = 0;
+		for (obj = square_object(c, grid); obj; obj = obj->next) {
+			if (obj->kind == unknown_gold_kind) {
+				cell->flags |= RENDER_UNSEEN_MONEY;
+			} else if (obj->kind == unknown_item_kind) {
+				cell->flags |= RENDER_UNSEEN_OBJECT;
+			} else if (ignore_known_item_ok(player, obj)) {
+				/* Item stays hidden */
+			} else if (!cell->kidx) {
+				cell->kidx = obj->kind->kidx + 1;
+			} else {
+				cell->flags |= RENDER_MULTIPLE;
+				break;
+			}
+		}
+		cell->stamp = render_stamp;
+	}
+
+	return cell;
+}
+
 /**
  * This function takes a grid location and extracts information the
  * player is allowed to know about it, filling in the grid_data structure
@@ -82,23 +155,14 @@
  */
 void map_info(struct loc grid, struct grid_data *g)
 {
-	struct object *obj;
+	const struct render_cell *cell;
 
 	assert(grid.x < cave->width);
 	assert(grid.y < cave->height);
 
 	/* Default "clear" values, others will be set later where appropriate. */
-	g->first_kind = NULL;
 	g->trap = NULL;
-	g->multiple_objects = false;
 	g->lighting = LIGHTING_LIT;
-	g->unseen_object = false;
-	g->unseen_money = false;
-
-	/* Use real feature (remove later) */
-	g->f_idx = square(cave, grid)->feat;
-	if (f_info[g->f_idx].mimic)
-		g->f_idx = lookup_feat(f_info[g->f_idx].mimic);
 
 	g->in_view = (square_isseen(cave, grid)) ? true : false;
 	g->is_player = (square(cave, grid)->mon < 0) ? true : false;
@@ -129,10 +193,13 @@ void map_info(struct loc grid, struct grid_data *g)
 		g->lighting = LIGHTING_LIT;
 	}
 
-	/* Use known feature */
-	g->f_idx = square(player->cave, grid)->feat;
-	if (f_info[g->f_idx].mimic)
-		g->f_idx = lookup_feat(f_info[g->f_idx].mimic);
+	/* Use known feature and objects */
+	cell = map_render_cell(player->cave, grid);
+	g->f_idx = cell->feat;
+	g->first_kind = cell->kidx ? &k_info[cell->kidx - 1] : NULL;
+	g->multiple_objects = (cell->flags & RENDER_MULTIPLE) ? true : false;
+	g->unseen_object = (cell->flags & RENDER_UNSEEN_OBJECT) ? true : false;
+	g->unseen_money = (cell->flags & RENDER_UNSEEN_MONEY) ? true : false;
 
 	/* There is a known trap in this square */
 	if (square_trap(player->cave, grid) && square_isknown(cave, grid)) {
@@ -155,22 +222,6 @@ void map_info(struct loc grid, struct grid_data *g)
 		}
     }
 
-	/* Objects */
-	for (obj = square_object(player->cave, grid); obj; obj = obj->next) {
-		if (obj->kind == unknown_gold_kind) {
-			g->unseen_money = true;
-		} else if (obj->kind == unknown_item_kind) {
-			g->unseen_object = true;
-		} else if (ignore_known_item_ok(player, obj)) {
-			/* Item stays hidden */
-		} else if (!g->first_kind) {
-			g->first_kind = obj->kind;
-		} else {
-			g->multiple_objects = true;
-			break;
-		}
-	}
-
 	/* Monsters */
 	if (g->m_idx > 0) {
 		/* If the monster isn't "visible", make sure we don't list it.*/
@@ -252,11 +303,12 @@ void square_note_spot(struct chunk *c, struct loc grid)
 /**
  * Tell the UI that a given map location has been updated
  *
- * This function should only be called on "legal" grids.
+ * This function should only be called on "legal" grids.  Grids in a batch of
+ * terrain changes are left for the end of the batch.
  */
 void square_light_spot(struct chunk *c, struct loc grid)
 {
-	if ((c == cave) && player->cave) {
+	if ((c == cave) && player->cave && !cave_batch_holds(c, grid)) {
 		player->upkeep->redraw |= PR_ITEMLIST;
 		event_signal_point(EVENT_MAP, grid.x, grid.y);
 	}
@@ -645,4 +697,8 @@ void cave_known(struct player *p)
 			}
 		}
 	}
+
+	/* The whole known map has changed */
+	cave_terrain_changed(p->cave);
+	cave_journal_all(p->cave);
 }
@@ -25,6 +25,7 @@
 #include "obj-pile.h"
 #include "obj-util.h"
 #include "object.h"
+#include "player-path.h"
 #include "player-quest.h"
 #include "player-timed.h"
 #include "player-util.h"
@@ -1247,6 +1248,7 @@ bool square_holds_object(struct chunk *c, struct loc grid, struct object *obj) {
 void square_excise_object(struct chunk *c, struct loc grid, struct object *obj){
 	assert(square_in_bounds(c, grid));
 	pile_excise(&c->squares[grid.y][grid.x].obj, obj);
+	cave_journal_note(c, grid, KNOWN_CHANGE_OBJECT);
 }
 
 /**
@@ -1256,6 +1258,7 @@ void square_excise_pile(struct chunk *c, struct loc grid) {
 	assert(square_in_bounds(c, grid));
 	object_pile_free(c, square_object(c, grid));
 	square_set_obj(c, grid, NULL);
+	cave_journal_note(c, grid, KNOWN_CHANGE_OBJECT);
 }
 
 /**
@@ -1391,6 +1394,8 @@ int square_num_walls_diagonal(struct chunk *c, struct loc grid)
 void square_set_feat(struct chunk *c, struct loc grid, int feat)
 {
 	int current_feat;
+	bool batched = cave_batch_holds(c, grid);
+	bool planes = cave_planes_current(c);
 
 	assert(square_in_bounds(c, grid));
 	current_feat = square(c, grid)->feat;
@@ -1401,12 +1406,14 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
 		feat = FEAT_ROAD;
 	}
 
-	/* Track changes */
-	if (current_feat) c->feat_count[current_feat]--;
-	if (feat) c->feat_count[feat]++;
-
-	/* Make the change */
+	/* Make the change, leaving a batch to keep track of it */
 	c->squares[grid.y][grid.x].feat = feat;
+	if (!batched) {
+		if (current_feat) c->feat_count[current_feat]--;
+		if (feat) c->feat_count[feat]++;
+		cave_terrain_changed(c);
+		cave_planes_note(c, grid, planes);
+	}
 
 	/* Light bright terrain */
 	if (feat_is_bright(feat)) {
@@ -1419,9 +1426,14 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
 		if (!square_player_trap_allowed(c, grid))
 			square_destroy_trap(c, grid);
 
-		/* Remove objects if necessary */
-		if (!square_isobjectholding(c, grid))
-			square_excise_pile(c, grid);
+		/* Remove objects if necessary, leaving any the player remembers
+		 * to be forgotten when they next see the grid */
+		if (!square_isobjectholding(c, grid)) {
+			while (square_object(c, grid)) {
+				square_delete_object(c, grid, square_object(c, grid),
+					false, false);
+			}
+		}
 
 		square_note_spot(c, grid);
 		square_light_spot(c, grid);
@@ -1438,8 +1450,15 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
  */
 static void square_set_known_feat(struct chunk *c, struct loc grid, int feat)
 {
+	bool planes;
+
 	if (c != cave) return;
+	if (player->cave->squares[grid.y][grid.x].feat == feat) return;
+	planes = cave_planes_current(player->cave);
 	player->cave->squares[grid.y][grid.x].feat = feat;
+	path_regions_note(grid);
+	cave_journal_note(player->cave, grid, KNOWN_CHANGE_FEAT);
+	cave_planes_note(player->cave, grid, planes);
 }
 
 /**
@@ -1697,24 +1716,18 @@ int square_digging(struct chunk *c, struct loc grid) {
 }
 
 const char *square_apparent_name(struct chunk *c, struct player *p, struct loc grid) {
-	int actual = square(player->cave, grid)->feat;
-	char *mimic_name = f_info[actual].mimic;
-	int f = mimic_name ? lookup_feat(mimic_name) : actual;
+	int f = f_info[square(player->cave, grid)->feat].mimic_idx;
 	return f_info[f].name;
 }
 
 const char *square_apparent_look_prefix(struct chunk *c, struct player *p, struct loc grid) {
-	int actual = square(player->cave, grid)->feat;
-	char *mimic_name = f_info[actual].mimic;
-	int f = mimic_name ? lookup_feat(mimic_name) : actual;
+	int f = f_info[square(player->cave, grid)->feat].mimic_idx;
 	return (f_info[f].look_prefix) ? f_info[f].look_prefix :
 		(is_a_vowel(f_info[f].name[0]) ? "an " : "a ");
 }
 
 const char *square_apparent_look_in_preposition(struct chunk *c, struct player *p, struct loc grid) {
-	int actual = square(player->cave, grid)->feat;
-	char *mimic_name = f_info[actual].mimic;
-	int f = mimic_name ? lookup_feat(mimic_name) : actual;
+	int f = f_info[square(player->cave, grid)->feat].mimic_idx;
 	return (f_info[f].look_in_preposition) ?
 		 f_info[f].look_in_preposition : "on ";
 }
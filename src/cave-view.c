@@ -26,6 +26,7 @@
 #include "player-timed.h"
 #include "player-util.h"
 #include "trap.h"
+#include "z-profile.h"
 
 /**
  * Approximate distance between two points.
@@ -883,8 +884,11 @@ void update_view(struct chunk *c, struct player *p)
 {
 	int x, y;
 
+	PROFILE_BEGIN(UPDATE_VIEW);
+
 	/* Record the current view */
 	mark_wasseen(c);
+	c->view_stamp++;
 
 	/* Calculate light levels */
 	calc_lighting(c, p);
@@ -906,6 +910,8 @@ void update_view(struct chunk *c, struct player *p)
 	for (y = 0; y < c->height; y++)
 		for (x = 0; x < c->width; x++)
 			update_one(c, loc(x, y), p);
+
+	PROFILE_END(UPDATE_VIEW);
 }
 
 
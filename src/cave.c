@@ -31,8 +31,10 @@
 #include "obj-tval.h"
 #include "obj-util.h"
 #include "object.h"
+#include "player-calcs.h"
 #include "player-timed.h"
 #include "trap.h"
+#include "z-profile.h"
 #include "z-queue.h"
 
 struct feature *f_info;
@@ -396,6 +398,286 @@ void heatmap_free(struct chunk *c, struct heatmap map)
 	mem_free(map.grids);
 }
 
+/**
+ * Give a chunk a new terrain stamp.  Stamps are unique across all chunks, so
+ * anything remembered against a chunk's terrain (for instance, whether one
+ * grid is projectable from another) stays valid exactly as long as the stamp
+ * it was computed with is unchanged.
+ */
+void cave_terrain_changed(struct chunk *c)
+{
+	static u32b last_stamp = 0;
+
+	/* Zero is never a valid stamp */
+	if (++last_stamp == 0) ++last_stamp;
+	c->terrain_stamp = last_stamp;
+}
+
+/**
+ * Record a change to the player's knowledge of a grid.  Changes to chunks
+ * other than the player's current map aren't recorded.
+ */
+void cave_journal_note(struct chunk *c, struct loc grid, int what)
+{
+	struct known_journal *j = &c->journal;
+
+	if (!player || c != player->cave) return;
+	map_render_forget(c, grid);
+
+	/* Every change gets its own serial, even one to the grid changed last,
+	 * since a reader may already have read up to that one.  Start again
+	 * when full; readers that are behind redraw everything */
+	if (!j->changes) {
+		j->changes = mem_alloc(KNOWN_JOURNAL_MAX * sizeof(*j->changes));
+	} else if (j->count == KNOWN_JOURNAL_MAX) {
+		j->count = 0;
+		j->first = j->next;
+	}
+
+	j->changes[j->count].grid = grid;
+	j->changes[j->count].what = what;
+	j->count++;
+	j->next++;
+	player->upkeep->redraw |= PR_KNOWN;
+}
+
+/**
+ * Record that the player's knowledge of the whole chunk may have changed
+ */
+void cave_journal_all(struct chunk *c)
+{
+	struct known_journal *j = &c->journal;
+
+	j->count = 0;
+	j->first = ++j->next;
+	if (player && c == player->cave) {
+		map_render_forget_all();
+		player->upkeep->redraw |= PR_KNOWN;
+	}
+}
+
+/**
+ * Read the changes made since a reader last looked.
+ *
+ * \param c is the chunk
+ * \param cursor is the reader's position; it is moved past the changes read
+ * \param changes is set to the changes since *cursor
+ * \param n is set to the number of changes
+ * \return false if the changes are no longer all in the journal, or the
+ * cursor is from some other chunk; the reader should then assume everything
+ * has changed.
+ */
+bool cave_journal_read(const struct chunk *c, u32b *cursor,
+	const struct known_change **changes, int *n)
+{
+	const struct known_journal *j = &c->journal;
+	bool ok = (*cursor >= j->first && *cursor <= j->next);
+
+	*changes = ok ? j->changes + (*cursor - j->first) : NULL;
+	*n = ok ? (int)(j->next - *cursor) : 0;
+	*cursor = j->next;
+	return ok;
+}
+
+/**
+ * Get the terrain classes a feature belongs to, as PLANE_* bits
+ */
+static int feat_plane_classes(int feat)
+{
+	const struct feature *f = &f_info[feat];
+	int classes = 0;
+
+	if (tf_has(f->flags, TF_DOOR_ANY)) {
+		classes |= 1 << PLANE_DOOR;
+		if (tf_has(f->flags, TF_ROCK)) classes |= 1 << PLANE_SECRET_DOOR;
+	}
+	if (tf_has(f->flags, TF_STAIR)) classes |= 1 << PLANE_STAIR;
+	if (tf_has(f->flags, TF_GOLD)) classes |= 1 << PLANE_GOLD;
+	return classes;
+}
+
+/**
+ * Get one row of a terrain class plane
+ */
+static bitflag *cave_plane_row(struct chunk *c, int plane, int y)
+{
+	return c->planes->bits + (plane * c->height + y) * c->planes->row_size;
+}
+
+/**
+ * Put one grid's terrain into the planes
+ */
+static void cave_planes_set(struct chunk *c, struct loc grid)
+{
+	int plane, classes = feat_plane_classes(square(c, grid)->feat);
+
+	for (plane = 0; plane < PLANE_MAX; plane++) {
+		bitflag *row = cave_plane_row(c, plane, grid.y);
+		if (classes & (1 << plane)) {
+			flag_on(row, c->planes->row_size, grid.x + FLAG_START);
+		} else {
+			flag_off(row, c->planes->row_size, grid.x + FLAG_START);
+		}
+	}
+}
+
+/**
+ * True if the chunk's terrain class planes can be trusted; they can't be while
+ * a batch of changes is open, as the terrain stamp hasn't caught up yet
+ */
+bool cave_planes_current(const struct chunk *c)
+{
+	return c->planes && (c->planes->terrain_stamp == c->terrain_stamp) &&
+		!c->batch;
+}
+
+/**
+ * Record a change to the terrain of a grid in the chunk's planes.  current
+ * is what cave_planes_current() said just before the change; planes that
+ * were already out of date are left to be made again when next wanted.
+ */
+void cave_planes_note(struct chunk *c, struct loc grid, bool current)
+{
+	if (!current) return;
+	cave_planes_set(c, grid);
+	c->planes->terrain_stamp = c->terrain_stamp;
+}
+
+/**
+ * Make a chunk's terrain class planes afresh
+ */
+static void cave_planes_make(struct chunk *c)
+{
+	struct loc grid;
+
+	if (!c->planes) {
+		c->planes = mem_zalloc(sizeof(*c->planes));
+		c->planes->row_size = FLAG_SIZE(c->width);
+		c->planes->bits = mem_zalloc(PLANE_MAX * c->height *
+									 c->planes->row_size);
+	}
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			cave_planes_set(c, grid);
+		}
+	}
+	c->planes->terrain_stamp = c->terrain_stamp;
+}
+
+/**
+ * Find the grids of a terrain class in an area, row by row.
+ *
+ * \param c is the chunk to look in
+ * \param plane is the PLANE_* class
+ * \param tl is the top left corner of the area
+ * \param br is the grid diagonally beyond the bottom right corner
+ * \return the grids found, to be disposed of by the caller
+ */
+struct point_set *cave_plane_find(struct chunk *c, int plane, struct loc tl,
+	struct loc br)
+{
+	struct point_set *found = point_set_new(16);
+	int x, y;
+
+	if (!cave_planes_current(c)) cave_planes_make(c);
+
+	for (y = MAX(tl.y, 0); y < MIN(br.y, c->height); y++) {
+		const bitflag *row = cave_plane_row(c, plane, y);
+		int size = c->planes->row_size;
+		int end = MIN(br.x, c->width) + FLAG_START;
+
+		for (x = flag_next(row, size, MAX(tl.x, 0) + FLAG_START);
+			 (x != FLAG_END) && (x < end); x = flag_next(row, size, x + 1)) {
+			add_to_point_set(found, loc(x - FLAG_START, y));
+		}
+	}
+	return found;
+}
+
+/**
+ * Start a batch of terrain changes to an area of a chunk.
+ *
+ * Until cave_batch_end(), square_set_feat() on a grid in the area just
+ * changes the terrain, and redraws of grids in the area are held back; one
+ * redraw of the map covers them all at the end.  Nothing kept against the
+ * terrain stamp should be relied on while the batch is open.
+ *
+ * \param c is the chunk to be changed
+ * \param tl is the top left corner of the area
+ * \param br is the grid diagonally beyond the bottom right corner
+ */
+void cave_batch_begin(struct chunk *c, struct loc tl, struct loc br)
+{
+	struct terrain_batch *batch;
+	int x, y, n = 0;
+
+	assert(!c->batch);
+	batch = mem_zalloc(sizeof(*batch));
+	batch->tl = loc(MAX(tl.x, 0), MAX(tl.y, 0));
+	batch->br = loc(MAX(MIN(br.x, c->width), batch->tl.x),
+		MAX(MIN(br.y, c->height), batch->tl.y));
+	batch->feats = mem_alloc(MAX((batch->br.x - batch->tl.x) *
+		(batch->br.y - batch->tl.y), 1) * sizeof(u16b));
+
+	/* Copy the terrain as it is now */
+	for (y = batch->tl.y; y < batch->br.y; y++) {
+		for (x = batch->tl.x; x < batch->br.x; x++) {
+			batch->feats[n++] = c->squares[y][x].feat;
+		}
+	}
+	c->batch = batch;
+}
+
+/**
+ * True if a grid is in the area of a chunk's open batch of changes
+ */
+bool cave_batch_holds(const struct chunk *c, struct loc grid)
+{
+	return c->batch && (grid.x >= c->batch->tl.x) &&
+		(grid.y >= c->batch->tl.y) && (grid.x < c->batch->br.x) &&
+		(grid.y < c->batch->br.y);
+}
+
+/**
+ * Finish a batch of terrain changes, bringing feature counts and planes up
+ * to date for the grids that changed, moving the terrain stamp on once if
+ * any did, and asking for the map to be redrawn.
+ */
+void cave_batch_end(struct chunk *c)
+{
+	struct terrain_batch *batch = c->batch;
+	bool planes, changed = false;
+	int x, y, n = 0;
+
+	assert(batch);
+	c->batch = NULL;
+	planes = cave_planes_current(c);
+	for (y = batch->tl.y; y < batch->br.y; y++) {
+		for (x = batch->tl.x; x < batch->br.x; x++) {
+			int old = batch->feats[n++];
+			int feat = c->squares[y][x].feat;
+
+			if (feat == old) continue;
+			if (old) c->feat_count[old]--;
+			if (feat) c->feat_count[feat]++;
+			if (planes) cave_planes_set(c, loc(x, y));
+			changed = true;
+		}
+	}
+	if (changed) {
+		cave_terrain_changed(c);
+		if (planes) c->planes->terrain_stamp = c->terrain_stamp;
+	}
+
+	/* Everything held back is redrawn together */
+	if ((c == cave) && player->cave) {
+		player->upkeep->redraw |= (PR_MAP | PR_ITEMLIST);
+	}
+
+	mem_free(batch->feats);
+	mem_free(batch);
+}
+
 /**
  * Allocate a new chunk of the world
  */
@@ -421,6 +703,8 @@ struct chunk *cave_new(int height, int width) {
 	c->obj_max = OBJECT_LIST_SIZE - 1;
 
 	c->monsters = mem_zalloc(z_info->level_monster_max *sizeof(struct monster));
+	c->monsters_cold = mem_zalloc(z_info->level_monster_max *
+		sizeof(struct monster_cold));
 	c->mon_max = 1;
 	c->mon_current = -1;
 
@@ -430,6 +714,7 @@ struct chunk *cave_new(int height, int width) {
 	c->ghost = mem_zalloc(sizeof(struct ghost_info));
 
 	c->turn = turn;
+	cave_terrain_changed(c);
 	return c;
 }
 
@@ -478,8 +763,19 @@ void cave_free(struct chunk *c) {
 	heatmap_free(c, c->scent);
 
 	mem_free(c->feat_count);
+	mem_free(c->journal.changes);
+	mem_free(c->render);
+	if (c->batch) {
+		mem_free(c->batch->feats);
+		mem_free(c->batch);
+	}
+	if (c->planes) {
+		mem_free(c->planes->bits);
+		mem_free(c->planes);
+	}
 	mem_free(c->objects);
 	mem_free(c->monsters);
+	mem_free(c->monsters_cold);
 	mem_free(c->monster_groups);
 	if (c->ghost) {
 		mem_free(c->ghost);
@@ -679,6 +975,14 @@ struct monster *cave_monster(struct chunk *c, int idx) {
 	return &c->monsters[idx];
 }
 
+/**
+ * Get the rarely used parts of a monster, by index.
+ */
+struct monster_cold *cave_monster_cold(struct chunk *c, int idx) {
+	if (idx <= 0) return NULL;
+	return &c->monsters_cold[idx];
+}
+
 /**
  * The maximum number of monsters allowed in the level.
  */
@@ -806,7 +1110,10 @@ void make_noise(struct chunk *c, struct player *p, struct monster *mon)
 	int noise_increment = p && p->timed[TMD_COVERTRACKS] ? 4 : 1;
     struct queue *queue = q_new(c->height * c->width);
 	struct loc decoy = cave_find_decoy(c);
-	struct heatmap noise_map = p ? c->noise : mon->noise;
+	struct heatmap noise_map = p ? c->noise :
+		cave_monster_cold(c, mon->midx)->noise;
+
+	PROFILE_BEGIN(MAKE_NOISE);
 
 	/* Set all the grids to silence */
 	for (y = 1; y < c->height - 1; y++) {
@@ -866,6 +1173,7 @@ void make_noise(struct chunk *c, struct player *p, struct monster *mon)
 	}
 
 	q_free(queue);
+	PROFILE_END(MAKE_NOISE);
 }
 
 /**
@@ -892,7 +1200,8 @@ void update_scent(struct chunk *c, struct player *p, struct monster *mon)
 		{2, 1, 1, 1, 2},
 		{2, 2, 2, 2, 2},
 	};
-	struct heatmap scent_map = p ? c->scent : mon->scent;
+	struct heatmap scent_map = p ? c->scent :
+		cave_monster_cold(c, mon->midx)->scent;
 
 	/* Update scent for all grids */
 	for (y = 1; y < c->height - 1; y++) {
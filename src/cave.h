@@ -24,6 +24,7 @@
 
 struct player;
 struct monster;
+struct monster_cold;
 struct monster_group;
 
 extern const s16b ddd[9];
@@ -114,6 +115,7 @@ struct feature {
 	struct feature *next;
 
 	char *mimic;	/**< Name of feature to mimic */
+	int mimic_idx;	/**< Feature shown for this one (itself if no mimic) */
 	byte priority;	/**< Display priority */
 
 	byte shopnum;	/**< Which shop does it take you to? */
@@ -189,6 +191,99 @@ struct ghost_info {
 	bool has_spoken;
 };
 
+/**
+ * Kinds of change to the player's knowledge of a grid
+ */
+enum {
+	KNOWN_CHANGE_FEAT = 0x01,	/* Terrain learned or forgotten */
+	KNOWN_CHANGE_OBJECT = 0x02,	/* Objects seen or found to be gone */
+	KNOWN_CHANGE_TRAP = 0x04	/* Traps noticed or forgotten */
+};
+
+/**
+ * Most changes a known map's journal holds before starting again
+ */
+#define KNOWN_JOURNAL_MAX 1024
+
+/**
+ * One entry in a known map's change journal
+ */
+struct known_change {
+	struct loc grid;
+	int what;			/* KNOWN_CHANGE_* flags */
+};
+
+/**
+ * Append-only journal of changes to the player's knowledge of a level.
+ *
+ * Every change gets the next serial number; the changes numbered from first
+ * up to next - 1 are held in changes[].  Older ones are thrown away when the
+ * journal fills, so a reader that last looked before first has to assume
+ * everything changed.
+ */
+struct known_journal {
+	struct known_change *changes;
+	int count;
+	u32b first;
+	u32b next;
+};
+
+/**
+ * What the player's map shows for a grid, leaving out monsters, lighting and
+ * hallucination, which change too often to be worth keeping.  Kept for every
+ * grid of the player's map so that redrawing the map doesn't walk object piles
+ * or resolve mimics again.  A cell is only good while its stamp matches the
+ * current render stamp.
+ */
+struct render_cell {
+	u32b stamp;
+	u16b feat;		/* Feature shown, after mimics */
+	u16b kidx;		/* One more than the index of the first kind shown */
+	byte flags;		/* RENDER_* flags */
+};
+
+/**
+ * Classes of terrain kept as bit planes, so that everything of one class in
+ * an area can be found without looking at every grid; see cave_plane_find()
+ */
+enum {
+	PLANE_DOOR,			/* Any door, secret or not */
+	PLANE_SECRET_DOOR,
+	PLANE_STAIR,
+	PLANE_GOLD,			/* Veins with treasure */
+	PLANE_MAX
+};
+
+/**
+ * A chunk's terrain class planes; one bit per grid, a row of bits at a time.
+ * They are made when first wanted, kept up to date by square_set_feat() and
+ * the setting of known terrain, and only trusted while the chunk's terrain
+ * stamp matches the one they were last brought up to.
+ */
+struct feat_planes {
+	bitflag *bits;
+	int row_size;
+	u32b terrain_stamp;
+};
+
+/**
+ * A batch of terrain changes to an area of a chunk.  Changes inside the area
+ * are made at once, but the bookkeeping for them - feature counts, the
+ * terrain stamp, class planes and map redraws - waits for cave_batch_end(),
+ * which works out what changed from the copy of the area taken at the start.
+ */
+struct terrain_batch {
+	struct loc tl;		/* Top left corner of the area */
+	struct loc br;		/* Grid diagonally beyond the bottom right corner */
+	u16b *feats;		/* Terrain of the area when the batch began */
+};
+
+enum {
+	RENDER_MULTIPLE = 0x01,		/* More than one object worth showing */
+	RENDER_UNSEEN_OBJECT = 0x02,	/* An object not yet seen close up */
+	RENDER_UNSEEN_MONEY = 0x04	/* Money not yet seen close up */
+};
+
 struct chunk {
 	char *name;
 	s32b turn;
@@ -205,6 +300,8 @@ struct chunk {
 
 	u16b feeling_squares; /* How many feeling squares the player has visited */
 	int *feat_count;
+	u32b terrain_stamp; /* Changes whenever any terrain in the chunk does */
+	u32b view_stamp; /* Changes whenever the player's view is recalculated */
 
 	struct square **squares;
 	struct heatmap noise;
@@ -215,6 +312,7 @@ struct chunk {
 	u16b obj_max;
 
 	struct monster *monsters;
+	struct monster_cold *monsters_cold;
 	u16b mon_max;
 	u16b mon_cnt;
 	int mon_current;
@@ -224,6 +322,11 @@ struct chunk {
 	struct monster_group **monster_groups;
 
 	struct connector *join;
+
+	struct known_journal journal;	/* Only used for the player's map */
+	struct render_cell *render;		/* Only used for the player's map */
+	struct feat_planes *planes;
+	struct terrain_batch *batch;	/* Only while a batch is open */
 };
 
 /*** Feature Indexes (see "lib/gamedata/terrain.txt") ***/
@@ -293,6 +396,9 @@ bool no_light(struct player *p);
 void map_info(struct loc grid, struct grid_data *g);
 void square_note_spot(struct chunk *c, struct loc grid);
 void square_light_spot(struct chunk *c, struct loc grid);
+void map_render_forget(struct chunk *c, struct loc grid);
+void map_render_forget_all(void);
+u32b map_render_generation(void);
 void light_room(struct loc grid, bool light);
 void wiz_light(struct chunk *c, struct player *p, bool full);
 void wiz_dark(struct chunk *c, struct player *p, bool full);
@@ -512,6 +618,18 @@ void set_terrain(void);
 u16b **heatmap_new(struct chunk *c);
 void heatmap_free(struct chunk *c, struct heatmap map);
 struct chunk *cave_new(int height, int width);
+void cave_terrain_changed(struct chunk *c);
+void cave_journal_note(struct chunk *c, struct loc grid, int what);
+void cave_journal_all(struct chunk *c);
+bool cave_journal_read(const struct chunk *c, u32b *cursor,
+	const struct known_change **changes, int *n);
+bool cave_planes_current(const struct chunk *c);
+void cave_planes_note(struct chunk *c, struct loc grid, bool current);
+struct point_set *cave_plane_find(struct chunk *c, int plane, struct loc tl,
+	struct loc br);
+void cave_batch_begin(struct chunk *c, struct loc tl, struct loc br);
+bool cave_batch_holds(const struct chunk *c, struct loc grid);
+void cave_batch_end(struct chunk *c);
 void cave_connectors_free(struct connector *join);
 void cave_free(struct chunk *c);
 void list_object(struct chunk *c, struct object *obj);
@@ -523,6 +641,7 @@ int scatter_ext(struct chunk *c, struct loc *places, int n, struct loc grid,
 		int d, bool need_los, bool (*pred)(struct chunk *, struct loc));
 
 struct monster *cave_monster(struct chunk *c, int idx);
+struct monster_cold *cave_monster_cold(struct chunk *c, int idx);
 int cave_monster_max(struct chunk *c);
 int cave_monster_count(struct chunk *c);
 
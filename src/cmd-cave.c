@@ -695,7 +695,9 @@ static bool do_cmd_tunnel_aux(struct loc grid)
 	/* Verify legality */
 	if (!do_cmd_tunnel_test(grid)) return (false);
 
-	/* Find what we're digging with and our chance of success */
+	/* Find what we're digging with and our chance of success; only the
+	 * weapon slot changes between the calc_bonuses() calls */
+	calc_bonuses_hold();
 	best_digger = player_best_digger(player, false);
 	if (best_digger != current_weapon &&
 			(!current_weapon || obj_can_takeoff(current_weapon))) {
@@ -723,6 +725,7 @@ static bool do_cmd_tunnel_aux(struct loc grid)
 		player->body.slots[weapon_slot].obj = current_weapon;
 		calc_bonuses(player, &local_state, false, true);
 	}
+	calc_bonuses_release();
 
 	/* Success */
 	if (okay && twall(grid)) {
@@ -1612,6 +1615,50 @@ void do_cmd_pathfind(struct command *cmd)
 	}
 }
 
+/**
+ * Start travelling to a location anywhere on the level.
+ *
+ * Note that travelling while confused is not allowed.
+ */
+void do_cmd_travel(struct command *cmd)
+{
+	struct loc grid;
+
+	if (cmd_get_arg_point(cmd, "point", &grid) != CMD_OK)
+		return;
+
+	if (player->timed[TMD_CONFUSED])
+		return;
+
+	if (path_travel(grid)) {
+		player->upkeep->running = 9999;
+		/* Calculate torch radius */
+		player->upkeep->update |= (PU_TORCH);
+		player->upkeep->running_withpathfind = true;
+		run_step(0);
+	}
+}
+
+/**
+ * Travel towards the nearest unexplored part of the level, carrying on
+ * until there is nothing more to see or something interrupts.
+ *
+ * Note that exploring while confused is not allowed.
+ */
+void do_cmd_explore(struct command *cmd)
+{
+	if (player->timed[TMD_CONFUSED])
+		return;
+
+	if (path_explore()) {
+		player->upkeep->running = 9999;
+		/* Calculate torch radius */
+		player->upkeep->update |= (PU_TORCH);
+		player->upkeep->running_withpathfind = true;
+		run_step(0);
+	}
+}
+
 
 
 /**
@@ -85,6 +85,8 @@ static const struct command_info game_cmds[] =
 	{ CMD_REST, "rest", do_cmd_rest, false, 0 },
 	{ CMD_SLEEP, "sleep", do_cmd_sleep, false, 0 },
 	{ CMD_PATHFIND, "walk", do_cmd_pathfind, false, 0 },
+	{ CMD_TRAVEL, "travel", do_cmd_travel, false, 0 },
+	{ CMD_EXPLORE, "explore", do_cmd_explore, false, 0 },
 	{ CMD_PICKUP, "pickup", do_cmd_pickup, false, 0 },
 	{ CMD_AUTOPICKUP, "autopickup", do_cmd_autopickup, false, 0 },
 	{ CMD_WIELD, "wear or wield", do_cmd_wield, false, 0 },
@@ -126,6 +128,7 @@ static const struct command_info game_cmds[] =
 	{ CMD_WIZ_ACQUIRE, "acquire objects", do_cmd_wiz_acquire, false, 0 },
 	{ CMD_WIZ_ADVANCE, "make character powerful", do_cmd_wiz_advance, false, 0 },
 	{ CMD_WIZ_BANISH, "banish nearby monsters", do_cmd_wiz_banish, false, 0 },
+	{ CMD_WIZ_BENCHMARK_STORES, "benchmark store maintenance", do_cmd_wiz_benchmark_stores, false, 0 },
 	{ CMD_WIZ_CHANGE_ITEM_QUANTITY, "change number of an item", do_cmd_wiz_change_item_quantity, false, 0 },
 	{ CMD_WIZ_COLLECT_DISCONNECT_STATS, "collect statistics about disconnected levels", do_cmd_wiz_collect_disconnect_stats, false, 0 },
 	{ CMD_WIZ_COLLECT_OBJ_MON_STATS, "collect object/monster statistics", do_cmd_wiz_collect_obj_mon_stats, false, 0 },
@@ -147,14 +150,17 @@ static const struct command_info game_cmds[] =
 	{ CMD_WIZ_EDIT_PLAYER_GOLD, "change the player's gold", do_cmd_wiz_edit_player_gold, false, 0 },
 	{ CMD_WIZ_EDIT_PLAYER_START, "start editing the player", do_cmd_wiz_edit_player_start, false, 0 },
 	{ CMD_WIZ_EDIT_PLAYER_STAT, "edit one of the player's stats", do_cmd_wiz_edit_player_stat, false, 0 },
+	{ CMD_WIZ_EVENT_STATS, "report game event counts", do_cmd_wiz_event_stats, false, 0 },
 	{ CMD_WIZ_HIT_ALL_LOS, "hit all monsters in LOS", do_cmd_wiz_hit_all_los, false, 0 },
 	{ CMD_WIZ_INCREASE_EXP, "increase experience", do_cmd_wiz_increase_exp, false, 0 },
 	{ CMD_WIZ_JUMP_LEVEL, "jump to a level", do_cmd_wiz_jump_level, false, 0 },
 	{ CMD_WIZ_LEARN_OBJECT_KINDS, "learn about kinds of objects", do_cmd_wiz_learn_object_kinds, false, 0 },
 	{ CMD_WIZ_MAGIC_MAP, "map local area", do_cmd_wiz_magic_map, false, 0 },
+	{ CMD_WIZ_OBJECT_MEMORY, "report object memory", do_cmd_wiz_object_memory, false, 0 },
 	{ CMD_WIZ_PEEK_NOISE_SCENT, "peek at noise and scent", do_cmd_wiz_peek_noise_scent, false, 0 },
 	{ CMD_WIZ_PERFORM_EFFECT, "perform an effect", do_cmd_wiz_perform_effect, false, 0 },
 	{ CMD_WIZ_PLAY_ITEM, "play with item", do_cmd_wiz_play_item, false, 0 },
+	{ CMD_WIZ_PROFILE, "time the busiest game functions", do_cmd_wiz_profile, false, 0 },
 	{ CMD_WIZ_PUSH_OBJECT, "push objects from square", do_cmd_wiz_push_object, false, 0 },
 	{ CMD_WIZ_QUERY_FEATURE, "highlight specific feature", do_cmd_wiz_query_feature, false, 0 },
 	{ CMD_WIZ_QUERY_SQUARE_FLAG, "query square flag", do_cmd_wiz_query_square_flag, false, 0 },
@@ -63,6 +63,8 @@ typedef enum cmd_code {
 	CMD_WALK,
 	CMD_JUMP,
 	CMD_PATHFIND,
+	CMD_TRAVEL,
+	CMD_EXPLORE,
 
 	CMD_INSCRIBE,
 	CMD_UNINSCRIBE,
@@ -116,6 +118,7 @@ typedef enum cmd_code {
 	CMD_WIZ_ACQUIRE,
 	CMD_WIZ_ADVANCE,
 	CMD_WIZ_BANISH,
+	CMD_WIZ_BENCHMARK_STORES,
 	CMD_WIZ_CHANGE_ITEM_QUANTITY,
 	CMD_WIZ_COLLECT_DISCONNECT_STATS,
 	CMD_WIZ_COLLECT_OBJ_MON_STATS,
@@ -137,14 +140,17 @@ typedef enum cmd_code {
 	CMD_WIZ_EDIT_PLAYER_GOLD,
 	CMD_WIZ_EDIT_PLAYER_START,
 	CMD_WIZ_EDIT_PLAYER_STAT,
+	CMD_WIZ_EVENT_STATS,
 	CMD_WIZ_HIT_ALL_LOS,
 	CMD_WIZ_INCREASE_EXP,
 	CMD_WIZ_JUMP_LEVEL,
 	CMD_WIZ_LEARN_OBJECT_KINDS,
 	CMD_WIZ_MAGIC_MAP,
+	CMD_WIZ_OBJECT_MEMORY,
 	CMD_WIZ_PEEK_NOISE_SCENT,
 	CMD_WIZ_PERFORM_EFFECT,
 	CMD_WIZ_PLAY_ITEM,
+	CMD_WIZ_PROFILE,
 	CMD_WIZ_PUSH_OBJECT,
 	CMD_WIZ_QUERY_FEATURE,
 	CMD_WIZ_QUERY_SQUARE_FLAG,
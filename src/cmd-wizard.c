@@ -39,6 +39,7 @@
 #include "player-timed.h"
 #include "player-util.h"
 #include "project.h"
+#include "store.h"
 #include "target.h"
 #include "trap.h"
 #include "ui-input.h"
@@ -46,6 +47,7 @@
 #include "ui-output.h"
 #include "ui-target.h"
 #include "wizard.h"
+#include "z-profile.h"
 
 
 /*
@@ -475,6 +477,46 @@ void do_cmd_wiz_banish(struct command *cmd)
 }
 
 
+/**
+ * Time the store maintenance for a number of days, first replaying every day
+ * and then catching up directly (CMD_WIZ_BENCHMARK_STORES).  Both start from
+ * the same stores, and the stores are put back as they were afterwards.  Can
+ * take the number of days from the argument, "quantity", of type number in cmd.
+ */
+void do_cmd_wiz_benchmark_stores(struct command *cmd)
+{
+	int days;
+	clock_t start, replay, catch_up;
+	struct store_snapshot *snap;
+
+	if (cmd_get_arg_number(cmd, "quantity", &days) != CMD_OK) {
+		char s[80];
+
+		/* Set default. */
+		strnfmt(s, sizeof(s), "%d", 100);
+
+		if (!get_string("Number of days: ", s, sizeof(s))) return;
+		if (!get_int_from_string(s, &days) || days < 1) return;
+		cmd_set_arg_number(cmd, "quantity", days);
+	}
+
+	snap = store_snapshot_new();
+	start = clock();
+	store_update_days(days, true);
+	replay = clock() - start;
+	store_snapshot_restore(snap);
+	start = clock();
+	store_update_days(days, false);
+	catch_up = clock() - start;
+	store_snapshot_restore(snap);
+	store_snapshot_free(snap);
+
+	msg("%d days of store maintenance: replayed in %ld ms, caught up in %ld ms.",
+		days, (long) (replay * 1000 / CLOCKS_PER_SEC),
+		(long) (catch_up * 1000 / CLOCKS_PER_SEC));
+}
+
+
 /**
  * Change the quantity of an item (CMD_WIZ_CHANGE_ITEM_QUANTITY).  Can take
  * the item to modify from the argument, "item", of type item in cmd.  Can
@@ -1352,6 +1394,54 @@ void do_cmd_wiz_edit_player_stat(struct command *cmd)
 }
 
 
+/**
+ * Start counting and timing game events, or report the busiest ones since
+ * counting started and stop timing (CMD_WIZ_EVENT_STATS).  Takes no arguments
+ * from cmd.
+ */
+void do_cmd_wiz_event_stats(struct command *cmd)
+{
+	game_event_type busiest[N_GAME_EVENTS];
+	int i, j, n = 0;
+
+	if (!event_stats_timing()) {
+		event_stats_reset(true);
+		msg("Timing game events; use this again to see the results.");
+		return;
+	}
+
+	/* Sort the events that were signalled by the time their handlers took */
+	for (i = 0; i < N_GAME_EVENTS; i++) {
+		const struct game_event_stats *stats = event_stats(i);
+
+		if (!stats->signals) continue;
+		for (j = n; j > 0; j--) {
+			const struct game_event_stats *prev = event_stats(busiest[j - 1]);
+
+			if (prev->time > stats->time ||
+					(prev->time == stats->time &&
+					prev->deliveries >= stats->deliveries)) {
+				break;
+			}
+			busiest[j] = busiest[j - 1];
+		}
+		busiest[j] = i;
+		n++;
+	}
+
+	for (i = 0; i < MIN(n, 10); i++) {
+		const struct game_event_stats *stats = event_stats(busiest[i]);
+
+		msg("%s: %ld signals, %ld merged, %ld handler calls, %ld us.",
+			event_name(busiest[i]), stats->signals, stats->coalesced,
+			stats->deliveries,
+			(long) (stats->time * 1000000.0 / CLOCKS_PER_SEC));
+	}
+	if (!n) msg("No game events.");
+	event_stats_reset(false);
+}
+
+
 /**
  * Hit all monsters in the player's line of sight (CMD_WIZ_HIT_ALL_LOS).  Takes
  * no arguments from cmd.
@@ -1490,6 +1580,32 @@ void do_cmd_wiz_magic_map(struct command *cmd)
 }
 
 
+/**
+ * Report the memory used by the objects on the current level and in the
+ * player's memory of it, and how well the object pools are being reused
+ * (CMD_WIZ_OBJECT_MEMORY).  Takes no arguments from cmd.
+ */
+void do_cmd_wiz_object_memory(struct command *cmd)
+{
+	static const char *pool_names[OBJ_POOL_MAX] = {
+		"objects", "slays", "brands", "curses"
+	};
+	int i, count, known_count;
+	size_t bytes = chunk_object_memory(cave, &count);
+	size_t known_bytes = chunk_object_memory(player->cave, &known_count);
+
+	msg("Level: %d objects in %ld bytes; known: %d objects in %ld bytes.",
+		count, (long) bytes, known_count, (long) known_bytes);
+	for (i = 0; i < OBJ_POOL_MAX; i++) {
+		struct object_pool_stats stats;
+
+		object_pool_stats(i, &stats);
+		msg("Pool %s: %ld allocated, %ld reused, %d waiting.", pool_names[i],
+			stats.fresh, stats.reused, stats.cached);
+	}
+}
+
+
 /**
  * Is a helper function passed by do_cmd_wiz_peek_noise_scent() to
  * wiz_hack_map() in order to peek at the noise.
@@ -1925,6 +2041,48 @@ void do_cmd_wiz_play_item(struct command *cmd)
 }
 
 
+/**
+ * Start timing the busiest game functions, or report on them since timing
+ * started and stop (CMD_WIZ_PROFILE).  The report also goes to profile.txt,
+ * with histograms of the time taken each game turn, and the latest timings
+ * to profile.json as a Chrome trace.  Takes no arguments from cmd.
+ */
+void do_cmd_wiz_profile(struct command *cmd)
+{
+	char path[1024];
+	int i;
+
+	if (!profile_is_enabled()) {
+		msg("Profiling not turned on in this build.");
+		return;
+	}
+	if (!profile_running()) {
+		profile_start();
+		msg("Timing game functions; use this again to see the results.");
+		return;
+	}
+	profile_stop();
+
+	for (i = 0; i < PZ_MAX; i++) {
+		const struct profile_zone_stats *stats = profile_stats(i);
+
+		if (!stats->calls) continue;
+		msg("%s: %ld calls on %ld turns, %ld us, worst turn %ld us.",
+			profile_zone_name(i), stats->calls, stats->turns,
+			(long) (stats->total / 1000), (long) (stats->worst_turn / 1000));
+	}
+
+	path_build(path, sizeof(path), ANGBAND_DIR_USER, "profile.txt");
+	if (profile_write_report(path)) {
+		msg("Histograms are in profile.txt.");
+	}
+	path_build(path, sizeof(path), ANGBAND_DIR_USER, "profile.json");
+	if (profile_write_trace(path)) {
+		msg("Trace is in profile.json.");
+	}
+}
+
+
 /**
  * Push objects from a selected grid (CMD_WIZ_PUSH_OBJECT).  Can take the
  * location from the argument, "point", of type point in cmd.
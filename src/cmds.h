@@ -38,6 +38,8 @@ void do_cmd_walk(struct command *cmd);
 void do_cmd_jump(struct command *cmd);
 void do_cmd_run(struct command *cmd);
 void do_cmd_pathfind(struct command *cmd);
+void do_cmd_travel(struct command *cmd);
+void do_cmd_explore(struct command *cmd);
 void do_cmd_hold(struct command *cmd);
 void do_cmd_rest(struct command *cmd);
 void do_cmd_sleep(struct command *cmd);
@@ -88,6 +90,7 @@ void do_cmd_spoil_obj(struct command *cmd);
 void do_cmd_wiz_acquire(struct command *cmd);
 void do_cmd_wiz_advance(struct command *cmd);
 void do_cmd_wiz_banish(struct command *cmd);
+void do_cmd_wiz_benchmark_stores(struct command *cmd);
 void do_cmd_wiz_change_item_quantity(struct command *cmd);
 void do_cmd_wiz_collect_disconnect_stats(struct command *cmd);
 void do_cmd_wiz_collect_obj_mon_stats(struct command *cmd);
@@ -109,14 +112,17 @@ void do_cmd_wiz_edit_player_exp(struct command *cmd);
 void do_cmd_wiz_edit_player_gold(struct command *cmd);
 void do_cmd_wiz_edit_player_start(struct command *cmd);
 void do_cmd_wiz_edit_player_stat(struct command *cmd);
+void do_cmd_wiz_event_stats(struct command *cmd);
 void do_cmd_wiz_hit_all_los(struct command *cmd);
 void do_cmd_wiz_increase_exp(struct command *cmd);
 void do_cmd_wiz_jump_level(struct command *cmd);
 void do_cmd_wiz_learn_object_kinds(struct command *cmd);
 void do_cmd_wiz_magic_map(struct command *cmd);
+void do_cmd_wiz_object_memory(struct command *cmd);
 void do_cmd_wiz_peek_noise_scent(struct command *cmd);
 void do_cmd_wiz_perform_effect(struct command *cmd);
 void do_cmd_wiz_play_item(struct command *cmd);
+void do_cmd_wiz_profile(struct command *cmd);
 void do_cmd_wiz_push_object(struct command *cmd);
 void do_cmd_wiz_query_feature(struct command *cmd);
 void do_cmd_wiz_query_square_flag(struct command *cmd);
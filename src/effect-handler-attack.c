@@ -1521,7 +1521,8 @@ bool effect_handler_DESTRUCTION(effect_handler_context_t *context)
 		return true;
 	}
 
-	/* Big area of affect */
+	/* Big area of affect, changed all at once */
+	cave_batch_begin(cave, loc(px - r, py - r), loc(px + r + 1, py + r + 1));
 	for (grid.y = (py - r); grid.y <= (py + r); grid.y++) {
 		for (grid.x = (px - r); grid.x <= (px + r); grid.x++) {
 			/* Skip illegal grids */
@@ -1579,6 +1580,7 @@ bool effect_handler_DESTRUCTION(effect_handler_context_t *context)
 			}
 		}
 	}
+	cave_batch_end(cave);
 
 	/* Player is affected */
 	if (elem == ELEM_LIGHT) {
@@ -1659,6 +1661,10 @@ bool effect_handler_EARTHQUAKE(effect_handler_context_t *context)
 	/* Paranoia -- Enforce maximum range */
 	if (r > 15) r = 15;
 
+	/* The whole blast area is changed at once */
+	cave_batch_begin(cave, loc(centre.x - r, centre.y - r),
+		loc(centre.x + r + 1, centre.y + r + 1));
+
 	/* Initialize a map of the maximal blast area */
 	for (y = 0; y < 32; y++)
 		for (x = 0; x < 32; x++)
@@ -1893,6 +1899,7 @@ bool effect_handler_EARTHQUAKE(effect_handler_context_t *context)
 			}
 		}
 	}
+	cave_batch_end(cave);
 
 	/* Fully update the visuals */
 	player->upkeep->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
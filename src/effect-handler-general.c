@@ -1268,8 +1268,8 @@ bool effect_handler_MAP_AREA(effect_handler_context_t *context)
 	/* Fully update the visuals */
 	player->upkeep->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
 
-	/* Redraw whole map, monster list */
-	player->upkeep->redraw |= (PR_MAP | PR_MONLIST | PR_ITEMLIST);
+	/* Redraw monster list; the mapped grids are in the known map journal */
+	player->upkeep->redraw |= (PR_MONLIST | PR_ITEMLIST);
 
 	/* Notice */
 	context->ident = true;
@@ -1407,8 +1407,9 @@ bool effect_handler_DETECT_TRAPS(effect_handler_context_t *context)
  */
 bool effect_handler_DETECT_DOORS(effect_handler_context_t *context)
 {
-	int x, y;
+	int i;
 	int x1, x2, y1, y2;
+	struct point_set *found;
 
 	bool doors = false;
 
@@ -1423,33 +1424,36 @@ bool effect_handler_DETECT_DOORS(effect_handler_context_t *context)
 	if (y2 > cave->height - 1) y2 = cave->height - 1;
 	if (x2 > cave->width - 1) x2 = cave->width - 1;
 
-	/* Scan the dungeon */
-	for (y = y1; y < y2; y++) {
-		for (x = x1; x < x2; x++) {
-			struct loc grid = loc(x, y);
+	/* Detect secret doors; the map redraw comes from the known map journal */
+	found = cave_plane_find(cave, PLANE_SECRET_DOOR, loc(x1, y1), loc(x2, y2));
+	for (i = 0; i < found->n; i++) {
+		struct loc grid = found->pts[i];
 
-			if (!square_in_bounds_fully(cave, grid)) continue;
+		if (!square_in_bounds_fully(cave, grid)) continue;
 
-			/* Detect secret doors */
-			if (square_issecretdoor(cave, grid)) {
-				/* Put an actual door */
-				place_closed_door(cave, grid);
+		/* Put an actual door */
+		place_closed_door(cave, grid);
 
-				/* Memorize */
-				square_memorize(cave, grid);
-				square_light_spot(cave, grid);
+		/* Memorize */
+		square_memorize(cave, grid);
 
-				/* Obvious */
-				doors = true;
-			}
+		/* Obvious */
+		doors = true;
+	}
+	point_set_dispose(found);
 
-			/* Forget unknown doors in the mapping area */
-			if (square_isdoor(player->cave, grid) &&
-				square_isnotknown(cave, grid)) {
-				square_forget(cave, grid);
-			}
+	/* Forget unknown doors in the mapping area */
+	found = cave_plane_find(player->cave, PLANE_DOOR, loc(x1, y1),
+		loc(x2, y2));
+	for (i = 0; i < found->n; i++) {
+		struct loc grid = found->pts[i];
+
+		if (!square_in_bounds_fully(cave, grid)) continue;
+		if (square_isnotknown(cave, grid)) {
+			square_forget(cave, grid);
 		}
 	}
+	point_set_dispose(found);
 
 	/* Describe */
 	if (doors)
@@ -1468,8 +1472,9 @@ bool effect_handler_DETECT_DOORS(effect_handler_context_t *context)
  */
 bool effect_handler_DETECT_STAIRS(effect_handler_context_t *context)
 {
-	int x, y;
+	int i;
 	int x1, x2, y1, y2;
+	struct point_set *found;
 
 	bool stairs = false;
 
@@ -1484,24 +1489,20 @@ bool effect_handler_DETECT_STAIRS(effect_handler_context_t *context)
 	if (y2 > cave->height - 1) y2 = cave->height - 1;
 	if (x2 > cave->width - 1) x2 = cave->width - 1;
 
-	/* Scan the dungeon */
-	for (y = y1; y < y2; y++) {
-		for (x = x1; x < x2; x++) {
-			struct loc grid = loc(x, y);
+	/* Detect stairs; the map redraw comes from the known map journal */
+	found = cave_plane_find(cave, PLANE_STAIR, loc(x1, y1), loc(x2, y2));
+	for (i = 0; i < found->n; i++) {
+		struct loc grid = found->pts[i];
 
-			if (!square_in_bounds_fully(cave, grid)) continue;
+		if (!square_in_bounds_fully(cave, grid)) continue;
 
-			/* Detect stairs */
-			if (square_isstairs(cave, grid)) {
-				/* Memorize */
-				square_memorize(cave, grid);
-				square_light_spot(cave, grid);
+		/* Memorize */
+		square_memorize(cave, grid);
 
-				/* Obvious */
-				stairs = true;
-			}
-		}
+		/* Obvious */
+		stairs = true;
 	}
+	point_set_dispose(found);
 
 	/* Describe */
 	if (stairs)
@@ -1520,8 +1521,9 @@ bool effect_handler_DETECT_STAIRS(effect_handler_context_t *context)
  */
 bool effect_handler_DETECT_GOLD(effect_handler_context_t *context)
 {
-	int x, y;
+	int i;
 	int x1, x2, y1, y2;
+	struct point_set *found;
 
 	bool gold_buried = false;
 
@@ -1536,28 +1538,35 @@ bool effect_handler_DETECT_GOLD(effect_handler_context_t *context)
 	if (y2 > cave->height - 1) y2 = cave->height - 1;
 	if (x2 > cave->width - 1) x2 = cave->width - 1;
 
-	/* Scan the dungeon */
-	for (y = y1; y < y2; y++) {
-		for (x = x1; x < x2; x++) {
-			struct loc grid = loc(x, y);
+	/* Magma/Quartz + Known Gold; the map redraw comes from the journal */
+	found = cave_plane_find(cave, PLANE_GOLD, loc(x1, y1), loc(x2, y2));
+	for (i = 0; i < found->n; i++) {
+		struct loc grid = found->pts[i];
 
-			if (!square_in_bounds_fully(cave, grid)) continue;
+		if (!square_in_bounds_fully(cave, grid)) continue;
 
-			/* Magma/Quartz + Known Gold */
-			if (square_hasgoldvein(cave, grid)) {
-				/* Memorize */
-				square_memorize(cave, grid);
-				square_light_spot(cave, grid);
-
-				/* Detect */
-				gold_buried = true;
-			} else if (square_hasgoldvein(player->cave, grid)) {
-				/* Something removed previously seen or
-				 * detected buried gold.  Notice the change. */
-				square_forget(cave, grid);
-			}
+		/* Memorize */
+		square_memorize(cave, grid);
+
+		/* Detect */
+		gold_buried = true;
+	}
+	point_set_dispose(found);
+
+	/* Something removed previously seen or detected buried gold */
+	found = cave_plane_find(player->cave, PLANE_GOLD, loc(x1, y1),
+		loc(x2, y2));
+	for (i = 0; i < found->n; i++) {
+		struct loc grid = found->pts[i];
+
+		if (!square_in_bounds_fully(cave, grid)) continue;
+
+		/* Notice the change */
+		if (!square_hasgoldvein(cave, grid)) {
+			square_forget(cave, grid);
 		}
 	}
+	point_set_dispose(found);
 
 	/* Message unless we're silently detecting */
 	if (context->origin.what != SRC_NONE) {
@@ -1711,6 +1720,35 @@ bool effect_handler_DETECT_OBJECTS(effect_handler_context_t *context)
 	return true;
 }
 
+/**
+ * Detect one monster if it satisfies the given predicate
+ */
+static bool detect_monster(struct monster *mon, monster_predicate pred)
+{
+	/* Detect all appropriate, obvious monsters */
+	if (!pred(mon) || monster_is_camouflaged(mon)) return false;
+
+	/* Detect the monster */
+	mflag_on(mon->mflag, MFLAG_MARK);
+	mflag_on(mon->mflag, MFLAG_SHOW);
+
+	/* Note invisible monsters */
+	if (monster_is_invisible(mon)) {
+		struct monster_lore *lore = get_lore(mon->race);
+		rf_on(lore->flags, RF_INVISIBLE);
+	}
+
+	/* Update monster recall window */
+	if (player->upkeep->monster_race == mon->race)
+		/* Redraw stuff */
+		player->upkeep->redraw |= (PR_MONSTER);
+
+	/* Update the monster */
+	update_mon(player, mon, cave, false);
+
+	return true;
+}
+
 /**
  * Detect monsters which satisfy the given predicate around the player.
  * The height to detect above and below the player is y_dist,
@@ -1734,6 +1772,18 @@ static bool detect_monsters(int y_dist, int x_dist, monster_predicate pred)
 	if (y2 > cave->height - 1) y2 = cave->height - 1;
 	if (x2 > cave->width - 1) x2 = cave->width - 1;
 
+	/* Small areas are quicker to search through the grids' monsters */
+	if ((y2 - y1 + 1) * (x2 - x1 + 1) < cave_monster_max(cave)) {
+		for (y = y1; y <= y2; y++) {
+			for (x = x1; x <= x2; x++) {
+				struct monster *mon = square_monster(cave, loc(x, y));
+
+				if (mon && detect_monster(mon, pred)) monsters = true;
+			}
+		}
+		return monsters;
+	}
+
 	/* Scan monsters */
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		struct monster *mon = cave_monster(cave, i);
@@ -1748,29 +1798,8 @@ static bool detect_monsters(int y_dist, int x_dist, monster_predicate pred)
 		/* Only detect nearby monsters */
 		if (x < x1 || y < y1 || x > x2 || y > y2) continue;
 
-		/* Detect all appropriate, obvious monsters */
-		if (pred(mon) && !monster_is_camouflaged(mon)) {
-			/* Detect the monster */
-			mflag_on(mon->mflag, MFLAG_MARK);
-			mflag_on(mon->mflag, MFLAG_SHOW);
-
-			/* Note invisible monsters */
-			if (monster_is_invisible(mon)) {
-				struct monster_lore *lore = get_lore(mon->race);
-				rf_on(lore->flags, RF_INVISIBLE);
-			}
-
-			/* Update monster recall window */
-			if (player->upkeep->monster_race == mon->race)
-				/* Redraw stuff */
-				player->upkeep->redraw |= (PR_MONSTER);
-
-			/* Update the monster */
-			update_mon(player, mon, cave, false);
-
-			/* Detect */
-			monsters = true;
-		}
+		/* Detect */
+		if (detect_monster(mon, pred)) monsters = true;
 	}
 
 	return monsters;
@@ -23,99 +23,142 @@
 
 struct event_handler_entry
 {
-	struct event_handler_entry *next;	
 	game_event_handler *fn;
 	void *user;
 };
 
-static struct event_handler_entry *event_handlers[N_GAME_EVENTS];
+/**
+ * The handlers for one type of event, in the order they were added.  They are
+ * called newest first.
+ */
+struct event_handler_list
+{
+	struct event_handler_entry *entries;
+	int count;
+	int alloc;
+};
 
-static void game_event_dispatch(game_event_type type, game_event_data *data)
+static struct event_handler_list event_handlers[N_GAME_EVENTS];
+
+/**
+ * Events that carry no data and only tell a subwindow to redraw itself.
+ * Signals of these are held back and delivered once, just before the next
+ * EVENT_REFRESH or when the game waits for a key, so that a turn which
+ * changes the lists many times only redraws them once.
+ */
+static const game_event_type event_coalesced[] = {
+	EVENT_ITEMLIST,
+	EVENT_MONSTERLIST
+};
+
+static bool event_pending[N_GAME_EVENTS];
+static struct game_event_stats event_counts[N_GAME_EVENTS];
+static bool event_timing;
+
+static const char *event_names[] = {
+	#define EVENT(x) #x,
+	#include "list-game-events.h"
+	#undef EVENT
+};
+
+static bool event_is_coalesced(game_event_type type)
 {
-	struct event_handler_entry *this = event_handlers[type];
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(event_coalesced); i++)
+		if (event_coalesced[i] == type) return true;
+
+	return false;
+}
 
-	/* 
-	 * Send the word out to all interested event handlers.
+/**
+ * Call the handlers for an event.
+ */
+static void event_deliver(game_event_type type, game_event_data *data)
+{
+	struct event_handler_list *list = &event_handlers[type];
+	clock_t start = 0;
+	int i;
+
+	if (event_timing) start = clock();
+
+	/*
+	 * Send the word out to all interested event handlers.  A handler may
+	 * remove itself, so recheck the count each time.
 	 */
-	while (this)
-	{
+	for (i = list->count - 1; i >= 0; i--) {
+		if (i >= list->count) continue;
+
 		/* Call the handler with the relevant data */
-		this->fn(type, data, this->user);
-		this = this->next;
+		list->entries[i].fn(type, data, list->entries[i].user);
+		event_counts[type].deliveries++;
 	}
+
+	if (event_timing) event_counts[type].time += clock() - start;
+}
+
+static void game_event_dispatch(game_event_type type, game_event_data *data)
+{
+	event_counts[type].signals++;
+
+	/* Anything held back is drawn before the screen is refreshed */
+	if (type == EVENT_REFRESH) event_deliver_pending();
+
+	event_deliver(type, data);
 }
 
 void event_add_handler(game_event_type type, game_event_handler *fn, void *user)
 {
-	struct event_handler_entry *new;
+	struct event_handler_list *list = &event_handlers[type];
 
 	assert(fn != NULL);
 
-	/* Make a new entry */
-	new = mem_alloc(sizeof *new);
-	new->fn = fn;
-	new->user = user;
+	/* Make room for a new entry */
+	if (list->count == list->alloc) {
+		list->alloc = list->alloc ? 2 * list->alloc : 4;
+		list->entries = mem_realloc(list->entries,
+			list->alloc * sizeof(*list->entries));
+	}
 
-	/* Add it to the head of the appropriate list */
-	new->next = event_handlers[type];
-	event_handlers[type] = new;
+	/* Add it to the end of the appropriate list */
+	list->entries[list->count].fn = fn;
+	list->entries[list->count].user = user;
+	list->count++;
 }
 
 void event_remove_handler(game_event_type type, game_event_handler *fn, void *user)
 {
-	struct event_handler_entry *prev = NULL;
-	struct event_handler_entry *this = event_handlers[type];
+	struct event_handler_list *list = &event_handlers[type];
+	int i;
 
-	/* Look for the entry in the list */
-	while (this)
-	{
+	/* Look for the entry in the list, newest first */
+	for (i = list->count - 1; i >= 0; i--) {
 		/* Check if this is the entry we want to remove */
-		if (this->fn == fn && this->user == user)
-		{
-			if (!prev)
-			{
-				event_handlers[type] = this->next;
-			}
-			else
-			{
-				prev->next = this->next;
-			}
-
-			mem_free(this);
+		if (list->entries[i].fn == fn && list->entries[i].user == user) {
+			memmove(list->entries + i, list->entries + i + 1,
+				(list->count - i - 1) * sizeof(*list->entries));
+			list->count--;
+			if (!list->count) event_pending[type] = false;
 			return;
 		}
-
-		prev = this;
-		this = this->next;
 	}
 }
 
 void event_remove_handler_type(game_event_type type)
 {
-	struct event_handler_entry *handler = event_handlers[type];
+	struct event_handler_list *list = &event_handlers[type];
 
-	while (handler) {
-		struct event_handler_entry *next = handler->next;
-		mem_free(handler);
-		handler = next;
-	}
-	event_handlers[type] = NULL;
+	mem_free(list->entries);
+	memset(list, 0, sizeof(*list));
+	event_pending[type] = false;
 }
 
 void event_remove_all_handlers(void)
 {
 	int type;
-	struct event_handler_entry *handler, *next;
-
-	for (type = 0; type < N_GAME_EVENTS; type++) {
-		handler = event_handlers[type];
-		while (handler) {
-			next = handler->next;
-			mem_free(handler);
-			handler = next;
-		}
-		event_handlers[type] = NULL;
-	}
+
+	for (type = 0; type < N_GAME_EVENTS; type++)
+		event_remove_handler_type(type);
 }
 
 void event_add_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user)
@@ -137,8 +180,71 @@ void event_remove_handler_set(game_event_type *type, size_t n_types, game_event_
 
 
 
+/**
+ * Deliver any signals that have been held back to be merged.
+ */
+void event_deliver_pending(void)
+{
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(event_coalesced); i++) {
+		game_event_type type = event_coalesced[i];
+
+		if (!event_pending[type]) continue;
+		event_pending[type] = false;
+		event_deliver(type, NULL);
+	}
+}
+
+/**
+ * Get the name of an event type, as in the EVENT_ constant without the prefix.
+ */
+const char *event_name(game_event_type type)
+{
+	assert(type >= 0 && type < N_GAME_EVENTS);
+	return event_names[type];
+}
+
+/**
+ * Get what the dispatcher has done with an event type since the counts were
+ * last reset.
+ */
+const struct game_event_stats *event_stats(game_event_type type)
+{
+	assert(type >= 0 && type < N_GAME_EVENTS);
+	return &event_counts[type];
+}
+
+/**
+ * Zero the counts for every event type, and say whether to time the handlers
+ * from now on.  Timing costs two calls to clock() for each signal, so it is
+ * off until asked for.
+ */
+void event_stats_reset(bool timing)
+{
+	memset(event_counts, 0, sizeof(event_counts));
+	event_timing = timing;
+}
+
+bool event_stats_timing(void)
+{
+	return event_timing;
+}
+
 void event_signal(game_event_type type)
 {
+	/* Hold back list redraws to merge them */
+	if (event_is_coalesced(type)) {
+		event_counts[type].signals++;
+		if (!event_handlers[type].count) return;
+		if (event_pending[type]) {
+			event_counts[type].coalesced++;
+		} else {
+			event_pending[type] = true;
+		}
+		return;
+	}
+
 	game_event_dispatch(type, NULL);
 }
 
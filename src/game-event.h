@@ -26,82 +26,9 @@
  */
 typedef enum game_event_type
 {
-	EVENT_MAP = 0,		/* Some part of the map has changed. */
-
-	EVENT_STATS,  		/* One or more of the stats. */
-	EVENT_HP,	   	/* HP or MaxHP. */
-	EVENT_MANA,		/* Mana or MaxMana. */
-	EVENT_AC,		/* Armour Class. */
-	EVENT_EXPERIENCE,	/* Experience or MaxExperience. */
-	EVENT_PLAYERLEVEL,	/* Player's level has changed */
-	EVENT_PLAYERTITLE,	/* Player's title has changed */
-	EVENT_GOLD,		/* Player's gold amount. */
-	EVENT_MONSTERHEALTH,	/* Observed monster's health level. */
-	EVENT_DUNGEONLEVEL,	/* Dungeon depth */
-	EVENT_PLAYERSPEED,	/* Player's speed */
-	EVENT_RACE_CLASS,	/* Race or Class */
-	EVENT_STUDYSTATUS,	/* "Study" availability */
-	EVENT_STATUS,		/* Status */
-	EVENT_DETECTIONSTATUS,  /* Trap detection status */
-	EVENT_FEELING,		/* Object level feeling */
-	EVENT_LIGHT,		/* Light level */
-	EVENT_STATE,		/* The two 'R's: Resting and Repeating */
-
-	EVENT_PLAYERMOVED,
-	EVENT_SEEFLOOR,         /* When the player would "see" floor objects */
-	EVENT_EXPLOSION,
-	EVENT_BOLT,
-	EVENT_MISSILE,
-	EVENT_PAUSE,
-
-	EVENT_INVENTORY,
-	EVENT_EQUIPMENT,
-	EVENT_ITEMLIST,
-	EVENT_MONSTERLIST,
-	EVENT_MONSTERTARGET,
-	EVENT_OBJECTTARGET,
-	EVENT_MESSAGE,
-	EVENT_SOUND,
-	EVENT_BELL,
-	EVENT_USE_STORE,
-	EVENT_STORECHANGED,	/* Triggered on a successful buy/retrieve or sell/drop */
-
-	EVENT_INPUT_FLUSH,
-	EVENT_MESSAGE_FLUSH,
-	EVENT_CHECK_INTERRUPT,
-	EVENT_REFRESH,
-	EVENT_NEW_LEVEL_DISPLAY,
-	EVENT_COMMAND_REPEAT,
-	EVENT_ANIMATE,
-	EVENT_CHEAT_DEATH,
-
-	EVENT_INITSTATUS,	/* New status message for initialisation */
-	EVENT_BIRTHPOINTS,	/* Change in the birth points */
-
-	/* Changing of the game state/context. */
-	EVENT_ENTER_INIT,
-	EVENT_LEAVE_INIT,
-	EVENT_ENTER_BIRTH,
-	EVENT_LEAVE_BIRTH,
-	EVENT_ENTER_GAME,
-	EVENT_LEAVE_GAME,
-	EVENT_ENTER_WORLD,
-	EVENT_LEAVE_WORLD,
-	EVENT_ENTER_STORE,
-	EVENT_LEAVE_STORE,
-	EVENT_ENTER_DEATH,
-	EVENT_LEAVE_DEATH,
-
-	/* Events for introspection into dungeon generation */
-	EVENT_GEN_LEVEL_START, /* has string in event data for profile name */
-	EVENT_GEN_LEVEL_END, /* has flag in event data indicating success */
-	EVENT_GEN_ROOM_START, /* has string in event data for room type */
-	EVENT_GEN_ROOM_CHOOSE_SIZE, /* has size in event data */
-	EVENT_GEN_ROOM_CHOOSE_SUBTYPE, /* has string in event data with name */
-	EVENT_GEN_ROOM_END, /* has flag in event data indicating success */
-	EVENT_GEN_TUNNEL_FINISHED, /* has tunnel in event data with results */
-
-	EVENT_END  /* Can be sent at the end of a series of events */
+	#define EVENT(x) EVENT_##x,
+	#include "list-game-events.h"
+	#undef EVENT
 } game_event_type;
 
 #define  N_GAME_EVENTS EVENT_END + 1
@@ -214,6 +141,17 @@ typedef union
  */
 typedef void game_event_handler(game_event_type type, game_event_data *data, void *user);
 
+/**
+ * What the dispatcher has done with one type of event since the counts were
+ * last reset with event_stats_reset().
+ */
+struct game_event_stats {
+	long signals;		/* Times the event was signalled */
+	long coalesced;		/* Signals merged into one already waiting */
+	long deliveries;	/* Calls made to handlers */
+	clock_t time;		/* Time spent in the handlers, when timing */
+};
+
 void event_add_handler(game_event_type type, game_event_handler *fn, void *user);
 void event_remove_handler(game_event_type type, game_event_handler *fn, void *user);
 void event_remove_handler_type(game_event_type type);
@@ -221,6 +159,12 @@ void event_remove_all_handlers(void);
 void event_add_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
 void event_remove_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
 
+void event_deliver_pending(void);
+const char *event_name(game_event_type type);
+const struct game_event_stats *event_stats(game_event_type type);
+void event_stats_reset(bool timing);
+bool event_stats_timing(void);
+
 void event_signal_birthpoints(const int *points, const int *inc_points,
 	int remaining);
 
@@ -37,9 +37,11 @@
 #include "source.h"
 #include "target.h"
 #include "trap.h"
+#include "z-profile.h"
 
 u16b daycount = 0;
 u32b seed_randart;		/* Hack -- consistent random artifacts */
+bool randart_streams;		/* Randarts have a stream each */
 u32b seed_flavor;		/* Hack -- consistent object colors */
 s32b turn;				/* Current game turn */
 bool character_generated;	/* The character exists */
@@ -1222,6 +1224,7 @@ void run_game_loop(void)
 
 			/* Count game turns */
 			turn++;
+			PROFILE_TURN();
 		}
 
 		/* Make a new level if requested */
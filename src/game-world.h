@@ -68,6 +68,7 @@ struct level_map {
 
 extern u16b daycount;
 extern u32b seed_randart;
+extern bool randart_streams;
 extern u32b seed_flavor;
 extern s32b turn;
 extern bool character_generated;
@@ -1662,47 +1662,153 @@ static void init_cavern(struct chunk *c, int density,
 }
 
 /**
- * Run a single pass of the cellular automata rules (4,5) on the dungeon.
+ * Number of grids packed into each word of a cavern bitboard row.
+ */
+#define CAVERN_BITS 64
+
+/**
+ * Add three bit-planes in parallel, giving the sum and carry planes.
+ */
+#define CAVERN_ADD3(a, b, c, sum, carry) \
+	do { \
+		u64b ab_ = (a) ^ (b); \
+		(sum) = ab_ ^ (c); \
+		(carry) = ((a) & (b)) | (ab_ & (c)); \
+	} while (0)
+
+/**
+ * Run passes of the cellular automata rules (4,5) on the dungeon.
  * \param c is the chunk being mutated
+ * \param times is the number of passes to run
+ *
+ * The grids are packed into bitboards, one bit per grid and one row of words
+ * per dungeon row, with a set bit marking a passable grid.  Each pass counts
+ * the passable neighbours of 64 grids at once with a bit-sliced adder, and
+ * only the grids which end up changed are written back to the chunk.
  */
-static void mutate_cavern(struct chunk *c) {
+static void mutate_cavern(struct chunk *c, int times) {
 	struct loc grid;
 	int h = c->height;
 	int w = c->width;
+	int words = (w + CAVERN_BITS - 1) / CAVERN_BITS;
+	int size = h * words;
+	int i;
 
-	int *temp = mem_zalloc(h * w * sizeof(int));
+	u64b *start = mem_zalloc(size * sizeof(u64b));
+	u64b *open = mem_zalloc(size * sizeof(u64b));
+	u64b *next = mem_zalloc(size * sizeof(u64b));
+	u64b *changeable = mem_zalloc(size * sizeof(u64b));
+
+	/* Pack the passable grids, and the grids which are allowed to change */
+	for (grid.y = 0; grid.y < h; grid.y++) {
+		for (grid.x = 0; grid.x < w; grid.x++) {
+			int n = grid.y * words + grid.x / CAVERN_BITS;
+			u64b bit = ((u64b) 1) << (grid.x % CAVERN_BITS);
+
+			if (square_ispassable(c, grid)) start[n] |= bit;
+			if (grid.y == 0 || grid.y == h - 1 || grid.x == 0 ||
+					grid.x == w - 1) continue;
+			if (square_isstairs(c, grid) || square_isperm(c, grid))
+				continue;
+			changeable[n] |= bit;
+		}
+	}
+	memcpy(open, start, size * sizeof(u64b));
+
+	for (i = 0; i < times; i++) {
+		int y;
+		u64b *swap;
+
+		memcpy(next, open, size * sizeof(u64b));
+		for (y = 1; y < h - 1; y++) {
+			const u64b *up = open + (y - 1) * words;
+			const u64b *mid = open + y * words;
+			const u64b *down = open + (y + 1) * words;
+			int k;
+
+			for (k = 0; k < words; k++) {
+				u64b nb[8];
+				u64b s1, c1, s2, c2, s3, c3, s4, c4, s5, c5;
+				u64b bit0, bit1, bit2, bit3;
+				u64b fewer, more;
+				int j;
+				const u64b *rows[3];
+
+				rows[0] = up;
+				rows[1] = mid;
+				rows[2] = down;
+
+				/* Gather the eight neighbour planes for these grids */
+				for (j = 0; j < 3; j++) {
+					u64b word = rows[j][k];
+					u64b west = (word << 1) |
+						((k > 0) ? rows[j][k - 1] >> (CAVERN_BITS - 1) : 0);
+					u64b east = (word >> 1) |
+						((k < words - 1) ?
+						rows[j][k + 1] << (CAVERN_BITS - 1) : 0);
+
+					if (j == 1) {
+						nb[3] = west;
+						nb[4] = east;
+					} else {
+						int base = (j == 0) ? 0 : 5;
+
+						nb[base] = west;
+						nb[base + 1] = word;
+						nb[base + 2] = east;
+					}
+				}
 
-	for (grid.y = 1; grid.y < h - 1; grid.y++) {
-		for (grid.x = 1; grid.x < w - 1; grid.x++) {
-			int count = 8 - count_neighbors(NULL, c, grid,
-				square_ispassable, false);
-			if (square_isstairs(c, grid) ||
-					square_isperm(c, grid)) {
-				temp[grid_to_i(grid, w)] =
-					square(c, grid)->feat;
-			} else if (count > 5) {
-				temp[grid_to_i(grid, w)] = FEAT_GRANITE;
-			} else if (count < 4) {
-				temp[grid_to_i(grid, w)] = FEAT_FLOOR;
-			} else {
-				temp[grid_to_i(grid, w)] =
-					square(c, grid)->feat;
+				/* Sum them into the bit planes of a count from 0 to 8 */
+				CAVERN_ADD3(nb[0], nb[1], nb[2], s1, c1);
+				CAVERN_ADD3(nb[3], nb[4], nb[5], s2, c2);
+				CAVERN_ADD3(s1, s2, nb[6], s3, c3);
+				s4 = s3 ^ nb[7];
+				c4 = s3 & nb[7];
+				bit0 = s4;
+				CAVERN_ADD3(c1, c2, c3, s5, c5);
+				bit1 = s5 ^ c4;
+				bit2 = c5 ^ (s5 & c4);
+				bit3 = c5 & s5 & c4;
+
+				/* More than five walls means fewer than three floors */
+				fewer = ~bit3 & ~bit2 & ~(bit1 & bit0);
+
+				/* Fewer than four walls means more than four floors */
+				more = bit3 | (bit2 & (bit1 | bit0));
+
+				next[y * words + k] = (mid[k] & ~changeable[y * words + k]) |
+					(changeable[y * words + k] &
+					((mid[k] & ~fewer) | more));
 			}
 		}
+		swap = open;
+		open = next;
+		next = swap;
 	}
 
+	/* Write back the grids which have changed */
 	for (grid.y = 1; grid.y < h - 1; grid.y++) {
 		for (grid.x = 1; grid.x < w - 1; grid.x++) {
-			if (temp[grid_to_i(grid, w)] == FEAT_GRANITE)
-				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+			int n = grid.y * words + grid.x / CAVERN_BITS;
+			u64b bit = ((u64b) 1) << (grid.x % CAVERN_BITS);
+
+			if (!((open[n] ^ start[n]) & bit)) continue;
+			if (open[n] & bit)
+				square_set_feat(c, grid, FEAT_FLOOR);
 			else
-				square_set_feat(c, grid, temp[grid_to_i(grid, w)]);
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
 		}
 	}
 
-	mem_free(temp);
+	mem_free(changeable);
+	mem_free(next);
+	mem_free(open);
+	mem_free(start);
 }
 
+#undef CAVERN_ADD3
+
 /**
  * Fill an int[] with a single value.
  * \param data is the array
@@ -1715,103 +1821,145 @@ static void array_filler(int data[], int value, int size) {
 }
 
 /**
- * Determine if we need to worry about coloring a point, or can ignore it.
- * \param c is the current chunk
+ * Find the representative of a set in a union-find forest, compressing the
+ * path to it as we go.
+ * \param parent is the forest, with parent[i] == i for each representative
+ * \param i is the member whose set we want
+ */
+static int region_find(int parent[], int i) {
+	int root = i;
+	while (parent[root] != root) root = parent[root];
+	while (parent[i] != root) {
+		int next = parent[i];
+		parent[i] = root;
+		i = next;
+	}
+	return root;
+}
+
+/**
+ * Merge two sets in a union-find forest, keeping the smaller representative.
+ * \param parent is the forest
+ * \param i is a member of the first set
+ * \param j is a member of the second set
+ */
+static void region_union(int parent[], int i, int j) {
+	int ri = region_find(parent, i);
+	int rj = region_find(parent, j);
+	if (ri < rj) {
+		parent[rj] = ri;
+	} else if (rj < ri) {
+		parent[ri] = rj;
+	}
+}
+
+/**
+ * Get the current color of a point, following any merges of its color.
  * \param colors is the array of current point colors
- * \param y are the co-ordinates
- * \param x are the co-ordinates
+ * \param parent is the union-find forest of colors
+ * \param n is the grid index of the point
  */
-static int ignore_point(struct chunk *c, int colors[], struct loc grid) {
-	int n = grid_to_i(grid, c->width);
+static int point_color(int colors[], int parent[], int n) {
+	return colors[n] ? region_find(parent, colors[n]) : 0;
+}
 
+/**
+ * Determine if we need to worry about coloring a point, or can ignore it.
+ * \param c is the current chunk
+ * \param grid is the location
+ */
+static bool ignore_point(struct chunk *c, struct loc grid) {
 	if (!square_in_bounds(c, grid)) return true;
-	if (colors[n]) return true;
 	if (square_ispassable(c, grid)) return false;
 	if (square_isdoor(c, grid)) return false;
 	return true;
 }
 
 /**
- * Color a particular point, and all adjacent points.
+ * Create a color for each "NESW contiguous" region of the dungeon.
  * \param c is the current chunk
  * \param colors is the array of current point colors
  * \param counts is the array of current color counts
+ * \param parent is the union-find forest of colors; it is reset so that
+ * every color is its own representative
  * \param stairs If not NULL, stairs is an array with the same number of
  * elements as counts.  At exit, stairs[i] will indicate whether the region
  * with color i includes a staircase.
- * \param grid is the location
- * \param color is the color we are coloring
  * \param diagonal controls whether we can progress diagonally
+ *
+ * This does a single raster scan, merging each point with the neighbours
+ * already scanned, and then numbers the regions in order of their first
+ * point so the colors match those from a flood fill in the same order.
  */
-static void build_color_point(struct chunk *c, int colors[], int counts[],
-		bool *stairs, struct loc grid, int color, bool diagonal) {
+static void build_colors(struct chunk *c, int colors[], int counts[],
+		int parent[], bool *stairs, bool diagonal)
+{
+	struct loc grid;
 	int h = c->height;
 	int w = c->width;
 	int size = h * w;
-	struct queue *queue = q_new(size);
-
-	int *added = mem_zalloc(size * sizeof(int));
-
-	array_filler(added, 0, size);
-
-	q_push_int(queue, grid_to_i(grid, w));
-
-	counts[color] = 0;
-
-	while (q_len(queue) > 0) {
-		int i;
-		struct loc grid1;
-		int n1 = q_pop_int(queue);
-
-		i_to_grid(n1, w, &grid1);
+	int color = 1;
+	int i;
 
-		if (ignore_point(c, colors, grid1)) continue;
+	/* Forest of points; points to ignore are marked with -1 */
+	int *points = mem_zalloc(size * sizeof(int));
 
-		colors[n1] = color;
-		counts[color]++;
-		if (stairs && square_isstairs(c, grid1)) stairs[color] = true;
+	for (grid.y = 0; grid.y < h; grid.y++) {
+		for (grid.x = 0; grid.x < w; grid.x++) {
+			int n = grid_to_i(grid, w);
 
-		for (i = 0; i < (diagonal ? 8 : 4); i++) {
-			struct loc grid2 = loc_sum(grid1, ddgrid_ddd[i]);
-			int n2 = grid_to_i(grid2, w);
-			if (ignore_point(c, colors, grid2)) continue;
-			if (added[n2]) continue;
+			if (ignore_point(c, grid)) {
+				points[n] = -1;
+				continue;
+			}
+			points[n] = n;
 
-			q_push_int(queue, n2);
-			added[n2] = 1;
+			/* Merge with the west, north and (optionally) the
+			 * north-west and north-east neighbours */
+			if (grid.x > 0 && points[n - 1] >= 0) {
+				region_union(points, n, n - 1);
+			}
+			if (grid.y > 0) {
+				if (points[n - w] >= 0) {
+					region_union(points, n, n - w);
+				}
+				if (diagonal && grid.x > 0 &&
+						points[n - w - 1] >= 0) {
+					region_union(points, n, n - w - 1);
+				}
+				if (diagonal && grid.x < w - 1 &&
+						points[n - w + 1] >= 0) {
+					region_union(points, n, n - w + 1);
+				}
+			}
 		}
 	}
 
-	mem_free(added);
-	q_free(queue);
-}
-
-/**
- * Create a color for each "NESW contiguous" region of the dungeon.
- * \param c is the current chunk
- * \param colors is the array of current point colors
- * \param counts is the array of current color counts
- * \param stairs If not NULL, stairs is an array with the same number of
- * elements as counts.  At exit, stairs[i] will indicate whether the region
- * with color i includes a staircase.
- * \param diagonal controls whether we can progress diagonally
- */
-static void build_colors(struct chunk *c, int colors[], int counts[],
-		bool *stairs, bool diagonal)
-{
-	int y, x;
-	int h = c->height;
-	int w = c->width;
-	int color = 1;
+	/* Number the regions; each representative is its region's first
+	 * point so it is always reached before the rest of the region */
+	for (i = 0; i < size; i++) {
+		struct loc grid1;
+		int root;
 
-	for (y = 0; y < h; y++) {
-		for (x = 0; x < w; x++) {
-			if (ignore_point(c, colors, loc(x, y))) continue;
-			build_color_point(c, colors, counts, stairs,
-				loc(x, y), color, diagonal);
+		parent[i] = i;
+		if (points[i] < 0) {
+			colors[i] = 0;
+			continue;
+		}
+		root = region_find(points, i);
+		if (root == i) {
+			colors[i] = color;
+			counts[color] = 0;
 			color++;
+		} else {
+			colors[i] = colors[root];
 		}
+		counts[colors[i]]++;
+		i_to_grid(i, w, &grid1);
+		if (stairs && square_isstairs(c, grid1)) stairs[colors[i]] = true;
 	}
+
+	mem_free(points);
 }
 
 /**
@@ -1879,16 +2027,14 @@ static int first_color(int counts[], int size) {
 }
 
 /**
- * Find all cells of 'fromcolor' and repaint them to 'tocolor'.
- * \param colors is the array of current point colors
+ * Merge all cells of 'fromcolor' into 'tocolor'.
  * \param counts is the array of current color counts
+ * \param parent is the union-find forest of colors
  * \param from is the color to change
  * \param to is the color to change to
- * \param size is the total area
  */
-static void fix_colors(int colors[], int counts[], int from, int to, int size) {
-	int i;
-	for (i = 0; i < size; i++) if (colors[i] == from) colors[i] = to;
+static void fix_colors(int counts[], int parent[], int from, int to) {
+	parent[from] = to;
 	counts[to] += counts[from];
 	counts[from] = 0;
 }
@@ -1899,13 +2045,14 @@ static void fix_colors(int colors[], int counts[], int from, int to, int size) {
  * \param c is the current chunk
  * \param colors is the array of current point colors
  * \param counts is the array of current color counts
+ * \param parent is the union-find forest of colors
  * \param color is the color of the region we want to connect
  * \param new_color is the color of the region we want to connect to (if used)
  * \param allow_vault_disconnect If true, vaults can be included in path
  * planning which can leave regions disconnected.
  */
-static void join_region(struct chunk *c, int colors[], int counts[], int color,
-	int new_color, bool allow_vault_disconnect)
+static void join_region(struct chunk *c, int colors[], int counts[],
+	int parent[], int color, int new_color, bool allow_vault_disconnect)
 {
 	int i;
 	int h = c->height;
@@ -1923,7 +2070,7 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
 
 	/* Push all squares of the given color onto the queue */
 	for (i = 0; i < size; i++) {
-		if (colors[i] == color) {
+		if (point_color(colors, parent, i) == color) {
 			q_push_int(queue, i);
 			previous[i] = i;
 		}
@@ -1933,7 +2080,7 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
 	while (q_len(queue) > 0) {
 		/* Get the current square and its color */
 		int n1 = q_pop_int(queue);
-		int color2 = colors[n1];
+		int color2 = point_color(colors, parent, n1);
 
 		/* If we're not looking for a specific color, any new one will do */
 		if ((new_color == -1) && color2 && (color2 != color))
@@ -1942,11 +2089,12 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
 		/* See if we've reached a square with a new color */
 		if (color2 == new_color) {
 			/* Step backward through the path, turning stone to tunnel */
-			while (colors[n1] != color) {
+			while (point_color(colors, parent, n1) != color) {
 				struct loc grid;
+				int color1 = point_color(colors, parent, n1);
 				i_to_grid(n1, w, &grid);
-				if (colors[n1] > 0) {
-					--counts[colors[n1]];
+				if (color1 > 0) {
+					--counts[color1];
 				}
 				++counts[color];
 				colors[n1] = color;
@@ -1963,7 +2111,7 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
 			}
 
 			/* Update the color mapping to combine the two colors */
-			fix_colors(colors, counts, color2, color, size);
+			fix_colors(counts, parent, color2, color);
 
 			/* We're done now */
 			break;
@@ -2006,11 +2154,12 @@ static void join_region(struct chunk *c, int colors[], int counts[], int color,
  * \param c is the current chunk
  * \param colors is the array of current point colors
  * \param counts is the array of current color counts
+ * \param parent is the union-find forest of colors
  * \param allow_vault_disconnect If true, allows vaults to be included in
  * path planning which can leave regions disconnected.
  */
 static void join_regions(struct chunk *c, int colors[], int counts[],
-		bool allow_vault_disconnect) {
+		int parent[], bool allow_vault_disconnect) {
 	int h = c->height;
 	int w = c->width;
 	int size = h * w;
@@ -2021,7 +2170,7 @@ static void join_regions(struct chunk *c, int colors[], int counts[],
 	 */
 	while (num > 1) {
 		int color = first_color(counts, size);
-		join_region(c, colors, counts, color, -1,
+		join_region(c, colors, counts, parent, color, -1,
 			allow_vault_disconnect);
 		num--;
 	}
@@ -2039,12 +2188,14 @@ void ensure_connectedness(struct chunk *c, bool allow_vault_disconnect) {
 	int size = c->height * c->width;
 	int *colors = mem_zalloc(size * sizeof(int));
 	int *counts = mem_zalloc(size * sizeof(int));
+	int *parent = mem_zalloc(size * sizeof(int));
 
-	build_colors(c, colors, counts, NULL, true);
-	join_regions(c, colors, counts, allow_vault_disconnect);
+	build_colors(c, colors, counts, parent, NULL, true);
+	join_regions(c, colors, counts, parent, allow_vault_disconnect);
 
 	mem_free(colors);
 	mem_free(counts);
+	mem_free(parent);
 }
 
 
@@ -2070,6 +2221,7 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 
 	int *colors = mem_zalloc(size * sizeof(int));
 	int *counts = mem_zalloc(size * sizeof(int));
+	int *parent = mem_zalloc(size * sizeof(int));
 	bool *stairs = (join) ? mem_zalloc(size * sizeof(*stairs)) : NULL;
 	int tries;
 
@@ -2083,7 +2235,7 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 	for (tries = 0; tries < MAX_CAVERN_TRIES; tries++) {
 		/* Build a random cavern and mutate it a number of times */
 		init_cavern(c, density, join);
-		for (i = 0; i < times; i++) mutate_cavern(c);
+		mutate_cavern(c, times);
 
 		/* If there are enough open squares then we're done */
 		if (c->feat_count[FEAT_FLOOR] >= limit) {
@@ -2098,14 +2250,15 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 	if (tries == MAX_CAVERN_TRIES) {
 		mem_free(colors);
 		mem_free(counts);
+		mem_free(parent);
 		mem_free(stairs);
 		cave_free(c);
 		return NULL;
 	}
 
-	build_colors(c, colors, counts, stairs, false);
+	build_colors(c, colors, counts, parent, stairs, false);
 	clear_small_regions(c, colors, counts, stairs);
-	join_regions(c, colors, counts, true);
+	join_regions(c, colors, counts, parent, true);
 
 	/* Convert the permanent rock walls near stairs back to granite. */
 	while (join) {
@@ -2121,6 +2274,7 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 
 	mem_free(colors);
 	mem_free(counts);
+	mem_free(parent);
 	mem_free(stairs);
 
 	return c;
@@ -3409,31 +3563,33 @@ static void connect_caverns(struct chunk *c, struct loc floor[])
 	int size = c->height * c->width;
 	int *colors = mem_zalloc(size * sizeof(int));
 	int *counts = mem_zalloc(size * sizeof(int));
+	int *parent = mem_zalloc(size * sizeof(int));
 	int color_of_floor[4];
 
 	/* Color the regions, find which cavern is which color */
-	build_colors(c, colors, counts, NULL, true);
+	build_colors(c, colors, counts, parent, NULL, true);
 	for (i = 0; i < 4; i++) {
 		int spot = grid_to_i(floor[i], c->width);
-		color_of_floor[i] = colors[spot];
+		color_of_floor[i] = point_color(colors, parent, spot);
 	}
 
 	/* Join left and upper, right and lower */
-	join_region(c, colors, counts, color_of_floor[0], color_of_floor[1],
-		false);
-	join_region(c, colors, counts, color_of_floor[2], color_of_floor[3],
-		false);
+	join_region(c, colors, counts, parent, color_of_floor[0],
+		color_of_floor[1], false);
+	join_region(c, colors, counts, parent, color_of_floor[2],
+		color_of_floor[3], false);
 
 	/* Join the two big caverns */
 	for (i = 1; i < 3; i++) {
 		int spot = grid_to_i(floor[i], c->width);
-		color_of_floor[i] = colors[spot];
+		color_of_floor[i] = point_color(colors, parent, spot);
 	}
-	join_region(c, colors, counts, color_of_floor[1], color_of_floor[2],
-		false);
+	join_region(c, colors, counts, parent, color_of_floor[1],
+		color_of_floor[2], false);
 
 	mem_free(colors);
 	mem_free(counts);
+	mem_free(parent);
 }
 /**
  * Generate a hard centre level - a greater vault surrounded by caverns
@@ -4055,8 +4211,11 @@ struct chunk *arena_gen(struct player *p, int min_height, int min_width) {
 	/* Place the player */
 	player_place(c, p, loc(1, c->height - 2));
 
-	/* Place the monster */
+	/* Place the monster, bringing what it knows of the player (but not its
+	 * heatmaps, which belong to the level it came from) */
 	memcpy(&c->monsters[mon->midx], mon, sizeof(*mon));
+	c->monsters_cold[mon->midx].known_pstate =
+		cave_monster_cold(cave, mon->midx)->known_pstate;
 	mon = &c->monsters[mon->midx];
 	mon->grid = loc(c->width - 2, 1);
 	square_set_mon(c, mon->grid, mon->midx);
@@ -429,6 +429,8 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 
 		/* Copy */
 		memcpy(dest_mon, source_mon, sizeof(struct monster));
+		memcpy(&dest->monsters_cold[mon_skip + i], &source->monsters_cold[i],
+			sizeof(struct monster_cold));
 
 		/* Adjust monster index */
 		dest_mon->midx += mon_skip;
@@ -47,6 +47,7 @@
 #include "player-quest.h"
 #include "player-util.h"
 #include "trap.h"
+#include "z-profile.h"
 #include "z-queue.h"
 #include "z-type.h"
 
@@ -1511,6 +1512,8 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 	int i, tries = 0;
 	struct chunk *chunk = NULL;
 
+	PROFILE_BEGIN(CAVE_GENERATE);
+
 	/* Arena levels handled separately */
 	if (p->upkeep->arena_level) {
 		/* Generate level */
@@ -1530,6 +1533,7 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 		wiz_light(chunk, p, false);
 		chunk->turn = turn;
  
+		PROFILE_END(CAVE_GENERATE);
 		return chunk;
 	}
 
@@ -1670,6 +1674,7 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 
 	chunk->turn = turn;
 
+	PROFILE_END(CAVE_GENERATE);
 	return chunk;
 }
 
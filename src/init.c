@@ -68,6 +68,7 @@
 #include "ui-entry.h"
 #include "ui-entry-init.h"
 #include "ui-visuals.h"
+#include "z-profile.h"
 
 bool play_again = false;
 
@@ -2138,6 +2139,12 @@ static errr finish_parse_feat(struct parser *p) {
 		mem_free(f);
 	}
 
+	/* Resolve the features to mimic, once and for all */
+	for (fidx = 0; fidx < z_info->f_max; fidx++) {
+		f = &f_info[fidx];
+		f->mimic_idx = f->mimic ? lookup_feat(f->mimic) : fidx;
+	}
+
 	/* Set the terrain constants */
 	set_terrain();
 
@@ -4257,10 +4264,15 @@ static struct init_module arrays_module = {
 extern struct init_module z_quark_module;
 extern struct init_module generate_module;
 extern struct init_module rune_module;
+extern struct init_module obj_pile_module;
 extern struct init_module obj_make_module;
 extern struct init_module ignore_module;
 extern struct init_module mon_make_module;
+extern struct init_module mon_move_module;
+extern struct init_module player_attack_module;
 extern struct init_module player_module;
+extern struct init_module player_path_module;
+extern struct init_module save_module;
 extern struct init_module store_module;
 extern struct init_module messages_module;
 extern struct init_module options_module;
@@ -4273,11 +4285,16 @@ static struct init_module *modules[] = {
 	&ui_visuals_module, /* This needs to load before monsters and objects. */
 	&arrays_module,
 	&player_module,
+	&player_path_module,
+	&save_module,
 	&generate_module,
 	&rune_module,
+	&obj_pile_module,
 	&obj_make_module,
 	&ignore_module,
 	&mon_make_module,
+	&mon_move_module,
+	&player_attack_module,
 	&store_module,
 	&options_module,
 	&ui_player_module,
@@ -4355,6 +4372,7 @@ void cleanup_angband(void)
 
 	monster_list_finalize();
 	object_list_finalize();
+	profile_cleanup();
 
 	cleanup_game_constants();
 
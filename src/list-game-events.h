@@ -0,0 +1,84 @@
+/**
+ * \file list-game-events.h
+ * \brief Game events we can send signals about
+ *
+ * name - the event is EVENT_<name>
+ */
+
+/* name */
+EVENT(MAP)					/* Some part of the map has changed. */
+
+EVENT(STATS)				/* One or more of the stats. */
+EVENT(HP)					/* HP or MaxHP. */
+EVENT(MANA)					/* Mana or MaxMana. */
+EVENT(AC)					/* Armour Class. */
+EVENT(EXPERIENCE)			/* Experience or MaxExperience. */
+EVENT(PLAYERLEVEL)			/* Player's level has changed */
+EVENT(PLAYERTITLE)			/* Player's title has changed */
+EVENT(GOLD)					/* Player's gold amount. */
+EVENT(MONSTERHEALTH)		/* Observed monster's health level. */
+EVENT(DUNGEONLEVEL)			/* Dungeon depth */
+EVENT(PLAYERSPEED)			/* Player's speed */
+EVENT(RACE_CLASS)			/* Race or Class */
+EVENT(STUDYSTATUS)			/* "Study" availability */
+EVENT(STATUS)				/* Status */
+EVENT(DETECTIONSTATUS)		/* Trap detection status */
+EVENT(FEELING)				/* Object level feeling */
+EVENT(LIGHT)				/* Light level */
+EVENT(STATE)				/* The two 'R's: Resting and Repeating */
+
+EVENT(PLAYERMOVED)
+EVENT(SEEFLOOR)				/* When the player would "see" floor objects */
+EVENT(EXPLOSION)
+EVENT(BOLT)
+EVENT(MISSILE)
+EVENT(PAUSE)
+
+EVENT(INVENTORY)
+EVENT(EQUIPMENT)
+EVENT(ITEMLIST)				/* Held back until the next refresh */
+EVENT(MONSTERLIST)			/* Held back until the next refresh */
+EVENT(MONSTERTARGET)
+EVENT(OBJECTTARGET)
+EVENT(MESSAGE)
+EVENT(SOUND)
+EVENT(BELL)
+EVENT(USE_STORE)
+EVENT(STORECHANGED)			/* Triggered on a successful buy/retrieve or sell/drop */
+
+EVENT(INPUT_FLUSH)
+EVENT(MESSAGE_FLUSH)
+EVENT(CHECK_INTERRUPT)
+EVENT(REFRESH)
+EVENT(NEW_LEVEL_DISPLAY)
+EVENT(COMMAND_REPEAT)
+EVENT(ANIMATE)
+EVENT(CHEAT_DEATH)
+
+EVENT(INITSTATUS)			/* New status message for initialisation */
+EVENT(BIRTHPOINTS)			/* Change in the birth points */
+
+/* Changing of the game state/context. */
+EVENT(ENTER_INIT)
+EVENT(LEAVE_INIT)
+EVENT(ENTER_BIRTH)
+EVENT(LEAVE_BIRTH)
+EVENT(ENTER_GAME)
+EVENT(LEAVE_GAME)
+EVENT(ENTER_WORLD)
+EVENT(LEAVE_WORLD)
+EVENT(ENTER_STORE)
+EVENT(LEAVE_STORE)
+EVENT(ENTER_DEATH)
+EVENT(LEAVE_DEATH)
+
+/* Events for introspection into dungeon generation */
+EVENT(GEN_LEVEL_START)		/* has string in event data for profile name */
+EVENT(GEN_LEVEL_END)		/* has flag in event data indicating success */
+EVENT(GEN_ROOM_START)		/* has string in event data for room type */
+EVENT(GEN_ROOM_CHOOSE_SIZE)	/* has size in event data */
+EVENT(GEN_ROOM_CHOOSE_SUBTYPE)	/* has string in event data with name */
+EVENT(GEN_ROOM_END)			/* has flag in event data indicating success */
+EVENT(GEN_TUNNEL_FINISHED)	/* has tunnel in event data with results */
+
+EVENT(END)					/* Can be sent at the end of a series of events */
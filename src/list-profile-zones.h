@@ -0,0 +1,17 @@
+/**
+ * \file list-profile-zones.h
+ * \brief Parts of the game that are timed in profiling builds
+ *
+ * name - the zone is PZ_<name>
+ * function - the function the zone covers, for reports
+ */
+
+/* name				function */
+PZ(UPDATE_VIEW,		"update_view")
+PZ(UPDATE_MONSTERS,	"update_monsters")
+PZ(PROCESS_MONSTERS,	"process_monsters")
+PZ(MAKE_NOISE,		"make_noise")
+PZ(PROJECT,			"project")
+PZ(CALC_BONUSES,	"calc_bonuses")
+PZ(TERM_FRESH,		"Term_fresh")
+PZ(CAVE_GENERATE,	"cave_generate")
@@ -93,6 +93,11 @@ static byte trf_size = 0;
  */
 typedef struct object *(*rd_item_t)(void);
 
+/**
+ * Shorthand function pointer for reading a chunk's squares
+ */
+typedef int (*rd_squares_t)(struct chunk *c);
+
 /**
  * Read an object.
  */
@@ -187,7 +192,7 @@ static struct object *rd_item(void)
 	/* Read brands */
 	rd_byte(&tmp8u);
 	if (tmp8u) {
-		obj->brands = mem_zalloc(z_info->brand_max * sizeof(bool));
+		obj->brands = object_new_brands();
 		for (i = 0; i < brand_max; i++) {
 			rd_byte(&tmp8u);
 			obj->brands[i] = tmp8u ? true : false;
@@ -197,7 +202,7 @@ static struct object *rd_item(void)
 	/* Read slays */
 	rd_byte(&tmp8u);
 	if (tmp8u) {
-		obj->slays = mem_zalloc(z_info->slay_max * sizeof(bool));
+		obj->slays = object_new_slays();
 		for (i = 0; i < slay_max; i++) {
 			rd_byte(&tmp8u);
 			obj->slays[i] = tmp8u ? true : false;
@@ -207,7 +212,7 @@ static struct object *rd_item(void)
 	/* Read curses */
 	rd_byte(&tmp8u);
 	if (tmp8u) {
-		obj->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+		obj->curses = object_new_curses();
 		for (i = 0; i < curse_max; i++) {
 			rd_byte(&tmp8u);
 			obj->curses[i].power = tmp8u;
@@ -269,10 +274,16 @@ static bool rd_monster(struct chunk *c, struct monster *mon)
 	char race_name[80];
 	size_t j;
 	bool delete = false;
+	struct monster_cold *cold;
 
 	/* Read the monster race */
 	rd_u16b(&tmp16u);
 	mon->midx = tmp16u;
+	if (!mon->midx || mon->midx >= z_info->level_monster_max) {
+		note(format("Bad monster index %d!", mon->midx));
+		return false;
+	}
+	cold = cave_monster_cold(c, mon->midx);
 	rd_string(race_name, sizeof(race_name));
 	mon->race = lookup_monster(race_name);
 	if (!mon->race) {
@@ -327,10 +338,10 @@ static bool rd_monster(struct chunk *c, struct monster *mon)
 		rd_byte(&mon->mflag[j]);
 
 	for (j = 0; j < of_size; j++)
-		rd_byte(&mon->known_pstate.flags[j]);
+		rd_byte(&cold->known_pstate.flags[j]);
 
 	for (j = 0; j < elem_max; j++)
-		rd_s16b(&mon->known_pstate.el_info[j].res_level);
+		rd_s16b(&cold->known_pstate.el_info[j].res_level);
 
 	rd_u16b(&tmp16u);
 
@@ -1056,7 +1067,11 @@ int rd_ignore(void)
 }
 
 
-int rd_misc(void)
+/**
+ * Read the misc block; streams_marked is true for versions which record how
+ * the random artifacts were designed from their seed.
+ */
+static int rd_misc_version(bool streams_marked)
 {
 	size_t i;
 	int j;
@@ -1089,8 +1104,14 @@ int rd_misc(void)
 			string_make(level_name(&world->levels[player->last_place]));
 	}
 
-	/* Read the randart seed */
+	/* Read the randart seed; older characters had serially designed sets */
 	rd_u32b(&seed_randart);
+	if (streams_marked) {
+		rd_byte(&tmp8u);
+		randart_streams = tmp8u ? true : false;
+	} else {
+		randart_streams = false;
+	}
 
 	/* Read the flavors seed */
 	rd_u32b(&seed_flavor);
@@ -1114,7 +1135,7 @@ int rd_misc(void)
 			activate_randart_file();
 			run_parser(&randart_parser);
 		} else {
-			initialize_random_artifacts(seed_randart);
+			initialize_random_artifacts(seed_randart, randart_streams);
 		}
 		deactivate_randart_file();
 		init_race_probs();
@@ -1164,6 +1185,19 @@ int rd_misc(void)
 	return 0;
 }
 
+/**
+ * Read the misc block - wrapper functions
+ */
+int rd_misc(void)
+{
+	return rd_misc_version(true);
+}
+
+int rd_misc_1(void)
+{
+	return rd_misc_version(false);
+}
+
 int rd_artifacts(void)
 {
 	int i;
@@ -1392,50 +1426,19 @@ int rd_stores(void) { return rd_stores_aux(rd_item); }
 
 
 /**
- * Read the dungeon
- *
- * The monsters/objects must be loaded in the same order
- * that they were stored, since the actual indexes matter.
- *
- * Note that the size of the dungeon is now the currrent dimensions of the
- * cave global variable.
- *
- * Note that dungeon objects, including objects held by monsters, are
- * placed directly into the dungeon, using "object_copy()", which will
- * copy "iy", "ix", and "held_m_idx", leaving "next_o_idx" blank for
- * objects held by monsters, since it is not saved in the savefile.
- *
- * After loading the monsters, the objects being held by monsters are
- * linked directly into those monsters.
+ * Read the terrain features and info flags of a chunk's squares, stored as
+ * separate byte run length encoded planes (dungeon block version 1)
  */
-static int rd_dungeon_aux(struct chunk **c)
+static int rd_squares_1(struct chunk *c)
 {
-	struct chunk *c1;
 	int i, n, y, x;
-
-	u16b height, width;
-
 	byte count;
 	byte tmp8u;
-	u16b tmp16u;
-	char name[100];
-
-	/* Header info */
-	rd_string(name, sizeof(name));
-	if (streq(name, "arena")) {
-		player->upkeep->arena_level = true;
-	}
-	rd_u16b(&height);
-	rd_u16b(&width);
-
-	/* We need a cave struct */
-	c1 = cave_new(height, width);
-	c1->name = string_make(name);
 
-    /* Run length decoding of cave->squares[y][x].info */
+	/* Run length decoding of cave->squares[y][x].info */
 	for (n = 0; n < square_size; n++) {
 		/* Load the dungeon data */
-		for (x = y = 0; y < c1->height; ) {
+		for (x = y = 0; y < c->height; ) {
 			/* Grab RLE info */
 			rd_byte(&count);
 			rd_byte(&tmp8u);
@@ -1443,22 +1446,22 @@ static int rd_dungeon_aux(struct chunk **c)
 			/* Apply the RLE info */
 			for (i = count; i > 0; i--) {
 				/* Extract "info" */
-				c1->squares[y][x].info[n] = tmp8u;
+				c->squares[y][x].info[n] = tmp8u;
 
 				/* Advance/Wrap */
-				if (++x >= c1->width) {
+				if (++x >= c->width) {
 					/* Wrap */
 					x = 0;
 
 					/* Advance/Wrap */
-					if (++y >= c1->height) break;
+					if (++y >= c->height) break;
 				}
 			}
 		}
 	}
 
 	/* Run length decoding of dungeon data */
-	for (x = y = 0; y < c1->height; ) {
+	for (x = y = 0; y < c->height; ) {
 		/* Grab RLE info */
 		rd_byte(&count);
 		rd_byte(&tmp8u);
@@ -1466,19 +1469,134 @@ static int rd_dungeon_aux(struct chunk **c)
 		/* Apply the RLE info */
 		for (i = count; i > 0; i--) {
 			/* Extract "feat" */
-			square_set_feat(c1, loc(x, y), tmp8u);
+			square_set_feat(c, loc(x, y), tmp8u);
 
 			/* Advance/Wrap */
-			if (++x >= c1->width) {
+			if (++x >= c->width) {
 				/* Wrap */
 				x = 0;
 
 				/* Advance/Wrap */
-				if (++y >= c1->height) break;
+				if (++y >= c->height) break;
 			}
 		}
 	}
 
+	return 0;
+}
+
+/**
+ * Read the terrain features and info flags of a chunk's squares, stored as
+ * one run length encoded stream of rows, some XORed with the row above (dungeon
+ * block version 2); see wr_dungeon_squares()
+ */
+static int rd_squares(struct chunk *c)
+{
+	int y, x, n;
+	u32b width = c->width, rows = c->height * (1 + square_size);
+	u32b len = width * rows;
+	u32b pos, run, r;
+	byte *bytes = mem_alloc(len ? len : 1);
+	byte *flags = mem_zalloc((rows + 7) / 8);
+
+	/* Which rows are differenced */
+	for (r = 0; r < (rows + 7) / 8; r++)
+		rd_byte(&flags[r]);
+
+	/* Run length decoding */
+	for (pos = 0; pos < len; pos += run) {
+		bool repeat;
+
+		rd_varint(&run);
+		repeat = run & 1;
+		run >>= 1;
+		if (!run || run > len - pos) {
+			note("Corrupt dungeon squares in savefile");
+			mem_free(flags);
+			mem_free(bytes);
+			return -1;
+		}
+		if (repeat) {
+			byte tmp8u;
+
+			rd_byte(&tmp8u);
+			memset(bytes + pos, tmp8u, run);
+		} else {
+			for (r = 0; r < run; r++)
+				rd_byte(&bytes[pos + r]);
+		}
+	}
+
+	/* Undo the differences, working downwards */
+	for (r = 1; r < rows; r++) {
+		byte *row = bytes + r * width;
+		const byte *above = row - width;
+
+		if (!(flags[r / 8] & (1 << (r % 8)))) continue;
+		for (pos = 0; pos < width; pos++)
+			row[pos] ^= above[pos];
+	}
+	mem_free(flags);
+
+	/* Apply the planes */
+	for (y = 0; y < c->height; y++) {
+		for (x = 0; x < c->width; x++) {
+			square_set_feat(c, loc(x, y), bytes[y * width + x]);
+			for (n = 0; n < square_size; n++)
+				c->squares[y][x].info[n] =
+					bytes[((n + 1) * c->height + y) * width + x];
+		}
+	}
+
+	mem_free(bytes);
+	return 0;
+}
+
+/**
+ * Read the dungeon
+ *
+ * The monsters/objects must be loaded in the same order
+ * that they were stored, since the actual indexes matter.
+ *
+ * Note that the size of the dungeon is now the currrent dimensions of the
+ * cave global variable.
+ *
+ * Note that dungeon objects, including objects held by monsters, are
+ * placed directly into the dungeon, using "object_copy()", which will
+ * copy "iy", "ix", and "held_m_idx", leaving "next_o_idx" blank for
+ * objects held by monsters, since it is not saved in the savefile.
+ *
+ * After loading the monsters, the objects being held by monsters are
+ * linked directly into those monsters.
+ */
+static int rd_dungeon_aux(struct chunk **c, rd_squares_t rd_squares_version)
+{
+	struct chunk *c1;
+	int n;
+
+	u16b height, width;
+
+	byte tmp8u;
+	u16b tmp16u;
+	char name[100];
+
+	/* Header info */
+	rd_string(name, sizeof(name));
+	if (streq(name, "arena")) {
+		player->upkeep->arena_level = true;
+	}
+	rd_u16b(&height);
+	rd_u16b(&width);
+
+	/* We need a cave struct */
+	c1 = cave_new(height, width);
+	c1->name = string_make(name);
+
+	/* Terrain and info flags */
+	if ((*rd_squares_version)(c1)) {
+		cave_free(c1);
+		return -1;
+	}
 
 	/* Read "feeling" */
 	rd_byte(&tmp8u);
@@ -1638,7 +1756,7 @@ static int rd_traps_aux(struct chunk *c)
 	return 0;
 }
 
-int rd_dungeon(void)
+static int rd_dungeon_version(rd_squares_t rd_squares_version)
 {
 	u16b depth;
 	u16b py, px;
@@ -1660,7 +1778,7 @@ int rd_dungeon(void)
 		return (0);
 	}
 
-	if (rd_dungeon_aux(&cave))
+	if (rd_dungeon_aux(&cave, rd_squares_version))
 		return 1;
 
 	/* Ignore illegal dungeons */
@@ -1681,7 +1799,7 @@ int rd_dungeon(void)
 	character_dungeon = true;
 
 	/* Read known cave */
-	if (rd_dungeon_aux(&player->cave)) {
+	if (rd_dungeon_aux(&player->cave, rd_squares_version)) {
 		return 1;
 	}
 	player->cave->depth = depth;
@@ -1689,6 +1807,19 @@ int rd_dungeon(void)
 	return 0;
 }
 
+/**
+ * Read the dungeon - wrapper functions
+ */
+int rd_dungeon(void)
+{
+	return rd_dungeon_version(rd_squares);
+}
+
+int rd_dungeon_1(void)
+{
+	return rd_dungeon_version(rd_squares_1);
+}
+
 
 /**
  * Read the objects - wrapper functions
@@ -1754,7 +1885,7 @@ int rd_traps(void)
 /**
  * Read the chunk list
  */
-int rd_chunks(void)
+static int rd_chunks_version(rd_squares_t rd_squares_version)
 {
 	int j;
 	u16b chunk_max;
@@ -1767,7 +1898,7 @@ int rd_chunks(void)
 		struct chunk *c;
 
 		/* Read the dungeon */
-		if (rd_dungeon_aux(&c))
+		if (rd_dungeon_aux(&c, rd_squares_version))
 			return -1;
 
 		/* Read the objects */
@@ -1847,6 +1978,19 @@ int rd_chunks(void)
 	return 0;
 }
 
+/**
+ * Read the chunk list - wrapper functions
+ */
+int rd_chunks(void)
+{
+	return rd_chunks_version(rd_squares);
+}
+
+int rd_chunks_1(void)
+{
+	return rd_chunks_version(rd_squares_1);
+}
+
 
 int rd_history(void)
 {
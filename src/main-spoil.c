@@ -31,16 +31,25 @@
 #include "ui-game.h"
 #include "wizard.h"
 
+#ifdef UNIX
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef WINDOWS
+#include <io.h>
+#endif
+
 static struct {
 	char letter;
-	void (*func)(const char*);
+	textblock *(*text)(void);
+	textblock *(*text_part)(int part, int parts);
 	bool enabled;
 	const char *path;
 } opts[] = {
-	{ 'a', spoil_artifact, false, NULL },
-	{ 'm', spoil_mon_desc, false, NULL },
-	{ 'M', spoil_mon_info, false, NULL },
-	{ 'o', spoil_obj_desc, false, NULL },
+	{ 'a', spoil_artifact_text, NULL, false, NULL },
+	{ 'm', spoil_mon_desc_text, NULL, false, NULL },
+	{ 'M', NULL, spoil_mon_info_text, false, NULL },
+	{ 'o', spoil_obj_desc_text, NULL, false, NULL },
 };
 
 const char help_spoil[] =
@@ -51,39 +60,226 @@ const char help_spoil[] =
 	"              -m fname    Write brief monster spoilers to fname\n"
 	"              -M fname    Write extended monster spoilers to fname\n"
 	"              -o fname    Write object spoilers to fname\n"
+	"                          (for any of those, a fname of - writes\n"
+	"                          to standard output)\n"
+	"              -j n        Use up to n worker processes\n"
 	"              -p          Use the artifacts associated with the\n"
 	"                          the savefile set by main.c\n"
 	"              -r fname    Use the randart file, fname, as the source\n"
 	"                          of the artifacts";
 
+/**
+ * A piece of spoiler output:  all of one kind of spoiler, or one part of the
+ * extended monster spoilers, which are split up between the workers.
+ */
+struct spoil_job {
+	int opt;
+	int part;
+	int parts;
+#ifdef UNIX
+	pid_t pid;
+	int fd;
+#endif
+};
+
+/**
+ * Create the text for a piece of spoiler output.
+ */
+static textblock *spoil_job_text(const struct spoil_job *job)
+{
+	if (opts[job->opt].text_part) {
+		return (*(opts[job->opt].text_part))(job->part, job->parts);
+	}
+	return (*(opts[job->opt].text))();
+}
+
+/**
+ * Open the destination for a kind of spoiler:  a file in the user directory,
+ * or standard output if the name is "-".
+ */
+static ang_file *spoil_open(const char *path)
+{
+	char buf[1024];
+
+	if (streq(path, "-")) {
+		fflush(stdout);
+		return file_fdopen(dup(fileno(stdout)), MODE_WRITE);
+	}
+
+	path_build(buf, sizeof(buf), ANGBAND_DIR_USER, path);
+	return file_open(buf, MODE_WRITE, FTYPE_TEXT);
+}
+
+#ifdef UNIX
+/**
+ * Start a worker process to create the text for a piece of spoiler output
+ * and send it back down a pipe.  Each worker has its own copy of the game
+ * data, so nothing is shared with the other workers.
+ */
+static bool spoil_job_start(struct spoil_job *job)
+{
+	int fds[2];
+
+	if (pipe(fds) != 0) return false;
+
+	job->pid = fork();
+	if (job->pid < 0) {
+		close(fds[0]);
+		close(fds[1]);
+		return false;
+	}
+
+	if (job->pid == 0) {
+		ang_file *f;
+		textblock *tb;
+
+		close(fds[0]);
+		f = file_fdopen(fds[1], MODE_WRITE);
+		if (!f) _exit(1);
+		tb = spoil_job_text(job);
+		textblock_to_file(tb, f, 0, SPOILER_NOWRAP);
+		textblock_free(tb);
+		_exit(file_close(f) ? 0 : 1);
+	}
+
+	close(fds[1]);
+	job->fd = fds[0];
+	return true;
+}
+
+/**
+ * Copy the output of a worker to the spoiler file and wait for the worker to
+ * finish.
+ */
+static bool spoil_job_finish(struct spoil_job *job, ang_file *f)
+{
+	char buf[4096];
+	ssize_t n;
+	int status;
+	bool ok = true;
+
+	while ((n = read(job->fd, buf, sizeof(buf))) > 0) {
+		if (f && !file_write(f, buf, n)) ok = false;
+	}
+	if (n < 0) ok = false;
+	close(job->fd);
+
+	if (waitpid(job->pid, &status, 0) != job->pid || !WIFEXITED(status) ||
+			WEXITSTATUS(status) != 0) {
+		ok = false;
+	}
+
+	return ok;
+}
+#endif
+
+/**
+ * Write out all of the requested spoilers.  With more than one worker, the
+ * pieces are created in worker processes, while this process writes them out
+ * in order as they come in.
+ */
+static int spoil_generate(int workers)
+{
+	struct spoil_job *jobs;
+	ang_file *f = NULL;
+	int n_jobs = 0, started = 0, i, j;
+	int result = 0;
+
+	/* Split up the work */
+	jobs = mem_zalloc(N_ELEMENTS(opts) * MAX(workers, 1) * sizeof(*jobs));
+	for (i = 0; i < (int)N_ELEMENTS(opts); ++i) {
+		int parts = (opts[i].text_part) ? MAX(workers, 1) : 1;
+
+		if (!opts[i].enabled) continue;
+		for (j = 0; j < parts; j++) {
+			jobs[n_jobs].opt = i;
+			jobs[n_jobs].part = j;
+			jobs[n_jobs].parts = parts;
+			n_jobs++;
+		}
+	}
+
+	for (i = 0; i < n_jobs; i++) {
+		struct spoil_job *job = &jobs[i];
+		bool ok = true;
+
+		/* Open the file at the start of each kind of spoiler */
+		if (job->part == 0) {
+			f = spoil_open(opts[job->opt].path);
+			if (!f) {
+				printf("init-spoil: could not open '%s'.\n",
+					opts[job->opt].path);
+				result = 1;
+			}
+		}
+
+#ifdef UNIX
+		/* Keep the workers busy */
+		while (workers > 1 && started < n_jobs && started < i + workers &&
+				spoil_job_start(&jobs[started])) {
+			started++;
+		}
+		if (i < started) {
+			ok = spoil_job_finish(job, f);
+		} else
+#endif
+		{
+			/* No worker, so do it here */
+			if (f) {
+				textblock *tb = spoil_job_text(job);
+
+				textblock_to_file(tb, f, 0, SPOILER_NOWRAP);
+				textblock_free(tb);
+			}
+			started = i + 1;
+		}
+
+		if (!ok) {
+			printf("init-spoil: could not create the spoilers for '%s'.\n",
+				opts[job->opt].path);
+			result = 1;
+		}
+
+		/* Close the file at the end of each kind of spoiler */
+		if (f && job->part == job->parts - 1) {
+			if (!file_close(f)) {
+				printf("init-spoil: could not close '%s'.\n",
+					opts[job->opt].path);
+				result = 1;
+			}
+			f = NULL;
+		}
+	}
+
+	mem_free(jobs);
+
+	return result;
+}
+
 /**
  * Usage:
  *
  * angband -mspoil -- [-a fname] [-m fname] [-M fname] [-o fname] \
- *     [-p] [-r fname]
+ *     [-j n] [-p] [-r fname]
  *
  *   -a fname  Write artifact spoilers to a file named fname.  If neither -p or
  *             -u are used, the artifacts will be the standard set.
  *   -m fname  Write brief monster spoilers to a file named fname.
  *   -M fname  Write extended monster spoilers to a file named fname.
  *   -o fname  Write object spoilers to a file named fname.
+ *   -j n      Create the spoilers in up to n worker processes (only on
+ *             systems with fork()); the extended monster spoilers are split
+ *             into n parts.  The output is the same as with one worker.
  *   -p        Use the artifacts associated with savefile set by main.c.
  *
- * Bugs:
- * Would be nice to accept "-" as the file name and write the spoilers to
- * standard output in that case.  Given the current implementation in
- * wiz-spoil.c, that would require writing to a temporary file and then
- * copying the contents of that file to standard output.  Don't have temporary
- * file support in z-file.c so punting on that for now.
- *
- * The functions in wiz-spoil.c don't provide any feedback about whether the
- * operation failed so the exit code will always indicate success even if there
- * was a problem.
+ * A file name of "-" writes those spoilers to standard output; if more than
+ * one kind goes there, they appear in the order of the options above.
  */
 errr init_spoil(int argc, char *argv[]) {
 	/* Skip over argv[0] */
 	int i = 1;
 	int result = 0;
+	int workers = 1;
 	bool load_randart = false;
 
 	/* Parse the arguments. */
@@ -99,6 +295,19 @@ errr init_spoil(int argc, char *argv[]) {
 			/* Try to match with a known option. */
 			if (argv[i][1] == 'p' && argv[i][2] == '\0') {
 				load_randart = true;
+			} else if (argv[i][1] == 'j' && argv[i][2] == '\0') {
+				char *end = NULL;
+
+				if (i < argc - 1) {
+					workers = (int)strtol(argv[i + 1], &end, 10);
+				}
+				if (end && end != argv[i + 1] && *end == '\0' &&
+						workers > 0) {
+					++increment;
+				} else {
+					printf("init-spoil: '%s' requires an argument, the number of workers\n", argv[i]);
+					result = 1;
+				}
 			} else {
 				int j = 0;
 
@@ -171,10 +380,7 @@ errr init_spoil(int argc, char *argv[]) {
 
 	if (result == 0) {
 		flavor_set_all_aware();
-		for (i = 0; i < (int)N_ELEMENTS(opts); ++i) {
-			if (!opts[i].enabled) continue;
-			(*(opts[i].func))(opts[i].path);
-		}
+		result = spoil_generate(workers);
 	}
 
 	cleanup_angband();
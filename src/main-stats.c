@@ -28,6 +28,7 @@
 #include "mon-make.h"
 #include "mon-util.h"
 #include "monster.h"
+#include "obj-design.h"
 #include "obj-gear.h"
 #include "obj-properties.h"
 #include "obj-tval.h"
@@ -65,6 +66,7 @@
 
 static int no_selling = 0;
 static u32b num_runs = 1;
+static u32b num_randart_sets = 0;
 static bool quiet = false;
 static int nextkey = 0;
 static int running_stats = 0;
@@ -1513,6 +1515,37 @@ static void stats_cleanup_angband_run(void)
 	player->history = NULL;
 }
 
+/**
+ * Write the random artifact sets for seeds 0 to num_randart_sets - 1 to the
+ * stats directory, one file per seed, instead of making any runs
+ */
+static errr run_randart_sets(void)
+{
+	char fname[1024], leaf[32];
+	u32b seed;
+
+	prep_output_dir();
+	if (!quiet) {
+		printf("Writing %d random artifact sets...\n", num_randart_sets);
+		fflush(stdout);
+	}
+	for (seed = 0; seed < num_randart_sets; seed++) {
+		strnfmt(leaf, sizeof(leaf), "randart-%08x.txt", seed);
+		path_build(fname, sizeof(fname), ANGBAND_DIR_STATS, leaf);
+		write_random_artifact_set(seed, fname);
+		if (quiet && (seed + 1) % 1000 == 0) {
+			printf("Finished %d sets.\n", seed + 1);
+			fflush(stdout);
+		}
+	}
+
+	string_free(ANGBAND_DIR_STATS);
+	cleanup_angband();
+	if (!quiet) printf("Done!\n");
+	quit(NULL);
+	exit(0);
+}
+
 static errr run_stats(void)
 {
 	u32b run;
@@ -1625,6 +1658,7 @@ static errr term_xtra_event(int v) {
 		return 0;
 	}
 	running_stats = 1;
+	if (num_randart_sets) return run_randart_sets();
 	return run_stats();
 }
 
@@ -1699,14 +1733,15 @@ static void term_data_link(int i) {
 	angband_term[i] = t;
 }
 
-const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling)";
+const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andart sets) -n(# of runs) -s(no selling)";
 
 /**
  * Usage:
  *
- * angband -mstats -- [-q] [-r] [-nNNNN] [-s]
+ * angband -mstats -- [-q] [-rNNNN] [-nNNNN] [-s]
  *
  *   -q      Quiet mode (turn off progress messages)
+ *   -rNNNN  Just write the random artifact sets for seeds 0 to NNNN - 1
  *   -nNNNN  Make NNNN runs through the dungeon (default: 1)
  *   -s      Turn on no-selling
  */
@@ -1724,6 +1759,10 @@ errr init_stats(int argc, char *argv[]) {
 			num_runs = atoi(&argv[i][2]);
 			continue;
 		}
+		if (prefix(argv[i], "-r")) {
+			num_randart_sets = atoi(&argv[i][2]);
+			continue;
+		}
 		if (prefix(argv[i], "-s")) {
 			no_selling = 1;
 			continue;
@@ -204,40 +204,35 @@ static void remove_bad_spells(struct monster *mon, bitflag f[RSF_SIZE])
 	if (rf_has(mon->race->flags, RF_PLAYER_GHOST)) {
 		unset_spells(f2, player->state.flags, player->state.pflags,
 					 player->state.el_info, mon);
-	} else if (OPT(player, birth_ai_learn) && (mon->target.midx == -1)) {
+	} else if (OPT(player, birth_ai_learn) && (mon->target.midx == -1) &&
+			(mon->midx > 0)) {
 		/* Update acquired knowledge */
+		struct player_state *known =
+			&cave_monster_cold(cave, mon->midx)->known_pstate;
 		size_t i;
 
 		/* Occasionally forget player status */
 		if (one_in_(20)) {
-			of_wipe(mon->known_pstate.flags);
-			pf_wipe(mon->known_pstate.pflags);
+			of_wipe(known->flags);
+			pf_wipe(known->pflags);
 			for (i = 0; i < ELEM_MAX; i++) {
-				mon->known_pstate.el_info[i].res_level = RES_LEVEL_BASE;
+				known->el_info[i].res_level = RES_LEVEL_BASE;
 			}
 		} else {
-			bitflag ai_flags[OF_SIZE], ai_pflags[PF_SIZE];
-			struct element_info el[ELEM_MAX];
-			bool know_something = false;
-
 			/* Use the memorized info */
-			of_wipe(ai_flags);
-			pf_wipe(ai_pflags);
-			of_copy(ai_flags, mon->known_pstate.flags);
-			pf_copy(ai_pflags, mon->known_pstate.pflags);
-			if (!of_is_empty(ai_flags) || !pf_is_empty(ai_pflags)) {
-				know_something = true;
-			}
-			for (i = 0; i < ELEM_MAX; i++) {
-				el[i].res_level = mon->known_pstate.el_info[i].res_level;
-				if (el[i].res_level != RES_LEVEL_BASE) {
+			bool know_something = !of_is_empty(known->flags) ||
+				!pf_is_empty(known->pflags);
+
+			for (i = 0; !know_something && i < ELEM_MAX; i++) {
+				if (known->el_info[i].res_level != RES_LEVEL_BASE) {
 					know_something = true;
 				}
 			}
 
 			/* Cancel out certain flags based on knowledge */
 			if (know_something) {
-				unset_spells(f2, ai_flags, ai_pflags, el, mon);
+				unset_spells(f2, known->flags, known->pflags,
+							 known->el_info, mon);
 			}
 		}
 	}
@@ -291,26 +286,27 @@ static bool summon_possible(struct loc grid)
  *
  * Stupid monsters will just pick a spell randomly.  Smart monsters
  * will choose more "intelligently".
- *
- * This function could be an efficiency bottleneck.
  */
 int choose_attack_spell(bitflag *f, bool innate, bool non_innate)
 {
 	int num = 0;
 	byte spells[RSF_MAX];
-
+	bitflag choices[RSF_SIZE], innate_spells[RSF_SIZE];
 	int i;
 
-	/* Paranoid initialization */
-	for (i = 0; i < RSF_MAX; i++) {
-		spells[i] = 0;
-	}
+	/* Nothing chosen if there's nothing to choose from */
+	spells[0] = 0;
+
+	/* Filter the spells by whether they're innate */
+	rsf_copy(choices, f);
+	create_mon_spell_mask(innate_spells, RST_INNATE, RST_NONE);
+	if (!innate) rsf_diff(choices, innate_spells);
+	if (!non_innate) rsf_inter(choices, innate_spells);
 
-	/* Extract spells, filtering as necessary */
-	for (i = FLAG_START, num = 0; i < RSF_MAX; i++) {
-		if (!innate && mon_spell_is_innate(i)) continue;
-		if (!non_innate && !mon_spell_is_innate(i)) continue;
-		if (rsf_has(f, i)) spells[num++] = i;
+	/* Extract spells */
+	for (i = rsf_next(choices, FLAG_START); i != FLAG_END;
+		 i = rsf_next(choices, i + 1)) {
+		spells[num++] = i;
 	}
 
 	/* Pick at random */
@@ -449,7 +445,7 @@ bool make_ranged_attack(struct monster *mon)
 		}
 
 		/* Check for a possible summon */
-		if (!summon_possible(mon->grid)) {
+		if (test_spells(f, RST_SUMMON) && !summon_possible(mon->grid)) {
 			ignore_spells(f, RST_SUMMON);
 		}
 	}
@@ -39,6 +39,7 @@ struct blow_method *blow_methods;
 struct blow_effect *blow_effects;
 struct monster_pain *pain_messages;
 struct monster_spell *monster_spells;
+struct monster_spell *monster_spells_by_index[RSF_MAX];
 struct monster_base *rb_info;
 struct monster_race *r_info;
 struct ghost *ghosts;
@@ -905,8 +906,19 @@ static errr run_parse_mon_spell(struct parser *p) {
 }
 
 static errr finish_parse_mon_spell(struct parser *p) {
+	struct monster_spell *rs;
+
 	monster_spells = parser_priv(p);
 	parser_destroy(p);
+
+	/* Index the spells, keeping the first of any repeats in the list */
+	memset(monster_spells_by_index, 0, sizeof(monster_spells_by_index));
+	for (rs = monster_spells; rs; rs = rs->next) {
+		if (rs->index <= RSF_NONE || rs->index >= RSF_MAX) continue;
+		if (!monster_spells_by_index[rs->index]) {
+			monster_spells_by_index[rs->index] = rs;
+		}
+	}
 	return 0;
 }
 
@@ -933,6 +945,8 @@ static void cleanup_mon_spell(void)
 		mem_free(rs);
 		rs = next;
 	}
+	monster_spells = NULL;
+	memset(monster_spells_by_index, 0, sizeof(monster_spells_by_index));
 }
 
 struct file_parser mon_spell_parser = {
@@ -23,6 +23,30 @@
 #include "mon-predicate.h"
 #include "project.h"
 
+/**
+ * (Re)allocate the arrays which are sized by the number of entries. Anything
+ * remembered from earlier collections is forgotten.
+ */
+static void monster_list_size_aux(monster_list_t *list, size_t size)
+{
+	list->buckets_size = 1;
+	while (list->buckets_size < 2 * size)
+		list->buckets_size <<= 1;
+
+	mem_free(list->buckets);
+	list->buckets = mem_zalloc(list->buckets_size * sizeof(u16b));
+	mem_free(list->los);
+	list->los = mem_zalloc(size * sizeof(struct projectable_memo));
+	mem_free(list->order_race);
+	list->order_race = mem_zalloc(size * sizeof(struct monster_race *));
+	mem_free(list->order_p_race);
+	list->order_p_race = mem_zalloc(size * sizeof(struct player_race *));
+	mem_free(list->order);
+	list->order = mem_zalloc(size * sizeof(u16b));
+	list->order_count = 0;
+	list->order_compare = NULL;
+}
+
 /**
  * Allocate a new monster list based on the size of the current cave's monster
  * array.
@@ -43,6 +67,7 @@ monster_list_t *monster_list_new(void)
 	}
 
 	list->entries_size = size;
+	monster_list_size_aux(list, size);
 
 	return list;
 }
@@ -60,6 +85,11 @@ void monster_list_free(monster_list_t *list)
 		list->entries = NULL;
 	}
 
+	mem_free(list->buckets);
+	mem_free(list->los);
+	mem_free(list->order_race);
+	mem_free(list->order_p_race);
+	mem_free(list->order);
 	mem_free(list);
 	list = NULL;
 }
@@ -122,9 +152,11 @@ void monster_list_reset(monster_list_t *list)
 		list->entries = mem_realloc(list->entries, sizeof(list->entries[0])
 									* cave_monster_max(cave));
 		list->entries_size = cave_monster_max(cave);
+		monster_list_size_aux(list, list->entries_size);
 	}
 
 	memset(list->entries, 0, list->entries_size * sizeof(monster_list_entry_t));
+	memset(list->buckets, 0, list->buckets_size * sizeof(u16b));
 	memset(list->total_entries, 0, MONSTER_LIST_SECTION_MAX * sizeof(u16b));
 	memset(list->total_monsters, 0, MONSTER_LIST_SECTION_MAX * sizeof(u16b));
 	list->distinct_entries = 0;
@@ -132,12 +164,39 @@ void monster_list_reset(monster_list_t *list)
 	list->sorted = false;
 }
 
+/**
+ * Return the bucket for a (race, player race) key: either the one holding the
+ * key's entry or the empty one where it should go.
+ */
+static u16b *monster_list_bucket(monster_list_t *list,
+		const struct monster_race *race, const struct player_race *p_race)
+{
+	size_t mask = list->buckets_size - 1;
+	size_t i = (race->ridx * 31 + (p_race ? p_race->ridx + 1 : 0)) & mask;
+
+	while (list->buckets[i]) {
+		const monster_list_entry_t *entry =
+			&list->entries[list->buckets[i] - 1];
+
+		if (entry->race == race && entry->p_race == p_race)
+			break;
+		i = (i + 1) & mask;
+	}
+
+	return &list->buckets[i];
+}
+
 /**
  * Collect monster information from the current cave's monster list.
+ *
+ * The list is collected afresh for each PR_MONLIST redraw, which update_mon()
+ * asks for whenever a monster's visibility changes; what is kept between
+ * collections is the line of sight to each monster and the last sort order.
  */
 void monster_list_collect(monster_list_t *list)
 {
 	int i;
+	u16b distinct = 0;
 
 	if (list == NULL || list->entries == NULL)
 		return;
@@ -149,7 +208,8 @@ void monster_list_collect(monster_list_t *list)
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		struct monster *mon = cave_monster(cave, i);
 		monster_list_entry_t *entry = NULL;
-		int j, field;
+		u16b *bucket;
+		int field;
 		bool los = false;
 
 		/* Only consider visible, known monsters */
@@ -157,20 +217,17 @@ void monster_list_collect(monster_list_t *list)
 			continue;
 
 		/* Find or add a list entry. */
-		for (j = 0; j < (int)list->entries_size; j++) {
-			if (list->entries[j].race == NULL) {
-				/* We found an empty slot, so add this race here. */
-				entry = &list->entries[j];
-				memset(entry, 0, sizeof(monster_list_entry_t));
-				entry->race = mon->race;
-				entry->p_race = mon->player_race;
-				break;
-			} else if ((list->entries[j].race == mon->race) &&
-					   (list->entries[j].p_race == mon->player_race)) {
-				/* We found a matching race and we'll use that. */
-				entry = &list->entries[j];
-				break;
-			}
+		bucket = monster_list_bucket(list, mon->race, mon->player_race);
+		if (*bucket) {
+			/* We found a matching race and we'll use that. */
+			entry = &list->entries[*bucket - 1];
+		} else if (distinct < list->entries_size) {
+			/* Add this race in the next empty slot. */
+			entry = &list->entries[distinct];
+			memset(entry, 0, sizeof(monster_list_entry_t));
+			entry->race = mon->race;
+			entry->p_race = mon->player_race;
+			*bucket = ++distinct;
 		}
 
 		if (entry == NULL)
@@ -187,7 +244,8 @@ void monster_list_collect(monster_list_t *list)
 		 * but this does not catch monsters detected by ESP which are
 		 * targetable, so we cheat and use projectable() instead
 		 */
-		los = projectable(cave, player->grid, mon->grid, PROJECT_NONE);
+		los = projectable_memo(&list->los[i], cave, player->grid, mon->grid,
+			PROJECT_NONE);
 		field = (los) ? MONSTER_LIST_SECTION_LOS : MONSTER_LIST_SECTION_ESP;
 		entry->count[field]++;
 
@@ -203,7 +261,7 @@ void monster_list_collect(monster_list_t *list)
 	}
 
 	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++) {
+	for (i = 0; i < distinct; i++) {
 		if (list->entries[i].race == NULL)
 			continue;
 
@@ -275,13 +333,36 @@ int monster_list_compare_exp(const void *a, const void *b)
 	return 0;
 }
 
+/**
+ * The entries and comparison function monster_list_order_compare() works with
+ * while the monster list is being sorted.
+ */
+static const monster_list_entry_t *order_entries;
+static int (*order_compare)(const void *, const void *);
+
+/**
+ * Compare two positions in the monster list by the entries at them.
+ */
+static int monster_list_order_compare(const void *a, const void *b)
+{
+	return order_compare(&order_entries[*(const u16b *)a],
+		&order_entries[*(const u16b *)b]);
+}
+
 /**
  * Sort the monster list with the given sort function.
+ *
+ * The standard sort only looks at the races, so if the same races were
+ * collected in the same order as for the last sort, that sort's order is
+ * reused rather than sorting again.
  */
 void monster_list_sort(monster_list_t *list,
 					   int (*compare)(const void *, const void *))
 {
 	size_t elements;
+	size_t i;
+	bool same = true;
+	monster_list_entry_t *old;
 
 	if (list == NULL || list->entries == NULL)
 		return;
@@ -289,12 +370,49 @@ void monster_list_sort(monster_list_t *list,
 	if (list->sorted)
 		return;
 
-	elements = list->distinct_entries;
+	elements = MIN(list->distinct_entries, list->entries_size);
 
 	if (elements <= 1)
 		return;
 
-	sort(list->entries, MIN(elements, list->entries_size), sizeof(list->entries[0]), compare);
+	/* Check whether the membership has changed since the last sort */
+	if (compare != monster_list_standard_compare ||
+			list->order_compare != compare || list->order_count != elements) {
+		same = false;
+	}
+	for (i = 0; i < elements; i++) {
+		if (list->order_race[i] != list->entries[i].race ||
+				list->order_p_race[i] != list->entries[i].p_race) {
+			same = false;
+			list->order_race[i] = list->entries[i].race;
+			list->order_p_race[i] = list->entries[i].p_race;
+		}
+	}
+
+	if (!same) {
+		/* Sort the collected positions, so each sorted entry's position
+		 * is remembered */
+		for (i = 0; i < elements; i++) {
+			list->order[i] = i;
+		}
+		order_entries = list->entries;
+		order_compare = compare;
+		sort(list->order, elements, sizeof(list->order[0]),
+			monster_list_order_compare);
+		order_entries = NULL;
+		order_compare = NULL;
+		list->order_count = elements;
+		list->order_compare = compare;
+	}
+
+	/* Put the entries in order */
+	old = mem_alloc(elements * sizeof(monster_list_entry_t));
+	memcpy(old, list->entries, elements * sizeof(monster_list_entry_t));
+	for (i = 0; i < elements; i++) {
+		list->entries[i] = old[list->order[i]];
+	}
+	mem_free(old);
+
 	list->sorted = true;
 }
 
@@ -21,6 +21,7 @@
 #define MONSTER_LIST_H
 
 #include "angband.h"
+#include "project.h"
 
 typedef enum monster_list_section_e {
 	MONSTER_LIST_SECTION_LOS = 0,
@@ -46,6 +47,20 @@ typedef struct monster_list_s {
 	bool sorted;
 	u16b total_entries[MONSTER_LIST_SECTION_MAX];
 	u16b total_monsters[MONSTER_LIST_SECTION_MAX];
+
+	/* Hash of (race, player race) to entry index + 1; 0 is an empty bucket */
+	u16b *buckets;
+	size_t buckets_size;
+
+	/* Line of sight to each monster slot, remembered between collections */
+	struct projectable_memo *los;
+
+	/* The races in collection order, and how they were last sorted */
+	struct monster_race **order_race;
+	struct player_race **order_p_race;
+	u16b *order;
+	u16b order_count;
+	int (*order_compare)(const void *, const void *);
 } monster_list_t;
 
 monster_list_t *monster_list_new(void);
@@ -881,6 +881,22 @@ bool prepare_ghost(struct chunk *c, int r_idx, struct monster *mon,
  * ------------------------------------------------------------------------
  * Deleting of monsters and monster list handling
  * ------------------------------------------------------------------------ */
+/**
+ * Free a monster slot's heatmaps and clear the rest of its rarely used parts
+ */
+static void monster_cold_wipe(struct chunk *c, int m_idx)
+{
+	struct monster_cold *cold = cave_monster_cold(c, m_idx);
+
+	if (cold->noise.grids) {
+		heatmap_free(c, cold->noise);
+	}
+	if (cold->scent.grids) {
+		heatmap_free(c, cold->scent);
+	}
+	memset(cold, 0, sizeof(*cold));
+}
+
 /**
  * Deletes a monster by index.
  *
@@ -926,13 +942,8 @@ void delete_monster_idx(int m_idx)
 	monster_remove_from_groups(cave, mon);
 	monster_remove_from_targets(cave, mon);
 
-	/* Free any heatmaps */
-	if (mon->noise.grids) {
-		heatmap_free(cave, mon->noise);
-	}
-	if (mon->scent.grids) {
-		heatmap_free(cave, mon->scent);
-	}
+	/* Free any heatmaps and forget what the monster knew */
+	monster_cold_wipe(cave, m_idx);
 
 	/* Delete objects */
 	struct object *obj = mon->held_obj;
@@ -1061,9 +1072,13 @@ void monster_index_move(int i1, int i2)
 	memcpy(cave_monster(cave, i2),
 			cave_monster(cave, i1),
 			sizeof(struct monster));
+	memcpy(cave_monster_cold(cave, i2),
+			cave_monster_cold(cave, i1),
+			sizeof(struct monster_cold));
 
 	/* Wipe hole */
 	memset(cave_monster(cave, i1), 0, sizeof(struct monster));
+	memset(cave_monster_cold(cave, i1), 0, sizeof(struct monster_cold));
 }
 
 
@@ -1224,6 +1239,7 @@ void wipe_mon_list(struct chunk *c, struct player *p)
 		}
 
 		/* Wipe the Monster */
+		monster_cold_wipe(c, m_idx);
 		memset(mon, 0, sizeof(struct monster));
 	}
 
@@ -1427,7 +1443,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon, byte origin)
 				}
 
 				/* Allocate by hand, prep, apply magic */
-				obj = mem_zalloc(sizeof(*obj));
+				obj = object_new();
 				object_prep(obj, kind, 100, RANDOMISE);
 				obj->artifact = art;
 				copy_artifact_data(obj, obj->artifact);
@@ -1445,8 +1461,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon, byte origin)
 					any = true;
 				} else {
 					mark_artifact_created(obj->artifact, false);
-					object_wipe(obj);
-					mem_free(obj);
+					object_free(obj);
 				}
 				arts = arts->next;
 			}
@@ -1461,7 +1476,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon, byte origin)
 		/* Specified by tval or by kind */
 		if (drop->kind) {
 			/* Allocate by hand, prep, apply magic */
-			obj = mem_zalloc(sizeof(*obj));
+			obj = object_new();
 			object_prep(obj, drop->kind, level, RANDOMISE);
 			apply_magic(obj, level, true, good, great, extra_roll);
 		} else {
@@ -1486,8 +1501,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon, byte origin)
 		if (monster_carry(c, mon, obj)) {
 			any = true;
 		} else {
-			object_wipe(obj);
-			mem_free(obj);
+			object_free(obj);
 		}
 	}
 
@@ -1513,8 +1527,7 @@ static bool mon_create_drop(struct chunk *c, struct monster *mon, byte origin)
 			if (obj->artifact) {
 				mark_artifact_created(obj->artifact, false);
 			}
-			object_wipe(obj);
-			mem_free(obj);
+			object_free(obj);
 		}
 	}
 
@@ -1708,6 +1721,7 @@ s16b place_monster(struct chunk *c, struct loc grid, struct monster *mon,
 	} else {
 		m_idx = mon_pop(c);
 		if (!m_idx) return 0;
+		monster_cold_wipe(c, m_idx);
 	}
 
 	/* Copy the monster */
@@ -49,6 +49,7 @@
 #include "player-util.h"
 #include "project.h"
 #include "trap.h"
+#include "z-profile.h"
 
 
 /**
@@ -112,7 +113,7 @@ static bool monster_can_hear(struct monster *mon)
 		noise_map = cave->noise;
 		hearing -= player->state.skills[SKILL_STEALTH] / 3;
 	} else if (mon->target.midx > 0) {
-		noise_map = cave_monster(cave, mon->target.midx)->noise;
+		noise_map = cave_monster_cold(cave, mon->target.midx)->noise;
 	} else {
 		return false;
 	}
@@ -135,7 +136,7 @@ static bool monster_can_smell(struct monster *mon)
 	if (mon->target.midx == -1) {
 		scent_map = cave->scent;
 	} else if (mon->target.midx > 0) {
-		scent_map = cave_monster(cave, mon->target.midx)->scent;
+		scent_map = cave_monster_cold(cave, mon->target.midx)->scent;
 	} else {
 		return false;
 	}
@@ -460,7 +461,7 @@ static bool get_move_advance(struct monster *mon, bool *track)
 		hearing -= player->state.skills[SKILL_STEALTH] / 3;
 	} else if (mon->target.midx > 0) {
 		/* Monster */
-		noise_map = cave_monster(cave, mon->target.midx)->noise;
+		noise_map = cave_monster_cold(cave, mon->target.midx)->noise;
 	} else {
 		/* Location */
 		best_grid = target;
@@ -572,6 +573,121 @@ static struct loc get_move_random(struct monster *mon)
 	return loc(0, 0);
 }
 
+/**
+ * Shared maps for fleeing and hiding monsters.
+ *
+ * Each map holds, for every grid, how many steps (ignoring walls) it is to
+ * the nearest grid out of the player's view that a monster could run to or
+ * hide in.  A grid that far away is at least that far in the monster's
+ * search rings too, so a search can start at that ring, or give up if it is
+ * past the last one, and still pick exactly the grid a full search would.
+ *
+ * The maps only depend on terrain and the player's view, so they are made
+ * when first wanted after either changes and then shared by every monster.
+ */
+static byte *safety_map;
+static byte *hiding_map;
+static int flee_map_hgt, flee_map_wid;
+static u32b flee_map_terrain_stamp, flee_map_view_stamp;
+
+bool flee_maps_verify = false;
+struct flee_map_stats flee_map_stats;
+
+/**
+ * A grid a fleeing monster might choose; see get_move_find_safety()
+ */
+static bool square_isrefuge(struct chunk *c, struct loc grid)
+{
+	return square_in_bounds_fully(c, grid) && square_ispassable(c, grid) &&
+		!square_isview(c, grid);
+}
+
+/**
+ * A grid a pack monster might hide in; see get_move_find_hiding()
+ */
+static bool square_ishideout(struct chunk *c, struct loc grid)
+{
+	return square_in_bounds_fully(c, grid) && square_isfloor(c, grid) &&
+		!square_isview(c, grid);
+}
+
+/**
+ * Fill a map with the distance of each grid from the nearest grid passing
+ * the test, in two sweeps over the level
+ */
+static void flee_map_fill(struct chunk *c, byte *map,
+						  bool (*test)(struct chunk *c, struct loc grid))
+{
+	int x, y, w = c->width, h = c->height;
+
+	for (y = 0; y < h; y++)
+		for (x = 0; x < w; x++)
+			map[y * w + x] = test(c, loc(x, y)) ? 0 : 255;
+
+	/* Down and right, taking the best of the grids already done */
+	for (y = 0; y < h; y++) {
+		for (x = 0; x < w; x++) {
+			byte *d = &map[y * w + x];
+			if (!*d) continue;
+			if (x > 0) *d = MIN(*d, map[y * w + x - 1] + 1);
+			if (y > 0) {
+				const byte *up = &map[(y - 1) * w + x];
+				*d = MIN(*d, up[0] + 1);
+				if (x > 0) *d = MIN(*d, up[-1] + 1);
+				if (x < w - 1) *d = MIN(*d, up[1] + 1);
+			}
+		}
+	}
+
+	/* Then back up and left */
+	for (y = h - 1; y >= 0; y--) {
+		for (x = w - 1; x >= 0; x--) {
+			byte *d = &map[y * w + x];
+			if (!*d) continue;
+			if (x < w - 1) *d = MIN(*d, map[y * w + x + 1] + 1);
+			if (y < h - 1) {
+				const byte *down = &map[(y + 1) * w + x];
+				*d = MIN(*d, down[0] + 1);
+				if (x > 0) *d = MIN(*d, down[-1] + 1);
+				if (x < w - 1) *d = MIN(*d, down[1] + 1);
+			}
+		}
+	}
+}
+
+/**
+ * Bring the shared maps up to date with the current level and view
+ */
+static void flee_maps_update(void)
+{
+	if (safety_map && flee_map_terrain_stamp == cave->terrain_stamp &&
+		flee_map_view_stamp == cave->view_stamp &&
+		flee_map_hgt == cave->height && flee_map_wid == cave->width)
+		return;
+
+	if (flee_map_hgt * flee_map_wid != cave->height * cave->width) {
+		mem_free(safety_map);
+		mem_free(hiding_map);
+		safety_map = mem_alloc(cave->height * cave->width);
+		hiding_map = mem_alloc(cave->height * cave->width);
+	}
+	flee_map_hgt = cave->height;
+	flee_map_wid = cave->width;
+	flee_map_terrain_stamp = cave->terrain_stamp;
+	flee_map_view_stamp = cave->view_stamp;
+	flee_map_fill(cave, safety_map, square_isrefuge);
+	flee_map_fill(cave, hiding_map, square_ishideout);
+	flee_map_stats.updates++;
+}
+
+/**
+ * Get the first search ring which could hold a grid from the map
+ */
+static int flee_map_first_ring(const byte *map, struct loc grid)
+{
+	return MAX(1, map[grid.y * flee_map_wid + grid.x]);
+}
+
 /**
  * Choose a "safe" location near a monster for it to run toward.
  *
@@ -580,14 +696,14 @@ static struct loc get_move_random(struct monster *mon)
  * cause monsters to "duck" behind walls.  Hopefully, monsters will also
  * try to run towards corridor openings if they are in a room.
  *
- * This function may take lots of CPU time if lots of monsters are fleeing.
+ * The search looks at rings from first out to distance 9 from the monster.
  *
  * Note that it is assumed that the player is the main source of danger to the
  * monster, even if it has another monster or grid as a target.
  *
  * Return true if a safe location is available.
  */
-static bool get_move_find_safety(struct monster *mon)
+static bool find_safety(struct monster *mon, int first, struct loc *safe)
 {
 	int i, dy, dx, d, dis, gdis = 0;
 
@@ -595,7 +711,7 @@ static bool get_move_find_safety(struct monster *mon)
 	const int *x_offsets;
 
 	/* Start with adjacent locations, spread further */
-	for (d = 1; d < 10; d++) {
+	for (d = first; d < 10; d++) {
 		struct loc best = loc(0, 0);
 
 		/* Get the lists of points with a distance d from (fx, fy) */
@@ -638,7 +754,7 @@ static bool get_move_find_safety(struct monster *mon)
 		/* Check for success */
 		if (gdis > 0) {
 			/* Good location */
-			mon->target.grid = best;
+			*safe = best;
 			return (true);
 		}
 	}
@@ -653,9 +769,11 @@ static bool get_move_find_safety(struct monster *mon)
  * Pack monsters will use this to "ambush" the target and lure it out
  * of corridors into open space so they can swarm it.
  *
+ * The search looks at rings from first out to distance 9 from the monster.
+ *
  * Return true if a good location is available.
  */
-static bool get_move_find_hiding(struct monster *mon)
+static bool find_hiding(struct monster *mon, int first, struct loc *hide)
 {
 	struct loc target = monster_target_loc(mon);
 	int i, dy, dx, d, dis, gdis = 999, min;
@@ -665,7 +783,7 @@ static bool get_move_find_hiding(struct monster *mon)
 	min = distance(target, mon->grid) * 3 / 4 + 2;
 
 	/* Start with adjacent locations, spread further */
-	for (d = 1; d < 10; d++) {
+	for (d = first; d < 10; d++) {
 		struct loc best = loc(0, 0);
 
 		/* Get the lists of points with a distance d from monster */
@@ -701,7 +819,7 @@ static bool get_move_find_hiding(struct monster *mon)
 		/* Check for success */
 		if (gdis < 999) {
 			/* Good location */
-			mon->target.grid = best;
+			*hide = best;
 			return (true);
 		}
 	}
@@ -710,6 +828,66 @@ static bool get_move_find_hiding(struct monster *mon)
 	return (false);
 }
 
+/**
+ * Check a search which used the shared maps against a full one
+ */
+static void flee_map_check(bool found, struct loc grid, bool full_found,
+						   struct loc full_grid)
+{
+	if (found != full_found || (found && !loc_eq(grid, full_grid)))
+		flee_map_stats.mismatches++;
+}
+
+/**
+ * Choose a "safe" location near a monster for it to run toward, starting
+ * the search where the safety map says one could first be found
+ */
+static bool get_move_find_safety(struct monster *mon)
+{
+	struct loc safe = loc(0, 0);
+	int first;
+	bool found = false;
+
+	flee_maps_update();
+	first = flee_map_first_ring(safety_map, mon->grid);
+	flee_map_stats.searches++;
+	flee_map_stats.rings_skipped += MIN(first, 10) - 1;
+	if (first < 10) found = find_safety(mon, first, &safe);
+
+	if (flee_maps_verify) {
+		struct loc full = loc(0, 0);
+		flee_map_check(found, safe, find_safety(mon, 1, &full), full);
+	}
+
+	if (found) mon->target.grid = safe;
+	return found;
+}
+
+/**
+ * Choose a good hiding place near a monster for it to run toward, starting
+ * the search where the hiding map says one could first be found
+ */
+static bool get_move_find_hiding(struct monster *mon)
+{
+	struct loc hide = loc(0, 0);
+	int first;
+	bool found = false;
+
+	flee_maps_update();
+	first = flee_map_first_ring(hiding_map, mon->grid);
+	flee_map_stats.searches++;
+	flee_map_stats.rings_skipped += MIN(first, 10) - 1;
+	if (first < 10) found = find_hiding(mon, first, &hide);
+
+	if (flee_maps_verify) {
+		struct loc full = loc(0, 0);
+		flee_map_check(found, hide, find_hiding(mon, 1, &full), full);
+	}
+
+	if (found) mon->target.grid = hide;
+	return found;
+}
+
 /**
  * Provide a location to flee to, but give the player a wide berth.
  *
@@ -2085,6 +2263,8 @@ void process_monsters(int minimum_energy)
 	/* Only process some things every so often */
 	bool regen = false;
 
+	PROFILE_BEGIN(PROCESS_MONSTERS);
+
 	/* Regenerate hitpoints and mana every 100 game turns */
 	if (turn % 100 == 0)
 		regen = true;
@@ -2160,6 +2340,8 @@ void process_monsters(int minimum_energy)
 	/* Update monster visibility after this */
 	/* XXX This may not be necessary */
 	player->upkeep->update |= PU_MONSTERS;
+
+	PROFILE_END(PROCESS_MONSTERS);
 }
 
 /**
@@ -2217,3 +2399,22 @@ void restore_monsters(void)
 		}
 	}
 }
+
+/**
+ * Free the shared maps for fleeing and hiding monsters
+ */
+static void cleanup_mon_move(void)
+{
+	mem_free(safety_map);
+	safety_map = NULL;
+	mem_free(hiding_map);
+	hiding_map = NULL;
+	flee_map_hgt = 0;
+	flee_map_wid = 0;
+}
+
+struct init_module mon_move_module = {
+	.name = "monster/mon-move",
+	.init = NULL,
+	.cleanup = cleanup_mon_move
+};
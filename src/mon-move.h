@@ -25,6 +25,19 @@ enum monster_stagger {
 	 INNATE_STAGGER = 2
 };
 
+/**
+ * Counts kept by the shared maps for fleeing and hiding monsters
+ */
+struct flee_map_stats {
+	long updates;		/* Times the maps were remade */
+	long searches;		/* Searches for a place to flee to or hide in */
+	long rings_skipped;	/* Search rings the maps showed to be empty */
+	long mismatches;	/* Verified searches the maps got wrong */
+};
+
+extern bool flee_maps_verify;
+extern struct flee_map_stats flee_map_stats;
+
 bool multiply_monster(const struct monster *mon);
 void process_monsters(int minimum_energy);
 void reset_monsters(void);
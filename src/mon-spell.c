@@ -185,13 +185,8 @@ static void spell_message(struct monster *mon,
 
 const struct monster_spell *monster_spell_by_index(int index)
 {
-	const struct monster_spell *spell = monster_spells;
-	while (spell) {
-		if (spell->index == index)
-			break;
-		spell = spell->next;
-	}
-	return spell;
+	if (index <= RSF_NONE || index >= RSF_MAX) return NULL;
+	return monster_spells_by_index[index];
 }
 
 /**
@@ -313,6 +308,44 @@ static const struct mon_spell_info {
     #undef RSF
 };
 
+/**
+ * The spells of each type, one mask for each bit of the type bitflag, so
+ * that picking out spells by type is a few flag operations rather than a
+ * look through the whole spell list
+ */
+#define RST_BITS 13
+static bitflag spell_type_masks[RST_BITS][RSF_SIZE];
+
+/* Refuse to compile if a type has been added without updating RST_BITS */
+typedef char rst_bits_cover_types[((1 << RST_BITS) == RST_MAX) ? 1 : -1];
+static bool spell_type_masks_ready = false;
+
+/**
+ * Fill f with every spell having any of the given types
+ */
+static void spell_type_mask(bitflag *f, int types)
+{
+	int bit;
+
+	if (!spell_type_masks_ready) {
+		const struct mon_spell_info *info;
+
+		for (info = mon_spell_types; info->index < RSF_MAX; info++) {
+			for (bit = 0; bit < RST_BITS; bit++) {
+				if (info->type & (1 << bit)) {
+					rsf_on(spell_type_masks[bit], info->index);
+				}
+			}
+		}
+		spell_type_masks_ready = true;
+	}
+
+	rsf_wipe(f);
+	for (bit = 0; bit < RST_BITS; bit++) {
+		if (types & (1 << bit)) rsf_union(f, spell_type_masks[bit]);
+	}
+}
+
 
 static bool mon_spell_is_valid(int index)
 {
@@ -343,13 +376,10 @@ bool mon_spell_is_innate(int index)
  */
 bool test_spells(bitflag *f, int types)
 {
-	const struct mon_spell_info *info;
+	bitflag mask[RSF_SIZE];
 
-	for (info = mon_spell_types; info->index < RSF_MAX; info++)
-		if (rsf_has(f, info->index) && (info->type & types))
-			return true;
-
-	return false;
+	spell_type_mask(mask, types);
+	return rsf_is_inter(f, mask);
 }
 
 /**
@@ -360,11 +390,10 @@ bool test_spells(bitflag *f, int types)
  */
 void ignore_spells(bitflag *f, int types)
 {
-	const struct mon_spell_info *info;
+	bitflag mask[RSF_SIZE];
 
-	for (info = mon_spell_types; info->index < RSF_MAX; info++)
-		if (rsf_has(f, info->index) && (info->type & types))
-			rsf_off(f, info->index);
+	spell_type_mask(mask, types);
+	rsf_diff(f, mask);
 }
 
 /**
@@ -385,16 +414,19 @@ void unset_spells(bitflag *spells, bitflag *flags, bitflag *pflags,
 	int lowest_resist = RES_LEVEL_BASE;
 	bitflag backup[RSF_SIZE];
 	int restore_chance = 0;
+	int i;
 
 	rsf_wipe(backup);
 
-	for (info = mon_spell_types; info->index < RSF_MAX; info++) {
-		const struct monster_spell *spell = monster_spell_by_index(info->index);
+	/* Only the spells still in the set need looking at */
+	for (i = rsf_next(spells, FLAG_START); i != FLAG_END;
+		 i = rsf_next(spells, i + 1)) {
+		const struct monster_spell *spell = monster_spell_by_index(i);
 		const struct effect *effect;
 
 		/* Ignore missing spells */
 		if (!spell) continue;
-		if (!rsf_has(spells, info->index)) continue;
+		info = &mon_spell_types[i];
 
 		/* Get the effect */
 		effect = spell->effect;
@@ -439,15 +471,12 @@ void unset_spells(bitflag *spells, bitflag *flags, bitflag *pflags,
 	/* Smart monsters re-assess dropped elemental spells */
 	restore_chance = 1 + rsf_count(spells);
 	if (smart && one_in_(restore_chance)) {
-		for (info = mon_spell_types; info->index < RSF_MAX; info++) {
-			const struct monster_spell *spell =
-				monster_spell_by_index(info->index);
-			int element;
-			if (!spell) continue;
-			if (!rsf_has(backup, info->index)) continue;
-			element = spell->effect->subtype;
+		for (i = rsf_next(backup, FLAG_START); i != FLAG_END;
+			 i = rsf_next(backup, i + 1)) {
+			const struct monster_spell *spell = monster_spell_by_index(i);
+			int element = spell->effect->subtype;
 			if (RES_LEVEL_BASE - el[element].res_level == lowest_resist) {
-				rsf_on(spells, info->index);
+				rsf_on(spells, i);
 			}
 		}
 	}
@@ -549,26 +578,19 @@ static int mon_spell_dam(int index, int hp, const struct monster_race *race,
  */
 void create_mon_spell_mask(bitflag *f, ...)
 {
-	const struct mon_spell_info *rs;
-	int i;
+	int i, types = RST_NONE;
 	va_list args;
 
-	rsf_wipe(f);
-
 	va_start(args, f);
 
-	/* Process each type in the va_args */
+	/* Gather each type in the va_args */
     for (i = va_arg(args, int); i != RST_NONE; i = va_arg(args, int)) {
-		for (rs = mon_spell_types; rs->index < RSF_MAX; rs++) {
-			if (rs->type & i) {
-				rsf_on(f, rs->index);
-			}
-		}
+		types |= i;
 	}
 
 	va_end(args);
 
-	return;
+	spell_type_mask(f, types);
 }
 
 const char *mon_spell_lore_description(int index,
@@ -41,7 +41,8 @@ enum mon_spell_type {
 	RST_ESCAPE		= 0x0200,
 	RST_SUMMON		= 0x0400,
 	RST_INNATE		= 0x0800,
-	RST_ARCHERY		= 0x1000
+	RST_ARCHERY		= 0x1000,
+	RST_MAX			= 0x2000	/* The next bit up from the last type */
 };
 
 #define RST_DAMAGE (RST_BOLT | RST_BALL | RST_BREATH | RST_DIRECT)
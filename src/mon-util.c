@@ -46,6 +46,7 @@
 #include "player-util.h"
 #include "project.h"
 #include "trap.h"
+#include "z-profile.h"
 #include "z-set.h"
 
 /**
@@ -248,6 +249,49 @@ static void path_analyse(struct chunk *c, struct loc grid)
 	}
 }
 
+/**
+ * Update a monster's distance to its target and any heatmaps it makes, and
+ * forget its target if that has died.
+ */
+static void update_mon_target(struct monster *mon, struct chunk *c, bool full)
+{
+	if (full) {
+		/* Target */
+		struct loc target = monster_target_loc(mon);
+
+		/* Distance components */
+		int dy = ABS(target.y - mon->grid.y);
+		int dx = ABS(target.x - mon->grid.x);
+
+		/* Approximate distance */
+		int d = (dy > dx) ? (dy + (dx >>  1)) : (dx + (dy >> 1));
+
+		/* Restrict distance */
+		if (d > 255) d = 255;
+
+		/* Save the distance */
+		mon->cdis = d;
+
+		/* Heatmaps */
+		if (cave_monster_cold(c, mon->midx)->noise.grids) {
+			make_noise(c, NULL, mon);
+		}
+		if (cave_monster_cold(c, mon->midx)->scent.grids) {
+			update_scent(c, NULL, mon);
+		}
+	}
+
+	/* Remove any dead monster targets (then what happens? - NRM)*/
+	if ((mon->target.midx > 0) && !cave_monster(c, mon->target.midx)) {
+		mon->target.midx = 0;
+	}
+}
+
+/**
+ * Number of monsters update_monsters() takes at a time
+ */
+#define UPDATE_BATCH 64
+
 /**
  * This function updates the monster record of the given monster
  *
@@ -339,31 +383,7 @@ void update_mon(struct player *p, struct monster *mon, struct chunk *c,
 	lore = get_lore(mon->race);
 	
 	/* Compute distance, or just use the current one; update any heatmaps */
-	if (full) {
-		/* Target */
-		struct loc target = monster_target_loc(mon);
-
-		/* Distance components */
-		dy = ABS(target.y - mon->grid.y);
-		dx = ABS(target.x - mon->grid.x);
-
-		/* Approximate distance */
-		d = (dy > dx) ? (dy + (dx >>  1)) : (dx + (dy >> 1));
-
-		/* Restrict distance */
-		if (d > 255) d = 255;
-
-		/* Save the distance */
-		mon->cdis = d;
-
-		/* Heatmaps */
-		if (mon->noise.grids) {
-			make_noise(c, NULL, mon);
-		}
-		if (mon->scent.grids) {
-			update_scent(c, NULL, mon);
-		}
-	}
+	update_mon_target(mon, c, full);
 
 	/* Get the actual distance from the player (mon->cdis is now
 	 * the distance from the monster to its target) */
@@ -371,11 +391,6 @@ void update_mon(struct player *p, struct monster *mon, struct chunk *c,
 	dx = ABS(player->grid.x - mon->grid.x);
 	d = (dy > dx) ? (dy + (dx >>  1)) : (dx + (dy >> 1));
 
-	/* Remove any dead monster targets (then what happens? - NRM)*/
-	if ((mon->target.midx > 0) && !cave_monster(c, mon->target.midx)) {
-		mon->target.midx = 0;
-	}
-
 	/* Detected */
 	if (mflag_has(mon->mflag, MFLAG_MARK)) flag = true;
 
@@ -518,19 +533,55 @@ void update_mon(struct player *p, struct monster *mon, struct chunk *c,
 
 /**
  * Updates all the (non-dead) monsters via update_mon().
+ *
+ * Monsters are taken a batch at a time, and the distances to the player for
+ * the whole batch are worked out together first.  A monster too far away
+ * to be seen or sensed which is not detected, and wasn't visible before,
+ * can't change its visibility, so it skips the rest of update_mon().
  */
 void update_monsters(struct player *p, bool full)
 {
-	int i;
+	int i, max = cave_monster_max(cave);
+	int range = player->themed_level ? z_info->max_sight / 2 :
+		z_info->max_sight;
 
-	/* Update each (live) monster */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		struct monster *mon = cave_monster(cave, i);
+	PROFILE_BEGIN(UPDATE_MONSTERS);
+	for (i = 1; i < max; i += UPDATE_BATCH) {
+		int n = MIN(UPDATE_BATCH, max - i), j;
+		int dy[UPDATE_BATCH], dx[UPDATE_BATCH], d[UPDATE_BATCH];
+
+		/* Gather the offsets from the player */
+		for (j = 0; j < n; j++) {
+			struct monster *mon = cave_monster(cave, i + j);
+
+			dy[j] = mon->grid.y - player->grid.y;
+			dx[j] = mon->grid.x - player->grid.x;
+		}
+
+		/* Approximate distances, as in update_mon() */
+		for (j = 0; j < n; j++) {
+			int ady = ABS(dy[j]), adx = ABS(dx[j]);
+
+			d[j] = (ady > adx) ? (ady + (adx >> 1)) : (adx + (ady >> 1));
+		}
+
+		/* Update each (live) monster */
+		for (j = 0; j < n; j++) {
+			struct monster *mon = cave_monster(cave, i + j);
+
+			if (!mon->race) continue;
+
+			/* Out of range and nothing to change */
+			if ((d[j] > range) && !mflag_has(mon->mflag, MFLAG_MARK) &&
+				!monster_is_visible(mon) && !monster_is_in_view(mon)) {
+				update_mon_target(mon, cave, full);
+				continue;
+			}
 
-		/* Update the monster if alive */
-		if (mon->race)
 			update_mon(p, mon, cave, full);
+		}
 	}
+	PROFILE_END(UPDATE_MONSTERS);
 }
 
 
@@ -835,6 +886,7 @@ void update_smart_learn(struct monster *mon, struct player *p, int flag,
 						int pflag, int element)
 {
 	bool element_ok = ((element >= 0) && (element < ELEM_MAX));
+	struct monster_cold *cold = cave_monster_cold(cave, mon->midx);
 
 	/* Sanity check */
 	if (!flag && !element_ok) return;
@@ -856,27 +908,30 @@ void update_smart_learn(struct monster *mon, struct player *p, int flag,
 	if (one_in_(100))
 		return;
 
+	/* Only monsters on the level can remember anything */
+	if (!cold) return;
+
 	/* Learn the flag */
 	if (flag) {
 		if (player_of_has(p, flag)) {
-			of_on(mon->known_pstate.flags, flag);
+			of_on(cold->known_pstate.flags, flag);
 		} else {
-			of_off(mon->known_pstate.flags, flag);
+			of_off(cold->known_pstate.flags, flag);
 		}
 	}
 
 	/* Learn the pflag */
 	if (pflag) {
 		if (pf_has(p->state.pflags, pflag)) {
-			of_on(mon->known_pstate.pflags, pflag);
+			of_on(cold->known_pstate.pflags, pflag);
 		} else {
-			of_off(mon->known_pstate.pflags, pflag);
+			of_off(cold->known_pstate.pflags, pflag);
 		}
 	}
 
 	/* Learn the element */
 	if (element_ok)
-		mon->known_pstate.el_info[element].res_level
+		cold->known_pstate.el_info[element].res_level
 			= p->state.el_info[element].res_level;
 }
 
@@ -1826,11 +1881,13 @@ struct loc monster_target_loc(const struct monster *mon)
  */
 void monster_make_heatmaps(struct chunk *c, struct monster *mon)
 {
-	if (!mon->noise.grids) {
-		mon->noise.grids = heatmap_new(c);
+	struct monster_cold *cold = cave_monster_cold(c, mon->midx);
+
+	if (!cold->noise.grids) {
+		cold->noise.grids = heatmap_new(c);
 	}
-	if (!mon->scent.grids) {
-		mon->scent.grids = heatmap_new(c);
+	if (!cold->scent.grids) {
+		cold->scent.grids = heatmap_new(c);
 	}
 }
 
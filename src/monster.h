@@ -432,23 +432,32 @@ struct monster {
 
 	byte attr;  						/* attr last used for drawing monster */
 
-	struct player_state known_pstate;	/* Known player state */
-
     struct target target;				/* Monster target */
 	struct loc home;					/* Home for territorial monsters */
 
 	struct monster_group_info group_info[GROUP_MAX];/* Monster group details */
-	struct heatmap noise;				/* Monster noise heatmap */
-	struct heatmap scent;				/* Monster scent heatmap */
 
     byte min_range;						/* What is the closest we want to be? */
     byte best_range;					/* How close do we want to be? */
 };
 
+/**
+ * The bulky parts of a monster that are only needed now and then, kept in a
+ * separate array parallel to the chunk's monsters so that the loops over
+ * every monster each turn don't drag them through the cache.  Reached with
+ * cave_monster_cold().
+ */
+struct monster_cold {
+	struct player_state known_pstate;	/* Known player state */
+	struct heatmap noise;				/* Monster noise heatmap */
+	struct heatmap scent;				/* Monster scent heatmap */
+};
+
 /** Variables **/
 
 extern struct monster_pain *pain_messages;
 extern struct monster_spell *monster_spells;
+extern struct monster_spell *monster_spells_by_index[RSF_MAX];
 extern struct ghost *ghosts;
 extern struct monster_base *rb_info;
 extern struct monster_race *r_info;
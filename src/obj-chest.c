@@ -646,6 +646,7 @@ bool do_cmd_open_chest(struct loc grid, struct object *obj)
 		obj->known->notice |= OBJ_NOTICE_IGNORE;
 
 	/* Redraw chest, to be on the safe side (it may have been ignored) */
+	map_render_forget(player->cave, grid);
 	square_light_spot(cave, grid);
 
 	/* Result */
@@ -56,7 +56,7 @@ void copy_curses(struct object *obj, int *source)
 	if (!source) return;
 
 	if (!obj->curses) {
-		obj->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+		obj->curses = object_new_curses();
 	}
 
 	for (i = 0; i < z_info->curse_max; i++) {
@@ -146,7 +146,7 @@ bool append_object_curse(struct object *obj, int pick, int power)
 	int i;
 
 	if (!obj->curses)
-		obj->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+		obj->curses = object_new_curses();
 
 	/* Reject conflicting curses */
 	for (i = 1; i < z_info->curse_max; i++) {
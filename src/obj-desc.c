@@ -579,6 +579,137 @@ static size_t obj_desc_aware(const struct object *obj, char *buf, size_t max,
 }
 
 
+/**
+ * ------------------------------------------------------------------------
+ * Description cache
+ *
+ * Menus and subwindows describe every object they show on every redraw, and
+ * the names rarely change in between.  Finished descriptions are kept with
+ * everything about the object they were made from; anything they depend on
+ * which isn't kept (what the player knows of runes and object properties,
+ * what is ignored) moves the generation on, which throws them all away.
+ * ------------------------------------------------------------------------ */
+#define DESC_CACHE_SETS 128
+#define DESC_CACHE_WAYS 4
+#define DESC_CACHE_LEN 120
+
+struct desc_key {
+	const struct object *obj;
+	const struct player *p;
+	u32b generation;
+	int mode;
+	const struct object_kind *kind;
+	const struct object_kind *known_kind;
+	const struct ego_item *known_ego;
+	const struct artifact *known_artifact;
+	quark_t note;
+	s16b pval;
+	s16b timeout;
+	s16b known_pval;
+	s16b ac;
+	s16b to_a;
+	s16b to_h;
+	s16b to_d;
+	s16b modifiers[OBJ_MOD_MAX];
+	byte number;
+	byte dd;
+	byte ds;
+	bitflag notice;
+	bool aware;
+	bool tried;
+	bool cursed;
+	bool back;
+	bool flavors;
+	bool unignoring;
+};
+
+struct desc_entry {
+	struct desc_key key;
+	size_t len;
+	char text[DESC_CACHE_LEN];
+};
+
+static struct desc_entry desc_cache[DESC_CACHE_SETS][DESC_CACHE_WAYS];
+static int desc_cache_next[DESC_CACHE_SETS];
+static u32b desc_generation = 1;
+
+struct object_desc_stats object_desc_stats;
+
+/**
+ * Throw away every cached description, because something they all depend on
+ * (such as the player's knowledge of runes, or what is ignored) has changed.
+ */
+void object_desc_forget_all(void)
+{
+	/* Zero marks an empty entry */
+	if (++desc_generation == 0) ++desc_generation;
+}
+
+/**
+ * Find the set of cache entries an object's descriptions go in
+ */
+static int desc_cache_set(const struct object *obj)
+{
+	uintptr_t h = (uintptr_t) obj;
+
+	h ^= h >> 7;
+	h ^= h >> 13;
+	return h % DESC_CACHE_SETS;
+}
+
+/**
+ * Throw away the cached descriptions of an object that is going away, so that
+ * another object made in the same place can't be taken for it.
+ */
+void object_desc_forget(const struct object *obj)
+{
+	struct desc_entry *set = desc_cache[desc_cache_set(obj)];
+	int i;
+
+	for (i = 0; i < DESC_CACHE_WAYS; i++)
+		if (set[i].key.obj == obj) set[i].key.generation = 0;
+}
+
+/**
+ * Gather everything a description of an object depends on
+ */
+static void desc_key_make(struct desc_key *key, const struct object *obj,
+		int mode, const struct player *p)
+{
+	const struct object *known = obj->known;
+
+	/* Clear the padding too, as keys are compared a byte at a time */
+	memset(key, 0, sizeof(*key));
+	key->obj = obj;
+	key->p = p;
+	key->generation = desc_generation;
+	key->mode = mode;
+	key->kind = obj->kind;
+	key->known_kind = known->kind;
+	key->known_ego = known->ego;
+	key->known_artifact = known->artifact;
+	key->note = obj->note;
+	key->pval = obj->pval;
+	key->timeout = obj->timeout;
+	key->known_pval = known->pval;
+	key->ac = known->ac;
+	key->to_a = known->to_a;
+	key->to_h = known->to_h;
+	key->to_d = known->to_d;
+	memcpy(key->modifiers, known->modifiers, sizeof(key->modifiers));
+	key->number = obj->number;
+	key->dd = known->dd;
+	key->ds = known->ds;
+	key->notice = known->notice;
+	key->aware = obj->kind->aware;
+	key->tried = obj->kind->tried;
+	key->cursed = known->curses ? true : false;
+	key->back = (mode & ODESC_COMBAT) && player->state.shield_on_back &&
+		(obj == slot_object(player, slot_by_name(player, "arm")));
+	key->flavors = p && OPT(p, show_flavors);
+	key->unignoring = p && p->unignoring;
+}
+
 /**
  * Describes item `obj` into buffer `buf` of size `max`.
  *
@@ -607,6 +738,8 @@ size_t object_desc(char *buf, size_t max, const struct object *obj, int mode,
 	bool terse = mode & ODESC_TERSE ? true : false;
 
 	size_t end = 0;
+	struct desc_key key;
+	int n, i;
 
 	/* Simple description for null item */
 	if (!obj || !obj->known)
@@ -631,6 +764,20 @@ size_t object_desc(char *buf, size_t max, const struct object *obj, int mode,
 	if (object_flavor_is_aware(obj) && !spoil)
 		obj->kind->everseen = true;
 
+	/* Use the last description if nothing it depends on has changed */
+	object_desc_stats.lookups++;
+	desc_key_make(&key, obj, mode, p);
+	n = desc_cache_set(obj);
+	for (i = 0; i < DESC_CACHE_WAYS; i++) {
+		const struct desc_entry *entry = &desc_cache[n][i];
+
+		if ((entry->len < max) && !memcmp(&entry->key, &key, sizeof(key))) {
+			object_desc_stats.hits++;
+			memcpy(buf, entry->text, entry->len + 1);
+			return entry->len;
+		}
+	}
+
 	/** Construct the name **/
 
 	/* Copy the base name to the buffer */
@@ -658,5 +805,15 @@ size_t object_desc(char *buf, size_t max, const struct object *obj, int mode,
 			end = obj_desc_inscrip(obj, buf, max, end, p);
 	}
 
+	/* Keep descriptions that weren't cut short, replacing the oldest */
+	if ((end + 1 < max) && (end < DESC_CACHE_LEN)) {
+		struct desc_entry *entry = &desc_cache[n][desc_cache_next[n]];
+
+		desc_cache_next[n] = (desc_cache_next[n] + 1) % DESC_CACHE_WAYS;
+		entry->key = key;
+		entry->len = end;
+		memcpy(entry->text, buf, end + 1);
+	}
+
 	return end;
 }
@@ -42,7 +42,19 @@ enum {
 };
 
 
+/**
+ * How often object_desc() found its description already made
+ */
+struct object_desc_stats {
+	long lookups;
+	long hits;
+};
+
 extern const char *inscrip_text[];
+extern struct object_desc_stats object_desc_stats;
+
+void object_desc_forget_all(void);
+void object_desc_forget(const struct object *obj);
 
 void object_base_name(char *buf, size_t max, int tval, bool plural);
 void object_kind_name(char *buf, size_t max, const struct object_kind *kind,
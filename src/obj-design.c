@@ -3997,53 +3997,158 @@ static void write_randart_file_entry(ang_file *fff, const struct artifact *art)
 }
 
 /**
- * Initialize all the random artifacts in the artifact array.  This function 
- * is only called when a player is born.
+ * Get the seed of the random number stream for one artifact of a set, so
+ * that each design depends only on the seed of the set and its own index.
  */
-void initialize_random_artifacts(u32b randart_seed)
+static u32b randart_stream_seed(u32b randart_seed, int idx)
+{
+	u32b h = randart_seed ^ ((u32b) (idx + 1) * 0x9E3779B9U);
+
+	/* Mix the bits well, so neighbouring streams don't follow each other */
+	h ^= h >> 16;
+	h *= 0x85EBCA6BU;
+	h ^= h >> 13;
+	h *= 0xC2B2AE35U;
+	h ^= h >> 16;
+	return h;
+}
+
+/**
+ * Design some of the artifacts of a random artifact set.
+ *
+ * \param randart_seed is the seed of the set
+ * \param arts is where to put the designs
+ * \param first is the index in the set of the first artifact to design
+ * \param num is the number of artifacts to design
+ *
+ * Each artifact is designed from its own stream of the "simple" RNG, so it
+ * comes out the same whichever part of the set is designed, and in whatever
+ * order.  The "simple" RNG is left in use afterwards.
+ */
+void design_random_artifacts(u32b randart_seed, struct artifact *arts,
+		int first, int num)
+{
+	int i;
+
+	Rand_quick = true;
+	for (i = 0; i < num; i++) {
+		Rand_value = randart_stream_seed(randart_seed, first + i);
+		design_random_artifact(&arts[i]);
+	}
+}
+
+/**
+ * Design a whole random artifact set the way it was done before each artifact
+ * had its own stream, from one stream of the "simple" RNG in order.  Only
+ * characters from savefiles older than the streams use this, so that their
+ * artifacts come out the same when randart.txt has to be made again.
+ */
+void design_random_artifacts_serial(u32b randart_seed, struct artifact *arts,
+		int num)
 {
-	char fname[1024];
-	ang_file *randart_file = NULL;
 	int i;
 
-	/* Prepare to use the Angband "simple" RNG. */
 	Rand_value = randart_seed;
 	Rand_quick = true;
+	for (i = 0; i < num; i++) {
+		design_random_artifact(&arts[i]);
+	}
+}
+
+/**
+ * Free the memory used by artifacts from design_random_artifacts()
+ */
+void free_random_artifacts(struct artifact *arts, int num)
+{
+	int i;
+
+	for (i = 0; i < num; i++) {
+		string_free(arts[i].name);
+		string_free(arts[i].text);
+		mem_free(arts[i].brands);
+		mem_free(arts[i].slays);
+		mem_free(arts[i].curses);
+	}
+}
+
+/**
+ * Write a set of random artifacts to a file in the form the randart parser
+ * reads; quits if the file can't be written.
+ */
+static void write_randart_file(const char *fname, u32b randart_seed,
+		const struct artifact *arts, int num)
+{
+	ang_file *randart_file = file_open(fname, MODE_WRITE, FTYPE_TEXT);
+	int i;
 
-	/* Open the file, write a header */
-	path_build(fname, sizeof(fname), ANGBAND_DIR_USER, "randart.txt");
-	randart_file = file_open(fname, MODE_WRITE, FTYPE_TEXT);
 	if (!randart_file) {
 		quit_fmt("Error - can't create %s.", fname);
 	}
 	file_putf(randart_file,
 			  "# Artifact file for random artifacts with seed %08x\n\n\n",
 			  randart_seed);
+	for (i = 0; i < num; i++) {
+		write_randart_file_entry(randart_file, &arts[i]);
+	}
+	if (!file_close(randart_file)) {
+		quit_fmt("Error - can't close %s.", fname);
+	}
+}
 
-	/* Initialize, name and write artifacts to the file */
+/**
+ * Initialize all the random artifacts in the artifact array.  This function 
+ * is called when a player is born, and when a character is loaded without its
+ * randart.txt; streams is false for characters whose set was designed
+ * serially.
+ */
+void initialize_random_artifacts(u32b randart_seed, bool streams)
+{
+	char fname[1024];
+	int i, first = z_info->a_max;
+
+	/* Extend the artifact array with zero entries */
+	a_info = mem_realloc(a_info, (first + ART_NUM_RANDOM) * sizeof(*a_info));
+	aup_info = mem_realloc(aup_info, (first + ART_NUM_RANDOM)
+						   * sizeof(*aup_info));
+	memset(&a_info[first], 0, ART_NUM_RANDOM * sizeof(*a_info));
+	memset(&aup_info[first], 0, ART_NUM_RANDOM * sizeof(*aup_info));
 	for (i = 0; i < ART_NUM_RANDOM; i++) {
-		/* Extend the artifact array with a zero entry */
-		struct artifact *art;
-		a_info = mem_realloc(a_info, (z_info->a_max + 1) * sizeof(*art));
-		aup_info = mem_realloc(aup_info, (z_info->a_max + 1)
-							   * sizeof(*aup_info));
-		art = &a_info[z_info->a_max];
-		memset(art, 0, sizeof(*art));
-		memset(&aup_info[z_info->a_max], 0, sizeof(*aup_info));
-		aup_info[z_info->a_max].aidx = z_info->a_max;
-		z_info->a_max += 1;
-
-		/* Design the artifact, storing information as we go along. */
-		design_random_artifact(art);
-
-		/* Write the entry to the randart file */
-		write_randart_file_entry(randart_file, art);
+		aup_info[first + i].aidx = first + i;
 	}
+	z_info->a_max += ART_NUM_RANDOM;
 
-	/* Close the file */
-	if (!file_close(randart_file)) {
-		quit_fmt("Error - can't close %s.", fname);
+	/* Design the artifacts, storing information as we go along. */
+	if (streams) {
+		design_random_artifacts(randart_seed, &a_info[first], 0,
+			ART_NUM_RANDOM);
+	} else {
+		design_random_artifacts_serial(randart_seed, &a_info[first],
+			ART_NUM_RANDOM);
 	}
+
+	/* Write them to the randart file */
+	path_build(fname, sizeof(fname), ANGBAND_DIR_USER, "randart.txt");
+	write_randart_file(fname, randart_seed, &a_info[first], ART_NUM_RANDOM);
+}
+
+/**
+ * Design the random artifact set for a seed and write it to a file, without
+ * touching the artifact array or the state of the RNG; for tools which
+ * study many sets.
+ */
+void write_random_artifact_set(u32b randart_seed, const char *fname)
+{
+	struct artifact *arts = mem_zalloc(ART_NUM_RANDOM * sizeof(*arts));
+	bool old_quick = Rand_quick;
+	u32b old_value = Rand_value;
+
+	design_random_artifacts(randart_seed, arts, 0, ART_NUM_RANDOM);
+	write_randart_file(fname, randart_seed, arts, ART_NUM_RANDOM);
+	free_random_artifacts(arts, ART_NUM_RANDOM);
+	mem_free(arts);
+
+	Rand_quick = old_quick;
+	Rand_value = old_value;
 }
 
 /**
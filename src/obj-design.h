@@ -72,7 +72,13 @@ enum rank_method {
  */
 #define TOO_MUCH         10000
 
-void initialize_random_artifacts(u32b randart_seed);
+void design_random_artifacts(u32b randart_seed, struct artifact *arts,
+	int first, int num);
+void design_random_artifacts_serial(u32b randart_seed, struct artifact *arts,
+	int num);
+void free_random_artifacts(struct artifact *arts, int num);
+void initialize_random_artifacts(u32b randart_seed, bool streams);
+void write_random_artifact_set(u32b randart_seed, const char *fname);
 bool design_jewellery(struct object *obj, int lev);
 
 #endif /* !INCLUDED_OBJDESIGN_H */
@@ -17,6 +17,7 @@
  *    are included in all such copies.  Other copyrights may also apply.
  */
 #include "angband.h"
+#include "cave.h"
 #include "cmds.h"
 #include "init.h"
 #include "obj-desc.h"
@@ -357,6 +358,20 @@ void autoinscribe_pack(struct player *p)
  * ------------------------------------------------------------------------ */
 
 
+/**
+ * Note that the ignore settings, or whether ignored items are shown, have
+ * changed.  The cached looks of grids and descriptions of objects are thrown
+ * away at once, because the map or a subwindow may be redrawn before
+ * notice_stuff() gets to deal with PN_IGNORE.
+ */
+void ignore_settings_changed(struct player *p)
+{
+	map_render_forget_all();
+	object_desc_forget_all();
+	p->upkeep->notice |= PN_IGNORE;
+	p->upkeep->redraw |= PR_MAP;
+}
+
 /**
  * Ignore the flavor of an object
  */
@@ -366,6 +381,7 @@ void object_ignore_flavor_of(const struct object *obj)
 		obj->kind->ignore |= IGNORE_IF_AWARE;
 	else
 		obj->kind->ignore |= IGNORE_IF_UNAWARE;
+	ignore_settings_changed(player);
 }
 
 
@@ -493,27 +509,27 @@ byte ignore_level_of(const struct object *obj)
 void kind_ignore_clear(struct object_kind *kind)
 {
 	kind->ignore = 0;
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 }
 
 void ego_ignore(struct object *obj)
 {
 	assert(obj->ego);
 	ego_ignore_types[obj->ego->eidx][ignore_type_of(obj)] = true;
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 }
 
 void ego_ignore_clear(struct object *obj)
 {
 	assert(obj->ego);
 	ego_ignore_types[obj->ego->eidx][ignore_type_of(obj)] = false;
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 }
 
 void ego_ignore_toggle(int e_idx, int itype)
 {
 	ego_ignore_types[e_idx][itype] = !ego_ignore_types[e_idx][itype];
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 }
 
 bool ego_is_ignored(int e_idx, int itype)
@@ -534,13 +550,13 @@ bool kind_is_ignored_unaware(const struct object_kind *kind)
 void kind_ignore_when_aware(struct object_kind *kind)
 {
 	kind->ignore |= IGNORE_IF_AWARE;
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 }
 
 void kind_ignore_when_unaware(struct object_kind *kind)
 {
 	kind->ignore |= IGNORE_IF_UNAWARE;
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 }
 
 
@@ -88,6 +88,7 @@ extern bool **ego_ignore_types;
 
 /* obj-ignore.c */
 void ignore_birth_init(void);
+void ignore_settings_changed(struct player *p);
 void rune_autoinscribe(struct player *p, int i);
 const char *get_autoinscription(struct object_kind *kind, bool aware);
 int apply_autoinscription(struct player *p, struct object *obj);
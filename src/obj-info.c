@@ -456,53 +456,6 @@ static bool describe_brands(textblock *tb, const struct object *obj)
 	return true;
 }
 
-/**
- * Account for criticals in the calculation of melee prowess for O-combat;
- * crit chance * average number of dice added
- *
- * Return value is 100x number of dice
- */
-static int calculate_melee_crits(struct player_state state,
-								   const struct object *obj)
-{
-	int dice = 0;
-	int chance = BTH_PLUS_ADJ * (state.to_h + obj->known->to_h) +
-		state.skills[SKILL_TO_HIT_MELEE];
-	chance = (100 * chance) / (chance + 240);
-	if (player_has(player, PF_ARMSMAN)) {
-		chance = 100 - (83 * (100 - chance)) / 100;
-	}
-	dice = (537 * chance) / 240;
-
-	return dice;
-}
-
-/**
- * Missile crits follow the same approach as melee crits.
- */
-static int calculate_missile_crits(struct player_state state,
-									 const struct object *obj,
-									 const struct object *launcher)
-{
-	int dice = 0;
-	int bonus = state.to_h + obj->known->to_h
-		+ (launcher ? launcher->known->to_h : 0);
-	int chance = BTH_PLUS_ADJ * bonus;
-	if (launcher) {
-		chance += state.skills[SKILL_TO_HIT_BOW];
-	} else {
-		chance += state.skills[SKILL_TO_HIT_THROW];
-		chance *= 3 / 2;
-	}
-	chance = (100 * chance) / (chance + 360);
-	if (player_has(player, PF_MARKSMAN)) {
-		chance = 100 - (83 * (100 - chance)) / 100;
-	}
-	dice = (569 * chance) / 500;
-
-	return dice;
-}
-
 /**
  * Get the object flags the player should know about for the given object/
  * viewing mode combination.
@@ -596,7 +549,8 @@ static int obj_known_blows(const struct object *obj, int max_num,
 	/* Pretend we're wielding the object */
 	player->body.slots[weapon_slot].obj = (struct object *) obj;
 
-	/* Calculate the player's hypothetical state */
+	/* Calculate the player's hypothetical state; only the stats will vary */
+	calc_bonuses_hold();
 	memcpy(&state, &player->state, sizeof(state));
 	state.stat_ind[STAT_STR] = 0; //Hack - NRM
 	state.stat_ind[STAT_DEX] = 0; //Hack - NRM
@@ -621,6 +575,7 @@ static int obj_known_blows(const struct object *obj, int max_num,
 			/* Unlikely */
 			if (num == max_num) {
 				player->body.slots[weapon_slot].obj = current_weapon;
+				calc_bonuses_release();
 				return num;
 			}
 
@@ -661,6 +616,7 @@ static int obj_known_blows(const struct object *obj, int max_num,
 
 	/* Stop pretending */
 	player->body.slots[weapon_slot].obj = current_weapon;
+	calc_bonuses_release();
 
 	return num;
 }
@@ -706,206 +662,6 @@ static bool describe_blows(textblock *tb, const struct object *obj)
 }
 
 
-/**
- * Gets information about the average damage/turn that can be inflicted if
- * the player wields the given weapon.
- *
- * Fills in the damage against normal adversaries in `normal_damage`, as well
- * as the slays on the weapon in slay_list[] and corresponding damages in 
- * slay_damage[].  These must both be at least SL_MAX long to be safe.
- * `nonweap_slay` is set to whether other items being worn could add to the
- * damage done by branding attacks.
- *
- * Returns the number of slays populated in slay_list[] and slay_damage[].
- *
- * Note that the results are meaningless if called on a fake ego object as
- * the actual ego may have different properties.
- */
-static bool obj_known_damage(const struct object *obj, int *normal_damage,
-							 int *brand_damage, int *slay_damage,
-							 bool *nonweap_slay, bool throw)
-{
-	int i;
-	int dice, sides, die_average, total_dam;
-	int deadliness = obj->known->to_d;
-	int old_blows = 0;
-	bool *total_brands;
-	bool *total_slays;
-	bool has_brands_or_slays = false;
-
-	struct object *bow = equipped_item_by_slot_name(player, "shooting");
-	bool weapon = tval_is_melee_weapon(obj) && !throw;
-	bool ammo   = (player->state.ammo_tval == obj->tval) && (bow) && !throw;
-	int multiplier = 1;
-
-	struct player_state state;
-	int weapon_slot = slot_by_name(player, "weapon");
-	struct object *current_weapon = slot_object(player, weapon_slot);
-
-	/* Pretend we're wielding the object if it's a weapon */
-	if (weapon)
-		player->body.slots[weapon_slot].obj = (struct object *) obj;
-
-	/* Calculate the player's hypothetical state */
-	memcpy(&state, &player->state, sizeof(state));
-	state.stat_ind[STAT_STR] = 0; //Hack - NRM
-	state.stat_ind[STAT_DEX] = 0; //Hack - NRM
-	calc_bonuses(player, &state, true, false);
-
-	/* Stop pretending */
-	player->body.slots[weapon_slot].obj = current_weapon;
-
-	/* Finish if dice not known */
-	dice = obj->known->dd * 100;
-	sides = obj->known->ds;
-	if (!dice || !sides) return false;
-
-	/* Get the number of additional dice from criticals (x100) */
-	if (weapon)	{
-		dice += calculate_melee_crits(state, obj);
-		old_blows = state.num_blows;
-	} else if (ammo) {
-		dice += calculate_missile_crits(player->state, obj, bow);
-	} else {
-		if (of_has(obj->known->flags, OF_PERFECT_BALANCE)) {
-			dice *= 2;
-		}
-		dice += calculate_missile_crits(player->state, obj, NULL);
-		dice *= 2 + player->lev / 12;
-	}
-
-	if (ammo) multiplier = player->state.ammo_mult;
-
-	/* Get the average value of a single damage die. (x10) */
-	die_average = 5 * (sides + 1);
-
-	/* Apply the launcher multiplier. */
-	die_average *= multiplier;
-
-	/* Apply deadliness to average. (100x inflation) */
-	if (ammo) {
-		deadliness = obj->known->to_d + bow->known->to_d + state.to_d;
-	} else {
-		deadliness = obj->known->to_d + state.to_d;
-	}
-	apply_deadliness(&die_average, MIN(deadliness, 150));
-
-	/* Get the brands */
-	total_brands = mem_zalloc(z_info->brand_max * sizeof(bool));
-	copy_brands(&total_brands, obj->known->brands);
-	if (ammo && bow->known)
-		copy_brands(&total_brands, bow->known->brands);
-
-	/* Get the slays */
-	total_slays = mem_zalloc(z_info->slay_max * sizeof(bool));
-	copy_slays(&total_slays, obj->known->slays);
-	if (ammo && bow->known)
-		copy_slays(&total_slays, bow->known->slays);
-
-	/* Melee weapons may get slays and brands from other items */
-	*nonweap_slay = false;
-	if (weapon)	{
-		for (i = 2; i < player->body.count; i++) {
-			struct object *slot_obj = slot_object(player, i);
-			if (!slot_obj)
-				continue;
-
-			if (slot_obj->known->brands || slot_obj->known->slays)
-				*nonweap_slay = true;
-			else
-				continue;
-
-			/* Replace the old lists with new ones */
-			copy_brands(&total_brands, slot_obj->known->brands);
-			copy_slays(&total_slays, slot_obj->known->slays);
-		}
-	}
-
-	/* Increase die average for each brand on the objects */
-	for (i = 1; i < z_info->brand_max; i++) {
-		int brand_average, add = brands[i].multiplier - 10;
-
-		/* Must have the brand, possibly from a spell */
-		if (player_has_temporary_brand(player, i)) {
-			*nonweap_slay = true;
-		} else if (!total_brands[i]) {
-			continue;
-		}
-		has_brands_or_slays = true;
-
-		/* Include brand in stated average (x10), deflate (/1000) */
-		brand_average = die_average * brands[i].multiplier;
-		brand_average /= 1000;
-
-		/* Damage per hit is now dice * die average, (still x1000) */
-		total_dam = (dice * brand_average);
-
-		/* Now adjust for blows and shots and deflate again */
-		if (weapon) {
-			total_dam *= old_blows;
-			total_dam /= 10000;
-		} else if (ammo) {
-			total_dam *= player->state.num_shots;
-			total_dam /= 1000;
-		} else {
-			total_dam /= 100;
-		}
-
-		brand_damage[i] = total_dam + add;
-	}
-
-	/* Get damage for each slay on the objects */
-	for (i = 1; i < z_info->slay_max; i++) {
-		int slay_average, add = slays[i].multiplier - 10;
-
-		/* Must have the slay, possibly from a spell */
-		if (player_has_temporary_slay(player, i)) {
-			*nonweap_slay = true;
-		} else if (!total_slays[i]) {
-			continue;
-		}
-		has_brands_or_slays = true;
-
-		/* Include slay in stated average (x10), deflate (/1000) */
-		slay_average = die_average * slays[i].multiplier;
-		slay_average /= 1000;
-
-		/* Damage per hit is now dice * die average, (still x1000) */
-		total_dam = (dice * slay_average);
-
-		/* Now adjust for blows and shots and deflate again */
-		if (weapon) {
-			total_dam *= old_blows;
-			total_dam /= 10000;
-		} else if (ammo) {
-			total_dam *= player->state.num_shots;
-			total_dam /= 1000;
-		} else {
-			total_dam /= 100;
-		}
-
-		slay_damage[i] = total_dam + add;
-	}
-
-	/* Normal damage, not considering brands or slays */
-	total_dam = (dice * die_average) / 1000;
-	if (weapon) {
-		total_dam *= old_blows;
-		total_dam /= 1000;
-	} else if (ammo) {
-		total_dam *= player->state.num_shots;
-		total_dam /= 100;
-	} else {
-		total_dam /= 10;
-	}
-	*normal_damage = total_dam;
-
-	mem_free(total_brands);
-	mem_free(total_slays);
-	return has_brands_or_slays;
-}
-
-
 /**
  * Describe damage.
  */
@@ -918,9 +674,8 @@ static bool describe_damage(textblock *tb, const struct object *obj, bool throw)
 	int *slay_damage = mem_zalloc(z_info->slay_max * sizeof(int));
 
 	/* Collect brands and slays */
-	bool has_brands_or_slays = obj_known_damage(obj, &normal_damage,
-												brand_damage, slay_damage,
-												&nonweap_slay, throw);
+	bool has_brands_or_slays = attack_expected_damage(player, obj, throw,
+		&normal_damage, brand_damage, slay_damage, &nonweap_slay);
 
 	/* Mention slays and brands from other items */
 	if (nonweap_slay)
@@ -1840,9 +1595,7 @@ void object_info_chardump(ang_file *f, const struct object *obj, int indent,
  * Practically, this means that we should not print anything which relies upon
  * the player's current state, since that is not suitable for spoiler material.
  */
-void object_info_spoil(ang_file *f, const struct object *obj, int wrap)
+textblock *object_info_spoil(const struct object *obj)
 {
-	textblock *tb = object_info_out(obj, OINFO_SPOIL);
-	textblock_to_file(tb, f, 0, wrap);
-	textblock_free(tb);
+	return object_info_out(obj, OINFO_SPOIL);
 }
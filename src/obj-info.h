@@ -37,7 +37,7 @@ typedef enum {
 
 textblock *object_info(const struct object *obj, oinfo_detail_t mode);
 textblock *object_info_ego(struct ego_item *ego);
-void object_info_spoil(ang_file *f, const struct object *obj, int wrap);
+textblock *object_info_spoil(const struct object *obj);
 void object_info_chardump(ang_file *f, const struct object *obj, int indent, int wrap);
 
 #endif /* OBJECT_INFO_H */
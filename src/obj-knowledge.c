@@ -948,6 +948,7 @@ void object_sense(struct player *p, struct object *obj)
 		/* Attach it to the current floor pile */
 		new_obj->grid = grid;
 		pile_insert_end(&p->cave->squares[grid.y][grid.x].obj, new_obj);
+		cave_journal_note(p->cave, grid, KNOWN_CHANGE_OBJECT);
 	}
 }
 
@@ -979,6 +980,7 @@ void object_see(struct player *p, struct object *obj)
 		/* Attach it to the current floor pile */
 		new_obj->grid = grid;
 		pile_insert_end(&p->cave->squares[grid.y][grid.x].obj, new_obj);
+		cave_journal_note(p->cave, grid, KNOWN_CHANGE_OBJECT);
 	} else {
 		struct loc old = known_obj->grid;
 
@@ -988,6 +990,9 @@ void object_see(struct player *p, struct object *obj)
 		if (known_obj->kind != obj->kind) {
 			/* Copy over actual details */
 			object_set_base_known(p, obj);
+			if (!loc_is_zero(old)) {
+				cave_journal_note(p->cave, old, KNOWN_CHANGE_OBJECT);
+			}
 		} else {
 			known_obj->number = obj->number;
 		}
@@ -1004,6 +1009,7 @@ void object_see(struct player *p, struct object *obj)
 
 			known_obj->grid = grid;
 			pile_insert_end(&p->cave->squares[grid.y][grid.x].obj, known_obj);
+			cave_journal_note(p->cave, grid, KNOWN_CHANGE_OBJECT);
 		}
 	}
 }
@@ -1095,6 +1101,9 @@ void player_know_object(struct player *p, struct object *obj)
 		return;
 	}
 
+	/* Names may change with any of what follows */
+	object_desc_forget_all();
+
 	/* Get the dice, and the pval for anything but chests */
 	obj->known->dd = obj->dd * p->obj_k->dd;
 	obj->known->ds = obj->ds * p->obj_k->ds;
@@ -1137,8 +1146,7 @@ void player_know_object(struct player *p, struct object *obj)
 		for (i = 1; i < z_info->brand_max; i++) {
 			if (player_knows_brand(p, i) && obj->brands[i]) {
 				if (!obj->known->brands) {
-					obj->known->brands = mem_zalloc(z_info->brand_max *
-													sizeof(bool));
+					obj->known->brands = object_new_brands();
 				}
 				obj->known->brands[i] = true;
 			}
@@ -1150,8 +1158,7 @@ void player_know_object(struct player *p, struct object *obj)
 		for (i = 1; i < z_info->slay_max; i++) {
 			if (player_knows_slay(p, i) && obj->slays[i]) {
 				if (!obj->known->slays) {
-					obj->known->slays = mem_zalloc(z_info->slay_max *
-												   sizeof(bool));
+					obj->known->slays = object_new_slays();
 				}
 				obj->known->slays[i] = true;
 			}
@@ -1164,8 +1171,7 @@ void player_know_object(struct player *p, struct object *obj)
 		for (i = 1; i < z_info->curse_max; i++) {
 			if (p->obj_k->curses[i].power && obj->curses[i].power) {
 				if (!obj->known->curses) {
-					obj->known->curses = mem_zalloc(z_info->curse_max *
-													sizeof(struct curse_data));
+					obj->known->curses = object_new_curses();
 				}
 				obj->known->curses[i].power = obj->curses[i].power;
 				known_cursed = true;
@@ -1269,6 +1275,9 @@ void update_player_object_knowledge(struct player *p)
 	if (cave)
 		autoinscribe_ground(p);
 	autoinscribe_pack(p);
+	map_render_forget_all();
+	object_desc_forget_all();
+	p->upkeep->redraw |= PR_MAP;
 	event_signal(EVENT_INVENTORY);
 	event_signal(EVENT_EQUIPMENT);
 }
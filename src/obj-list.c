@@ -63,6 +63,7 @@ void object_list_free(object_list_t *list)
 		list->entries = NULL;
 	}
 
+	mem_free(list->los);
 	mem_free(list);
 }
 
@@ -157,6 +158,7 @@ void object_list_collect(object_list_t *list)
 {
 	int i;
 	struct loc pgrid = player->grid;
+	u16b distinct = 0;
 
 	if (list == NULL || list->entries == NULL)
 		return;
@@ -164,10 +166,20 @@ void object_list_collect(object_list_t *list)
 	if (!object_list_needs_update(list))
 		return;
 
+	/* Make room to remember line of sight to every object */
+	if (list->los_size < player->cave->obj_max) {
+		list->los = mem_realloc(list->los, player->cave->obj_max *
+			sizeof(struct projectable_memo));
+		memset(list->los + list->los_size, 0,
+			(player->cave->obj_max - list->los_size) *
+			sizeof(struct projectable_memo));
+		list->los_size = player->cave->obj_max;
+	}
+
 	/* Scan each object in the dungeon. */
 	for (i = 1; i < player->cave->obj_max; i++) {
 		object_list_entry_t *entry = NULL;
-		int entry_index;
+		int j;
 		int current_distance;
 		int entry_distance;
 		struct loc grid;
@@ -183,33 +195,22 @@ void object_list_collect(object_list_t *list)
 			grid = obj->grid;
 		}
 
-		/* Determine which section of the list the object entry is in */
-		los = projectable(cave, pgrid, grid, PROJECT_NONE) ||
-			loc_eq(grid, pgrid);
-		field = (los) ? OBJECT_LIST_SECTION_LOS : OBJECT_LIST_SECTION_NO_LOS;
-
 		if (object_list_should_ignore_object(player, obj)) continue;
 
-		/* Find or add a list entry. */
-		for (entry_index = 0; entry_index < (int)list->entries_size;
-			 entry_index++) {
-			int j;
-			struct object *list_obj = list->entries[entry_index].object;
-
-			if (list_obj == NULL) {
-				/* We found an empty slot, so add this object here. */
-				list->entries[entry_index].object = obj;
-				for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
-					list->entries[entry_index].count[j] = 0;
-				list->entries[entry_index].dy = grid.y - pgrid.y;
-				list->entries[entry_index].dx = grid.x - pgrid.x;
-				entry = &list->entries[entry_index];
-				break;
-			}
-		}
+		/* Determine which section of the list the object entry is in */
+		los = loc_eq(grid, pgrid) || projectable_memo(&list->los[i], cave,
+			pgrid, grid, PROJECT_NONE);
+		field = (los) ? OBJECT_LIST_SECTION_LOS : OBJECT_LIST_SECTION_NO_LOS;
 
-		if (entry == NULL)
+		/* Add a list entry in the next empty slot. */
+		if (distinct >= list->entries_size)
 			return;
+		entry = &list->entries[distinct++];
+		entry->object = obj;
+		for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
+			entry->count[j] = 0;
+		entry->dy = grid.y - pgrid.y;
+		entry->dx = grid.x - pgrid.x;
 
 		/* We only know the number of objects we've actually seen */
 		if (obj->kind == cave->objects[obj->oidx]->kind)
@@ -230,7 +231,7 @@ void object_list_collect(object_list_t *list)
 	}
 
 	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++) {
+	for (i = 0; i < distinct; i++) {
 		if (list->entries[i].object == NULL)
 			continue;
 
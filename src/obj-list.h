@@ -19,6 +19,8 @@
 #ifndef OBJECT_LIST_H
 #define OBJECT_LIST_H
 
+#include "project.h"
+
 #define MAX_ITEMLIST 2560
 
 typedef enum object_list_section_e {
@@ -41,6 +43,10 @@ typedef struct object_list_s {
 	u16b total_entries[OBJECT_LIST_SECTION_MAX];
 	u16b total_objects[OBJECT_LIST_SECTION_MAX];
 	bool sorted;
+
+	/* Line of sight to each object index, remembered between collections */
+	struct projectable_memo *los;
+	size_t los_size;
 } object_list_t;
 
 object_list_t *object_list_new(void);
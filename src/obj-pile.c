@@ -278,12 +278,169 @@ bool pile_contains(const struct object *top, const struct object *obj)
 	return false;
 }
 
+/**
+ * Most objects are short lived - failed drops, store stock turned over, the
+ * halves of split stacks - so freed objects and their slay, brand and curse
+ * arrays are kept in pools, one per block size, for the next allocation to
+ * reuse.  The pools are only open between module init and cleanup; outside
+ * that (and for anything over the pool limit) blocks go straight back to the
+ * system, so objects freed late in shutdown are never stranded.
+ */
+#define OBJECT_POOL_LIMIT	4096
+
+struct object_pool {
+	void *free;			/**< Freed blocks, linked through their first word */
+	struct object_pool_stats stats;
+};
+
+static struct object_pool object_pools[OBJ_POOL_MAX];
+static bool object_pools_open;
+
+/**
+ * Block size for a pool; zero if its blocks are too small to link
+ */
+static size_t object_pool_size(enum object_pool_type type)
+{
+	size_t size = 0;
+
+	switch (type) {
+		case OBJ_POOL_OBJECT: size = sizeof(struct object); break;
+		case OBJ_POOL_SLAYS: size = z_info->slay_max * sizeof(bool); break;
+		case OBJ_POOL_BRANDS: size = z_info->brand_max * sizeof(bool); break;
+		case OBJ_POOL_CURSES:
+			size = z_info->curse_max * sizeof(struct curse_data);
+			break;
+		default: break;
+	}
+
+	return (size < sizeof(void *)) ? 0 : size;
+}
+
+/**
+ * Take a block from a pool, or from the system if the pool is empty; the
+ * block is not cleared
+ */
+static void *object_pool_get(enum object_pool_type type, size_t size)
+{
+	struct object_pool *pool = &object_pools[type];
+	void *block = pool->free;
+
+	if (!block || !object_pools_open) {
+		pool->stats.fresh++;
+		return mem_alloc(size);
+	}
+
+	memcpy(&pool->free, block, sizeof(void *));
+	pool->stats.cached--;
+	pool->stats.reused++;
+	return block;
+}
+
+/**
+ * Return a block to its pool
+ */
+static void object_pool_put(enum object_pool_type type, void *block)
+{
+	struct object_pool *pool = &object_pools[type];
+
+	if (!block) return;
+	if (!object_pools_open || pool->stats.cached >= OBJECT_POOL_LIMIT ||
+			!object_pool_size(type)) {
+		mem_free(block);
+		return;
+	}
+
+	memcpy(block, &pool->free, sizeof(void *));
+	pool->free = block;
+	pool->stats.cached++;
+	pool->stats.returned++;
+}
+
+/**
+ * Take a zeroed array from a pool
+ */
+static void *object_pool_zalloc(enum object_pool_type type, size_t size)
+{
+	void *block = object_pool_get(type, size);
+
+	memset(block, 0, size);
+	return block;
+}
+
+/**
+ * Empty all the pools
+ */
+static void object_pools_drain(void)
+{
+	int i;
+
+	for (i = 0; i < OBJ_POOL_MAX; i++) {
+		struct object_pool *pool = &object_pools[i];
+
+		while (pool->free) {
+			void *block = pool->free;
+
+			memcpy(&pool->free, block, sizeof(void *));
+			mem_free(block);
+		}
+		pool->stats.cached = 0;
+	}
+}
+
+static void init_obj_pile(void)
+{
+	memset(object_pools, 0, sizeof(object_pools));
+	object_pools_open = true;
+}
+
+static void cleanup_obj_pile(void)
+{
+	object_pools_drain();
+	object_pools_open = false;
+}
+
+struct init_module obj_pile_module = {
+	.name = "object/obj-pile",
+	.init = init_obj_pile,
+	.cleanup = cleanup_obj_pile
+};
+
+/**
+ * Report on a pool
+ */
+void object_pool_stats(enum object_pool_type type,
+		struct object_pool_stats *stats)
+{
+	assert(type < OBJ_POOL_MAX);
+	*stats = object_pools[type].stats;
+}
+
+/**
+ * Allocate empty slay, brand and curse arrays for an object
+ */
+bool *object_new_slays(void)
+{
+	return object_pool_zalloc(OBJ_POOL_SLAYS, z_info->slay_max * sizeof(bool));
+}
+
+bool *object_new_brands(void)
+{
+	return object_pool_zalloc(OBJ_POOL_BRANDS,
+		z_info->brand_max * sizeof(bool));
+}
+
+struct curse_data *object_new_curses(void)
+{
+	return object_pool_zalloc(OBJ_POOL_CURSES,
+		z_info->curse_max * sizeof(struct curse_data));
+}
+
 /**
  * Create a new object and return it
  */
 struct object *object_new(void)
 {
-	struct object *o = mem_alloc(sizeof(*o));
+	struct object *o = object_pool_get(OBJ_POOL_OBJECT, sizeof(*o));
 
 	memcpy(o, &OBJECT_NULL, sizeof(*o));
 	return o;
@@ -296,10 +453,34 @@ struct object *object_new(void)
  */
 void object_free(struct object *obj)
 {
-	mem_free(obj->slays);
-	mem_free(obj->brands);
-	mem_free(obj->curses);
-	mem_free(obj);
+	object_desc_forget(obj);
+	object_pool_put(OBJ_POOL_SLAYS, obj->slays);
+	object_pool_put(OBJ_POOL_BRANDS, obj->brands);
+	object_pool_put(OBJ_POOL_CURSES, obj->curses);
+	object_pool_put(OBJ_POOL_OBJECT, obj);
+}
+
+/**
+ * Return the memory used by the objects listed in a chunk
+ */
+size_t chunk_object_memory(const struct chunk *c, int *count)
+{
+	size_t total = 0;
+	int i, n = 0;
+
+	for (i = 1; i <= c->obj_max; i++) {
+		const struct object *obj = c->objects[i];
+
+		if (!obj) continue;
+		n++;
+		total += sizeof(*obj);
+		if (obj->slays) total += z_info->slay_max * sizeof(bool);
+		if (obj->brands) total += z_info->brand_max * sizeof(bool);
+		if (obj->curses) total += z_info->curse_max * sizeof(struct curse_data);
+	}
+
+	if (count) *count = n;
+	return total;
 }
 
 /**
@@ -690,10 +871,12 @@ void object_absorb(struct object *obj1, struct object *obj2)
  */
 void object_wipe(struct object *obj)
 {
+	object_desc_forget(obj);
+
 	/* Free slays and brands */
-	mem_free(obj->slays);
-	mem_free(obj->brands);
-	mem_free(obj->curses);
+	object_pool_put(OBJ_POOL_SLAYS, obj->slays);
+	object_pool_put(OBJ_POOL_BRANDS, obj->brands);
+	object_pool_put(OBJ_POOL_CURSES, obj->curses);
 
 	/* Wipe the structure */
 	memset(obj, 0, sizeof(*obj));
@@ -705,20 +888,24 @@ void object_wipe(struct object *obj)
  */
 void object_copy(struct object *dest, const struct object *src)
 {
+	object_desc_forget(dest);
+
 	/* Copy the structure */
 	memcpy(dest, src, sizeof(struct object));
 
 	if (src->slays) {
-		dest->slays = mem_zalloc(z_info->slay_max * sizeof(bool));
-		memcpy(dest->slays, src->slays, z_info->slay_max * sizeof(bool));
+		size_t array_size = z_info->slay_max * sizeof(bool);
+		dest->slays = object_pool_get(OBJ_POOL_SLAYS, array_size);
+		memcpy(dest->slays, src->slays, array_size);
 	}
 	if (src->brands) {
-		dest->brands = mem_zalloc(z_info->brand_max * sizeof(bool));
-		memcpy(dest->brands, src->brands, z_info->brand_max * sizeof(bool));
+		size_t array_size = z_info->brand_max * sizeof(bool);
+		dest->brands = object_pool_get(OBJ_POOL_BRANDS, array_size);
+		memcpy(dest->brands, src->brands, array_size);
 	}
 	if (src->curses) {
 		size_t array_size = z_info->curse_max * sizeof(struct curse_data);
-		dest->curses = mem_zalloc(array_size);
+		dest->curses = object_pool_get(OBJ_POOL_CURSES, array_size);
 		memcpy(dest->curses, src->curses, array_size);
 	}
 
@@ -48,8 +48,34 @@ typedef enum
 	OFLOOR_VISIBLE = 0x08, /* Visible items only */
 } object_floor_t;
 
+/**
+ * Pools of freed objects and object arrays kept for reuse
+ */
+enum object_pool_type {
+	OBJ_POOL_OBJECT,
+	OBJ_POOL_SLAYS,
+	OBJ_POOL_BRANDS,
+	OBJ_POOL_CURSES,
+	OBJ_POOL_MAX
+};
+
+struct object_pool_stats {
+	long fresh;		/**< Blocks allocated from the system */
+	long reused;	/**< Blocks handed out again from the pool */
+	long returned;	/**< Blocks given back to the pool */
+	int cached;		/**< Blocks waiting in the pool */
+};
+
+extern struct init_module obj_pile_module;
+
+void object_pool_stats(enum object_pool_type type,
+		struct object_pool_stats *stats);
+bool *object_new_slays(void);
+bool *object_new_brands(void);
+struct curse_data *object_new_curses(void);
 struct object *object_new(void);
 void object_free(struct object *obj);
+size_t chunk_object_memory(const struct chunk *c, int *count);
 void object_delete(struct chunk *c, struct chunk *p_c,
 				   struct object **obj_address);
 void object_pile_free(struct chunk *c, struct object *obj);
@@ -25,6 +25,7 @@
 #include "obj-gear.h"
 #include "obj-init.h"
 #include "obj-knowledge.h"
+#include "obj-pile.h"
 #include "obj-slays.h"
 #include "obj-tval.h"
 #include "obj-util.h"
@@ -60,7 +61,7 @@ void copy_slays(bool **dest, bool *source)
 	/* Check structures */
 	if (!source) return;
 	if (!(*dest)) {
-		*dest = mem_zalloc(z_info->slay_max * sizeof(bool));
+		*dest = object_new_slays();
 	}
 
 	/* Copy */
@@ -95,7 +96,7 @@ void copy_brands(bool **dest, bool *source)
 	/* Check structures */
 	if (!source) return;
 	if (!(*dest))
-		*dest = mem_zalloc(z_info->brand_max * sizeof(bool));
+		*dest = object_new_brands();
 
 	/* Copy */
 	for (i = 0; i < z_info->brand_max; i++)
@@ -130,7 +131,7 @@ bool append_brand(bool **current, int pick)
 
 	/* No existing brands means OK to add */
 	if (!(*current)) {
-		*current = mem_zalloc(z_info->brand_max * sizeof(bool));
+		*current = object_new_brands();
 		(*current)[pick] = true;
 		return true;
 	}
@@ -172,7 +173,7 @@ bool append_slay(bool **current, int pick)
 
 	/* No existing slays means OK to add */
 	if (!(*current)) {
-		*current = mem_zalloc(z_info->slay_max * sizeof(bool));
+		*current = object_new_slays();
 		(*current)[pick] = true;
 		return true;
 	}
@@ -423,6 +424,190 @@ bool react_to_slay(struct object *obj, const struct monster *mon)
 }
 
 
+/**
+ * Add a brand or slay to the list an attack profile is being given
+ */
+static void attack_profile_push(struct attack_profile *prof, int mod)
+{
+	if (prof->n_next == prof->n_alloc) {
+		prof->n_alloc = prof->n_alloc ? 2 * prof->n_alloc : 16;
+		prof->next = mem_realloc(prof->next, prof->n_alloc * sizeof(int));
+		prof->mods = mem_realloc(prof->mods, prof->n_alloc * sizeof(int));
+	}
+	prof->next[prof->n_next++] = mod;
+}
+
+/**
+ * Start giving an attack profile the brands and slays on offer
+ *
+ * \param prof is the profile
+ * \param range is whether the attack is a ranged one
+ */
+void attack_profile_begin(struct attack_profile *prof, bool range)
+{
+	if (prof->range != range) {
+		prof->range = range;
+		prof->n_mods = -1;
+	}
+	prof->n_next = 0;
+}
+
+/**
+ * Give an attack profile the brands and slays from one source, in the order
+ * improve_attack_modifier() would try them
+ *
+ * \param prof is the profile
+ * \param p is the player making the attack
+ * \param obj is the object the brands and slays are on, or NULL for the
+ * player's temporary ones
+ */
+void attack_profile_add(struct attack_profile *prof, const struct player *p,
+		const struct object *obj)
+{
+	int i;
+
+	if (obj) {
+		if (obj->brands) {
+			for (i = 1; i < z_info->brand_max; i++)
+				if (obj->brands[i]) attack_profile_push(prof, i);
+		}
+		if (obj->slays) {
+			for (i = 1; i < z_info->slay_max; i++)
+				if (obj->slays[i])
+					attack_profile_push(prof, z_info->brand_max + i);
+		}
+	} else {
+		/* Look at the timed effects once rather than for each index */
+		bool brand_on = false, slay_on = false;
+
+		for (i = 0; i < TMD_MAX; i++) {
+			if (!p->timed[i]) continue;
+			if (timed_effects[i].temp_brand) brand_on = true;
+			if (timed_effects[i].temp_slay) slay_on = true;
+		}
+		if (brand_on) {
+			for (i = 1; i < z_info->brand_max; i++)
+				if (player_has_temporary_brand(p, i))
+					attack_profile_push(prof, i);
+		}
+		if (slay_on) {
+			for (i = 1; i < z_info->slay_max; i++)
+				if (player_has_temporary_slay(p, i))
+					attack_profile_push(prof, z_info->brand_max + i);
+		}
+	}
+}
+
+/**
+ * Finish giving an attack profile the brands and slays on offer, forgetting
+ * the best choices against each race if they have changed
+ */
+void attack_profile_end(struct attack_profile *prof)
+{
+	int *swap;
+
+	if ((prof->n_next == prof->n_mods) && (!prof->n_mods ||
+			!memcmp(prof->next, prof->mods, prof->n_mods * sizeof(int))))
+		return;
+
+	swap = prof->mods;
+	prof->mods = prof->next;
+	prof->next = swap;
+	prof->n_mods = prof->n_next;
+	if (prof->races)
+		memset(prof->races, 0, z_info->r_max * sizeof(*prof->races));
+}
+
+/**
+ * Work out the best brand and slay of a profile against a monster's race,
+ * exactly as the same sources passed through improve_attack_modifier() in
+ * turn would.
+ */
+static void attack_choice_make(const struct attack_profile *prof,
+		const struct monster *mon, struct attack_choice *choice)
+{
+	int i, best_mult = 1;
+
+	choice->brand = 0;
+	choice->slay = 0;
+	choice->verb = ATTACK_VERB_NONE;
+	for (i = 0; i < prof->n_mods; i++) {
+		int mod = prof->mods[i];
+
+		if (mod < z_info->brand_max) {
+			struct brand *b = &brands[mod];
+			int mult;
+
+			if (rf_has(mon->race->flags, b->resist_flag)) continue;
+			mult = get_monster_brand_multiplier(mon, b);
+			if (best_mult < mult) {
+				best_mult = mult;
+				choice->brand = mod;
+				choice->verb = ATTACK_VERB_BRAND;
+			}
+		} else {
+			struct slay *s = &slays[mod - z_info->brand_max];
+
+			if (!react_to_specific_slay(s, mon)) continue;
+			if (best_mult < s->multiplier) {
+				best_mult = s->multiplier;
+				choice->brand = 0;
+				choice->slay = mod - z_info->brand_max;
+				choice->verb = ATTACK_VERB_SLAY;
+			}
+		}
+	}
+	choice->made = true;
+	rf_copy(choice->flags, mon->race->flags);
+	choice->base = mon->race->base;
+}
+
+/**
+ * Get the best brand and slay of an attack against a monster.
+ *
+ * \param prof is the profile of the attack
+ * \param mon is the monster being attacked
+ * \param brand_used is set to the brand to use, or 0
+ * \param slay_used is set to the slay to use, or 0
+ * \param verb is set to the verb for the brand or slay, if there is one
+ */
+void attack_profile_choose(struct attack_profile *prof,
+		const struct monster *mon, int *brand_used, int *slay_used, char *verb)
+{
+	struct attack_choice *choice;
+
+	if (!prof->races)
+		prof->races = mem_zalloc(z_info->r_max * sizeof(*prof->races));
+	choice = &prof->races[mon->race->ridx];
+	/* Races can change, as the player ghost's does */
+	if (!choice->made || choice->base != mon->race->base ||
+			!rf_is_equal(choice->flags, mon->race->flags)) {
+		attack_choice_make(prof, mon, choice);
+	}
+
+	*brand_used = choice->brand;
+	*slay_used = choice->slay;
+	if (choice->verb == ATTACK_VERB_BRAND) {
+		my_strcpy(verb, brands[choice->brand].verb, 20);
+		if (prof->range)
+			my_strcat(verb, "s", 20);
+	} else if (choice->verb == ATTACK_VERB_SLAY) {
+		struct slay *s = &slays[choice->slay];
+		my_strcpy(verb, prof->range ? s->range_verb : s->melee_verb, 20);
+	}
+}
+
+/**
+ * Free the memory an attack profile uses
+ */
+void attack_profile_free(struct attack_profile *prof)
+{
+	mem_free(prof->mods);
+	mem_free(prof->next);
+	mem_free(prof->races);
+	memset(prof, 0, sizeof(*prof));
+}
+
 /**
  * Help learn_brand_slay_{melee,launch,throw}().
  *
@@ -23,6 +23,45 @@
 extern struct slay *slays;
 extern struct brand *brands;
 
+/**
+ * Which verb the best brand or slay against a race brings with it
+ */
+enum {
+	ATTACK_VERB_NONE,
+	ATTACK_VERB_BRAND,
+	ATTACK_VERB_SLAY
+};
+
+/**
+ * The best brand and slay of an attack against one monster race, with the
+ * parts of the race it was worked out from
+ */
+struct attack_choice {
+	s16b brand;
+	s16b slay;
+	byte verb;
+	bool made;
+	bitflag flags[RF_SIZE];
+	const struct monster_base *base;
+};
+
+/**
+ * The brands and slays an attack can use, in the order improve_attack_modifier()
+ * would try them: for each source in turn, its brands then its slays, slays
+ * being numbered after the brands.  The best of them against each race is
+ * worked out when the race is first attacked, and kept until the brands and
+ * slays on offer or the race's flags change.
+ */
+struct attack_profile {
+	bool range;
+	int n_mods;
+	int n_next;
+	int n_alloc;
+	int *mods;
+	int *next;
+	struct attack_choice *races;
+};
+
 /*** Functions ***/
 bool same_monsters_slain(int slay1, int slay2);
 void copy_slays(bool **dest, bool *source);
@@ -39,6 +78,13 @@ void improve_attack_modifier(struct player *p, struct object *obj,
 	const struct monster *mon, int *brand_used, int *slay_used, char *verb,
 	bool range);
 bool react_to_slay(struct object *obj, const struct monster *mon);
+void attack_profile_begin(struct attack_profile *prof, bool range);
+void attack_profile_add(struct attack_profile *prof, const struct player *p,
+	const struct object *obj);
+void attack_profile_end(struct attack_profile *prof);
+void attack_profile_choose(struct attack_profile *prof,
+	const struct monster *mon, int *brand_used, int *slay_used, char *verb);
+void attack_profile_free(struct attack_profile *prof);
 
 void learn_brand_slay_from_melee(struct player *p, struct object *weapon,
 	const struct monster *mon);
@@ -50,6 +50,14 @@
 struct unarmed_blow *unarmed_blows;
 int num_unarmed_blows;
 
+/**
+ * The brands and slays of the player's melee, shooting and throwing, with the
+ * best of them against each race met so far
+ */
+static struct attack_profile melee_profile;
+static struct attack_profile shot_profile;
+static struct attack_profile throw_profile;
+
 
 /**
  * ------------------------------------------------------------------------
@@ -130,6 +138,19 @@ struct file_parser unarmed_blow_parser = {
 	cleanup_unarmed_blow
 };
 
+static void cleanup_player_attack(void)
+{
+	attack_profile_free(&melee_profile);
+	attack_profile_free(&shot_profile);
+	attack_profile_free(&throw_profile);
+}
+
+struct init_module player_attack_module = {
+	.name = "player/player-attack",
+	.init = NULL,
+	.cleanup = cleanup_player_attack
+};
+
 /**
  * ------------------------------------------------------------------------
  * Hit and breakage calculations
@@ -161,6 +182,17 @@ int breakage_chance(const struct object *obj, bool hit_target) {
 	return perc;
 }
 
+/**
+ * Calculate a melee to-hit value from a player state, which need not be the
+ * player's own, and the weapon (or what the player knows of it).
+ */
+static int melee_hit_power(const struct player_state *state,
+		const struct object *weapon)
+{
+	int bonus = state->to_h + (weapon ? weapon->to_h : 0);
+	return state->skills[SKILL_TO_HIT_MELEE] + bonus * BTH_PLUS_ADJ;
+}
+
 /**
  * Calculate the player's base melee to-hit value without regard to a specific
  * monster.
@@ -172,8 +204,7 @@ int breakage_chance(const struct object *obj, bool hit_target) {
 int chance_of_melee_hit_base(const struct player *p,
 		const struct object *weapon)
 {
-	int bonus = p->state.to_h + (weapon ? weapon->to_h : 0);
-	return p->state.skills[SKILL_TO_HIT_MELEE] + bonus * BTH_PLUS_ADJ;
+	return melee_hit_power(&p->state, weapon);
 }
 
 /**
@@ -193,17 +224,12 @@ static int chance_of_melee_hit(const struct player *p,
 }
 
 /**
- * Calculate the player's base missile to-hit value without regard to a specific
- * monster.
- * See also: chance_of_melee_hit_base
- *
- * \param p The player
- * \param missile The missile to launch
- * \param launcher The launcher to use (optional)
+ * Calculate a missile to-hit value from a player state, which need not be the
+ * player's own, and the missile and launcher (or what the player knows of
+ * them).
  */
-static int chance_of_missile_hit_base(const struct player *p,
-									  const struct object *missile,
-									  const struct object *launcher)
+static int missile_hit_power(const struct player_state *state,
+		const struct object *missile, const struct object *launcher)
 {
 	int bonus = missile->to_h;
 	int chance;
@@ -212,20 +238,36 @@ static int chance_of_missile_hit_base(const struct player *p,
 		/* Other thrown objects are easier to use, but only throwing weapons 
 		 * take advantage of bonuses to skill from other equipped items. */
 		if (of_has(missile->flags, OF_THROWING)) {
-			bonus += p->state.to_h;
-			chance = p->state.skills[SKILL_TO_HIT_THROW] + bonus * BTH_PLUS_ADJ;
+			bonus += state->to_h;
+			chance = state->skills[SKILL_TO_HIT_THROW] + bonus * BTH_PLUS_ADJ;
 		} else {
-			chance = 3 * p->state.skills[SKILL_TO_HIT_THROW] / 2
+			chance = 3 * state->skills[SKILL_TO_HIT_THROW] / 2
 				+ bonus * BTH_PLUS_ADJ;
 		}
 	} else {
-		bonus += p->state.to_h + launcher->to_h;
-		chance = p->state.skills[SKILL_TO_HIT_BOW] + bonus * BTH_PLUS_ADJ;
+		bonus += state->to_h + launcher->to_h;
+		chance = state->skills[SKILL_TO_HIT_BOW] + bonus * BTH_PLUS_ADJ;
 	}
 
 	return chance;
 }
 
+/**
+ * Calculate the player's base missile to-hit value without regard to a specific
+ * monster.
+ * See also: chance_of_melee_hit_base
+ *
+ * \param p The player
+ * \param missile The missile to launch
+ * \param launcher The launcher to use (optional)
+ */
+static int chance_of_missile_hit_base(const struct player *p,
+									  const struct object *missile,
+									  const struct object *launcher)
+{
+	return missile_hit_power(&p->state, missile, launcher);
+}
+
 /**
  * Calculate the player's missile to-hit value against a specific monster.
  * See also: chance_of_melee_hit
@@ -427,6 +469,40 @@ void apply_deadliness(int *die_average, int deadliness)
 	}
 }
 
+/**
+ * One level of critical hit, which is picked one time in one_in among the
+ * critical hits that didn't get a level before it; the last level takes the
+ * rest.  Attacks roll these, and expected damage is worked out from them.
+ */
+struct critical_level {
+	int one_in;
+	int dice;
+	u32b msg_type;
+};
+
+static const struct critical_level shot_criticals[] = {
+	{ 50, 3, MSG_HIT_SUPERB },
+	{ 10, 2, MSG_HIT_GREAT },
+	{ 1, 1, MSG_HIT_GOOD }
+};
+
+static const struct critical_level melee_criticals[] = {
+	{ 40, 5, MSG_HIT_HI_GREAT },
+	{ 12, 4, MSG_HIT_SUPERB },
+	{ 3, 3, MSG_HIT_GREAT },
+	{ 1, 2, MSG_HIT_GOOD }
+};
+
+/**
+ * Roll the level of a critical hit
+ */
+static const struct critical_level *critical_level_roll(
+		const struct critical_level *level)
+{
+	while (level->one_in > 1 && !one_in_(level->one_in)) level++;
+	return level;
+}
+
 /**
  * Determine damage for critical hits from shooting.
  *
@@ -455,16 +531,11 @@ static int critical_shot(const struct player *p, const struct monster *mon,
 	/* Test for critical hit - chance power / (power + 360) */
 	if (randint1(power + 360) <= power || *marksman) {
 		/* Determine level of critical hit. */
-		if (one_in_(50)) {
-			*msg_type = MSG_HIT_SUPERB;
-			add_dice = 3;
-		} else if (one_in_(10)) {
-			*msg_type = MSG_HIT_GREAT;
-			add_dice = 2;
-		} else {
-			*msg_type = MSG_HIT_GOOD;
-			add_dice = 1;
-		}
+		const struct critical_level *level =
+			critical_level_roll(shot_criticals);
+
+		*msg_type = level->msg_type;
+		add_dice = level->dice;
 	} else {
 		*msg_type = MSG_SHOOT_HIT;
 	}
@@ -492,19 +563,11 @@ static int critical_melee(const struct player *p, struct monster *mon,
 	/* Test for critical hit - chance power / (power + 240) */
 	if (randint1(power + 240) <= power || *armsman) {
 		/* Determine level of critical hit. */
-		if (one_in_(40)) {
-			*msg_type = MSG_HIT_HI_GREAT;
-			add_dice = 5;
-		} else if (one_in_(12)) {
-			*msg_type = MSG_HIT_SUPERB;
-			add_dice = 4;
-		} else if (one_in_(3)) {
-			*msg_type = MSG_HIT_GREAT;
-			add_dice = 3;
-		} else {
-			*msg_type = MSG_HIT_GOOD;
-			add_dice = 2;
-		}
+		const struct critical_level *level =
+			critical_level_roll(melee_criticals);
+
+		*msg_type = level->msg_type;
+		add_dice = level->dice;
 	} else {
 		*msg_type = MSG_HIT;
 	}
@@ -760,6 +823,211 @@ static int ranged_damage(struct player *p, const struct monster *mon,
 	return dmg;
 }
 
+/**
+ * ------------------------------------------------------------------------
+ * Expected damage
+ * ------------------------------------------------------------------------ */
+/**
+ * Get the average number of dice a critical hit adds (x100)
+ */
+static int critical_level_average(const struct critical_level *level)
+{
+	int reach = 10000, sum = 0;
+
+	for (; level->one_in > 1; level++) {
+		sum += (reach / level->one_in) * level->dice;
+		reach -= reach / level->one_in;
+	}
+	sum += reach * level->dice;
+	return sum / 100;
+}
+
+/**
+ * Get the average number of dice criticals add to a hit (x100), from the
+ * power of the hit against a visible, awake target, the base the critical
+ * chance is worked out from, and whether an ability (armsman or marksman)
+ * makes one hit in six critical anyway.
+ */
+static int critical_expected_dice(const struct critical_level *levels,
+		int power, int base, bool ability)
+{
+	int chance = (power > 0) ? (100 * power) / (power + base) : 0;
+
+	if (ability) {
+		chance = 100 - (5 * (100 - chance)) / 6;
+	}
+	return (chance * critical_level_average(levels)) / 100;
+}
+
+/**
+ * Turn the average damage of a hit (x1000) into the average per round (x10)
+ */
+static int expected_per_round(int hit, bool weapon, bool ammo,
+		const struct player_state *state)
+{
+	if (weapon) {
+		return (hit / 100) * state->num_blows / 100;
+	} else if (ammo) {
+		return (hit / 100) * state->num_shots / 10;
+	}
+	return hit / 100;
+}
+
+/**
+ * Work out the average damage the player would do with an object from what
+ * they know of it and of themselves: as a melee weapon, as ammunition for the
+ * launcher they are wielding, or thrown.  This uses the dice, deadliness,
+ * critical hits and multipliers of real attacks, against a visible, awake
+ * target.
+ *
+ * \param p is the player
+ * \param obj is the object
+ * \param throw is whether the object is to be thrown
+ * \param normal_damage is set to the damage against monsters that no brand or
+ * slay affects
+ * \param brand_damage must have z_info->brand_max entries, and is set to the
+ * damage against monsters affected by each brand the attack has; other
+ * entries are left alone
+ * \param slay_damage is the same for slays, with z_info->slay_max entries
+ * \param nonweap_slay is set to whether brands or slays from other equipment
+ * or from spells may add to the attack
+ * \return whether the attack has any brands or slays
+ *
+ * Damage is per round for melee weapons and ammunition and per throw for
+ * anything else, all times ten.  Calls for many objects can be made in one
+ * calc_bonuses_hold() window, so that only the weapon slot is worked out
+ * again each time.
+ */
+bool attack_expected_damage(struct player *p, const struct object *obj,
+		bool throw, int *normal_damage, int *brand_damage, int *slay_damage,
+		bool *nonweap_slay)
+{
+	struct object *bow = equipped_item_by_slot_name(p, "shooting");
+	bool weapon = tval_is_melee_weapon(obj) && !throw;
+	bool ammo = (p->state.ammo_tval == obj->tval) && bow && !throw;
+	int weapon_slot = slot_by_name(p, "weapon");
+	struct object *current_weapon = slot_object(p, weapon_slot);
+	struct player_state state;
+	int dice, die_average, deadliness, i;
+	bool *total_brands, *total_slays;
+	bool has_brands_or_slays = false;
+
+	*normal_damage = 0;
+	*nonweap_slay = false;
+
+	/* Finish if dice not known */
+	dice = obj->known->dd * 100;
+	if (!dice || !obj->known->ds) return false;
+
+	/* Calculate the player's hypothetical state, wielding a weapon */
+	if (weapon) {
+		p->body.slots[weapon_slot].obj = (struct object *) obj;
+	}
+	memcpy(&state, &p->state, sizeof(state));
+	state.stat_ind[STAT_STR] = 0;
+	state.stat_ind[STAT_DEX] = 0;
+	calc_bonuses(p, &state, true, false);
+	p->body.slots[weapon_slot].obj = current_weapon;
+
+	/* Add the average number of critical dice (x100) */
+	if (weapon) {
+		dice += critical_expected_dice(melee_criticals,
+			melee_hit_power(&state, obj->known), 240,
+			player_has(p, PF_ARMSMAN));
+	} else if (ammo) {
+		dice += critical_expected_dice(shot_criticals,
+			missile_hit_power(&state, obj->known, bow->known), 360,
+			player_has(p, PF_MARKSMAN));
+	} else if (of_has(obj->known->flags, OF_THROWING) &&
+			!tval_is_ammo(obj)) {
+		if (of_has(obj->known->flags, OF_PERFECT_BALANCE)) {
+			dice *= 2;
+		}
+		dice += critical_expected_dice(shot_criticals,
+			missile_hit_power(&state, obj->known, NULL) * 3 / 2, 360,
+			player_has(p, PF_MARKSMAN));
+		dice *= 2 + p->lev / 12;
+	}
+
+	/* Get the average value of a single damage die (x10) */
+	die_average = 5 * (obj->known->ds + 1);
+	if (ammo) {
+		die_average *= state.ammo_mult;
+	}
+
+	/* Apply deadliness to the average (x1000) */
+	if (ammo) {
+		deadliness = obj->known->to_d + bow->known->to_d + state.to_d;
+	} else if (weapon || of_has(obj->known->flags, OF_THROWING)) {
+		deadliness = obj->known->to_d + state.to_d;
+	} else {
+		deadliness = obj->known->to_d;
+	}
+	apply_deadliness(&die_average, MIN(deadliness, 150));
+
+	/* Get the brands and slays */
+	total_brands = mem_zalloc(z_info->brand_max * sizeof(bool));
+	total_slays = mem_zalloc(z_info->slay_max * sizeof(bool));
+	copy_brands(&total_brands, obj->known->brands);
+	copy_slays(&total_slays, obj->known->slays);
+	if (ammo) {
+		copy_brands(&total_brands, bow->known->brands);
+		copy_slays(&total_slays, bow->known->slays);
+	}
+
+	/* Melee weapons may get slays and brands from other items */
+	if (weapon) {
+		for (i = 2; i < p->body.count; i++) {
+			struct object *slot_obj = slot_object(p, i);
+
+			if (!slot_obj) continue;
+			if (!slot_obj->known->brands && !slot_obj->known->slays)
+				continue;
+			*nonweap_slay = true;
+			copy_brands(&total_brands, slot_obj->known->brands);
+			copy_slays(&total_slays, slot_obj->known->slays);
+		}
+	}
+
+	/* Each hit gets multiplied dice and an addition */
+	for (i = 1; i < z_info->brand_max; i++) {
+		int mult = brands[i].multiplier;
+
+		/* Must have the brand, possibly from a spell */
+		if (player_has_temporary_brand(p, i)) {
+			*nonweap_slay = true;
+		} else if (!total_brands[i]) {
+			continue;
+		}
+		has_brands_or_slays = true;
+		brand_damage[i] = expected_per_round(
+			dice * (die_average * mult / 1000) + (mult - 10) * 1000,
+			weapon, ammo, &state);
+	}
+	for (i = 1; i < z_info->slay_max; i++) {
+		int mult = slays[i].multiplier;
+
+		/* Must have the slay, possibly from a spell */
+		if (player_has_temporary_slay(p, i)) {
+			*nonweap_slay = true;
+		} else if (!total_slays[i]) {
+			continue;
+		}
+		has_brands_or_slays = true;
+		slay_damage[i] = expected_per_round(
+			dice * (die_average * mult / 1000) + (mult - 10) * 1000,
+			weapon, ammo, &state);
+	}
+
+	/* Normal damage, not considering brands or slays */
+	*normal_damage = expected_per_round(dice * (die_average / 100), weapon,
+		ammo, &state);
+
+	mem_free(total_brands);
+	mem_free(total_slays);
+	return has_brands_or_slays;
+}
+
 /**
  * ------------------------------------------------------------------------
  * Non-damage melee blow effects
@@ -908,21 +1176,21 @@ bool py_attack_real(struct player *p, struct loc grid, bool *fear)
 		weight = 0;
 	}
 
-	/* Best attack from all slays or brands on all non-launcher equipment */
-	b = 0;
-	s = 0;
+	/* Best attack from all slays or brands on all non-launcher equipment,
+	 * then the weapon, then temporary ones */
+	attack_profile_begin(&melee_profile, false);
 	for (j = 2; j < p->body.count; j++) {
 		struct object *obj_local = slot_object(p, j);
 		if (obj_local) {
-			improve_attack_modifier(p, obj_local, mon, &b, &s, verb, false);
+			attack_profile_add(&melee_profile, p, obj_local);
 		}
 	}
-
-	/* Get the best attack from all slays or brands - weapon or temporary */
 	if (obj) {
-		improve_attack_modifier(p, obj, mon, &b, &s, verb, false);
+		attack_profile_add(&melee_profile, p, obj);
 	}
-	improve_attack_modifier(p, NULL, mon, &b, &s, verb, false);
+	attack_profile_add(&melee_profile, p, NULL);
+	attack_profile_end(&melee_profile);
+	attack_profile_choose(&melee_profile, mon, &b, &s, verb);
 
 	if (player_has(p, PF_UNARMED_COMBAT) || player_has(p, PF_MARTIAL_ARTS)) {
 		dmg = unarmed_damage(p, mon->race, chance + sleeping_bonus,
@@ -1462,8 +1730,11 @@ static struct attack_result make_ranged_shot(struct player *p,
 
 	result.success = true;
 
-	improve_attack_modifier(p, ammo, mon, &b, &s, result.hit_verb, true);
-	improve_attack_modifier(p, bow, mon, &b, &s, result.hit_verb, true);
+	attack_profile_begin(&shot_profile, true);
+	attack_profile_add(&shot_profile, p, ammo);
+	attack_profile_add(&shot_profile, p, bow);
+	attack_profile_end(&shot_profile);
+	attack_profile_choose(&shot_profile, mon, &b, &s, result.hit_verb);
 
 	result.dmg = ranged_damage(p, mon, ammo, bow, b, s, result.s_bonus,
 							   &result.msg_type, &result.marksman, tries);
@@ -1503,7 +1774,10 @@ static struct attack_result make_ranged_throw(struct player *p,
 
 	result.success = true;
 
-	improve_attack_modifier(p, obj, mon, &b, &s, result.hit_verb, true);
+	attack_profile_begin(&throw_profile, true);
+	attack_profile_add(&throw_profile, p, obj);
+	attack_profile_end(&throw_profile);
+	attack_profile_choose(&throw_profile, mon, &b, &s, result.hit_verb);
 
 	result.dmg = ranged_damage(p, mon, obj, NULL, b, s, result.s_bonus,
 							   &result.msg_type, &result.marksman, tries);
@@ -74,6 +74,9 @@ int chance_of_melee_hit_base(const struct player *p,
 extern bool test_hit(int to_hit, int ac);
 void hit_chance(random_chance *, int, int);
 void apply_deadliness(int *die_average, int deadliness);
+bool attack_expected_damage(struct player *p, const struct object *obj,
+	bool throw, int *normal_damage, int *brand_damage, int *slay_damage,
+	bool *nonweap_slay);
 extern void py_attack(struct player *p, struct loc grid);
 extern bool py_attack_real(struct player *p, struct loc grid, bool *fear);
 
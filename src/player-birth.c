@@ -1371,7 +1371,8 @@ void do_cmd_accept_character(struct command *cmd)
 
 	/* Generate random artifacts */
 	seed_randart = randint0(0x10000000);
-	initialize_random_artifacts(seed_randart);
+	randart_streams = true;
+	initialize_random_artifacts(seed_randart, randart_streams);
 	deactivate_randart_file();
 
 	/* Seed for flavors */
@@ -27,6 +27,7 @@
 #include "mon-msg.h"
 #include "mon-util.h"
 #include "obj-curse.h"
+#include "obj-desc.h"
 #include "obj-gear.h"
 #include "obj-ignore.h"
 #include "obj-knowledge.h"
@@ -39,6 +40,7 @@
 #include "player-spell.h"
 #include "player-timed.h"
 #include "player-util.h"
+#include "z-profile.h"
 
 /**
  * Stat Table (INT) -- Magic devices
@@ -2072,6 +2074,417 @@ static void calc_shapechange(struct player_state *state,
 	}
 }
 
+/**
+ * Most resistance factors one equipment slot's bonuses can record for one
+ * element; a slot needing more is handled uncached
+ */
+#define SLOT_RESISTS 4
+
+/**
+ * Equipment slots which can have their bonuses remembered
+ */
+#define SLOT_BONUS_MAX 24
+
+/**
+ * What the objects in one equipment slot add to the player's state
+ */
+struct slot_bonuses {
+	/* What these were worked out for */
+	u32b generation;
+	const struct object *obj;
+	bool armor_mast;
+	bool shield_mast;
+
+	bitflag flags[OF_SIZE];
+	int stat_add[STAT_MAX];
+	int skills[SKILL_MAX];
+	int see_infra;
+	int speed;
+	int dam_red;
+	int blows;
+	int shots;
+	int might;
+	int moves;
+	int ac;
+	int to_a;
+	int to_h;
+	int to_d;
+	int armor_weight;
+
+	/* Resistance factors, in the order they apply */
+	bool res_overflow;
+	byte num_res[ELEM_MAX];
+	s16b res[ELEM_MAX][SLOT_RESISTS];
+};
+
+/**
+ * Slot bonuses from earlier calls to calc_bonuses(), for true and known
+ * object information.  They are only reused while bonus_generation stays
+ * the same, which it only does between calc_bonuses_hold() and
+ * calc_bonuses_release().  Outside those windows, including the two calls
+ * from update_bonuses(), every slot is worked out afresh: gear, curses, rune
+ * knowledge and timed effects change in too many places to keep a generation
+ * for them.
+ */
+static struct slot_bonuses slot_bonus_cache[2][SLOT_BONUS_MAX];
+static u32b bonus_generation = 1;
+static int bonus_hold;
+
+/**
+ * Start a run of calc_bonuses() calls which differ only in the stat index
+ * offsets asked for or in which objects are put in equipment slots; each
+ * slot's contribution is worked out once for each object tried in it.
+ * Nothing else about the player or their gear may change before the
+ * matching calc_bonuses_release().
+ */
+void calc_bonuses_hold(void)
+{
+	if (bonus_hold++ == 0) {
+		if (++bonus_generation == 0) bonus_generation = 1;
+	}
+}
+
+/**
+ * End a run of calc_bonuses() calls started by calc_bonuses_hold()
+ */
+void calc_bonuses_release(void)
+{
+	assert(bonus_hold > 0);
+	bonus_hold--;
+}
+
+/**
+ * Get the next object whose properties apply from an equipment slot, which
+ * is the slot's object followed by any curse objects it carries
+ */
+static struct object *slot_next_object(struct curse_data *curse, int *index)
+{
+	if (!curse) return NULL;
+	for ((*index)++; *index < z_info->curse_max; (*index)++) {
+		if (curse[*index].power) return curses[*index].obj;
+	}
+	return NULL;
+}
+
+/**
+ * Work out what the objects in an equipment slot add to the player's state
+ */
+static void calc_slot_bonuses(struct player *p, int slot, bool known_only,
+		bool armor_mast, bool shield_mast, struct slot_bonuses *b)
+{
+	int j, index = 0;
+	struct object *obj = slot_object(p, slot);
+	struct curse_data *curse = obj ? obj->curses : NULL;
+	bitflag f[OF_SIZE];
+
+	memset(b, 0, sizeof(*b));
+	b->obj = obj;
+	b->armor_mast = armor_mast;
+	b->shield_mast = shield_mast;
+
+	for (; obj; obj = slot_next_object(curse, &index)) {
+		int dig = 0;
+
+		/* Extract the item flags */
+		if (known_only) {
+			object_flags_known(obj, f);
+		} else {
+			object_flags(obj, f);
+		}
+		of_union(b->flags, f);
+
+		/* Apply modifiers */
+		b->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
+			* p->obj_k->modifiers[OBJ_MOD_STR];
+		b->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
+			* p->obj_k->modifiers[OBJ_MOD_INT];
+		b->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
+			* p->obj_k->modifiers[OBJ_MOD_WIS];
+		b->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
+			* p->obj_k->modifiers[OBJ_MOD_DEX];
+		b->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
+			* p->obj_k->modifiers[OBJ_MOD_CON];
+		b->skills[SKILL_STEALTH] += obj->modifiers[OBJ_MOD_STEALTH]
+			* p->obj_k->modifiers[OBJ_MOD_STEALTH];
+		b->skills[SKILL_SEARCH] += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
+			* p->obj_k->modifiers[OBJ_MOD_SEARCH];
+		b->skills[SKILL_DEVICE] +=
+			(obj->modifiers[OBJ_MOD_MAGIC_MASTERY] * 5) *
+			p->obj_k->modifiers[OBJ_MOD_SEARCH];
+
+		b->see_infra += obj->modifiers[OBJ_MOD_INFRA]
+			* p->obj_k->modifiers[OBJ_MOD_INFRA];
+		if (tval_is_digger(obj)) {
+			if (of_has(obj->flags, OF_DIG_1))
+				dig = 1;
+			else if (of_has(obj->flags, OF_DIG_2))
+				dig = 2;
+			else if (of_has(obj->flags, OF_DIG_3))
+				dig = 3;
+		}
+		dig += obj->modifiers[OBJ_MOD_TUNNEL]
+			* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
+		b->skills[SKILL_DIGGING] += (dig * 20);
+		b->speed += obj->modifiers[OBJ_MOD_SPEED]
+			* p->obj_k->modifiers[OBJ_MOD_SPEED];
+		b->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
+			* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
+		b->blows += obj->modifiers[OBJ_MOD_BLOWS]
+			* p->obj_k->modifiers[OBJ_MOD_BLOWS];
+		b->shots += obj->modifiers[OBJ_MOD_SHOTS]
+			* p->obj_k->modifiers[OBJ_MOD_SHOTS];
+		b->might += obj->modifiers[OBJ_MOD_MIGHT]
+			* p->obj_k->modifiers[OBJ_MOD_MIGHT];
+		b->moves += obj->modifiers[OBJ_MOD_MOVES]
+			* p->obj_k->modifiers[OBJ_MOD_MOVES];
+
+		/* Note element info; a factor of 100 changes nothing */
+		for (j = 0; j < ELEM_MAX; j++) {
+			int res = known_only ? obj->known->el_info[j].res_level :
+				obj->el_info[j].res_level;
+
+			if (res == 100) continue;
+			if (b->num_res[j] == SLOT_RESISTS) {
+				b->res_overflow = true;
+			} else {
+				b->res[j][b->num_res[j]++] = res;
+			}
+		}
+
+		/* Apply combat bonuses */
+		b->ac += obj->ac;
+		if (slot_type_is(p, slot, EQUIP_BODY_ARMOR) && armor_mast) {
+			b->ac += (obj->ac * 2) / 3;
+		}
+		if (slot_type_is(p, slot, EQUIP_SHIELD) && shield_mast) {
+			b->ac += obj->ac;
+		}
+		if (!known_only || obj->known->to_a) {
+			b->to_a += obj->to_a;
+		}
+		if (!slot_type_is(p, slot, EQUIP_WEAPON)
+				&& !slot_type_is(p, slot, EQUIP_BOW)) {
+			if (!known_only || obj->known->to_h) {
+				b->to_h += obj->to_h;
+			}
+			if (!known_only || obj->known->to_d) {
+				b->to_d += obj->to_d;
+			}
+		}
+
+		/* Calculate armor weight */
+		if (tval_is_armor(obj)) {
+			b->armor_weight += obj->weight;
+		}
+	}
+}
+
+/**
+ * Add what the objects in an equipment slot contribute to the player's
+ * state, reusing the last calculation for the slot if it still holds
+ */
+static void apply_slot_bonuses(struct player *p, struct player_state *state,
+		int slot, bool known_only, bitflag *collect_f, int *blows, int *shots,
+		int *might, int *moves, int *armor_weight)
+{
+	struct slot_bonuses local, *b = &local;
+	bool armor_mast = pf_has(state->pflags, PF_ARMOR_MAST);
+	bool shield_mast = pf_has(state->pflags, PF_SHIELD_MAST);
+	int i, j;
+
+	if (slot < SLOT_BONUS_MAX) {
+		b = &slot_bonus_cache[known_only ? 1 : 0][slot];
+		if (!bonus_hold || b->generation != bonus_generation ||
+			b->obj != slot_object(p, slot) || b->armor_mast != armor_mast ||
+			b->shield_mast != shield_mast) {
+			calc_slot_bonuses(p, slot, known_only, armor_mast, shield_mast, b);
+			b->generation = bonus_hold ? bonus_generation : 0;
+		}
+	} else {
+		calc_slot_bonuses(p, slot, known_only, armor_mast, shield_mast, b);
+	}
+
+	of_union(collect_f, b->flags);
+	for (i = 0; i < STAT_MAX; i++) {
+		state->stat_add[i] += b->stat_add[i];
+	}
+	for (i = 0; i < SKILL_MAX; i++) {
+		state->skills[i] += b->skills[i];
+	}
+	state->see_infra += b->see_infra;
+	state->speed += b->speed;
+	state->dam_red += b->dam_red;
+	*blows += b->blows;
+	*shots += b->shots;
+	*might += b->might;
+	*moves += b->moves;
+	state->ac += b->ac;
+	state->to_a += b->to_a;
+	state->to_h += b->to_h;
+	state->to_d += b->to_d;
+	*armor_weight += b->armor_weight;
+
+	/* Apply element info, noting vulnerabilites for later processing */
+	if (b->res_overflow) {
+		struct object *obj = slot_object(p, slot);
+		struct curse_data *curse = obj ? obj->curses : NULL;
+		int index = 0;
+
+		for (; obj; obj = slot_next_object(curse, &index)) {
+			for (j = 0; j < ELEM_MAX; j++) {
+				apply_resist(&state->el_info[j].res_level, known_only ?
+							 obj->known->el_info[j].res_level :
+							 obj->el_info[j].res_level);
+			}
+		}
+	} else {
+		for (j = 0; j < ELEM_MAX; j++) {
+			for (i = 0; i < b->num_res[j]; i++) {
+				apply_resist(&state->el_info[j].res_level, b->res[j][i]);
+			}
+		}
+	}
+}
+
+/**
+ * Apply the effects of hunger and of timed effects to the player's state;
+ * enhance is whether the player has the Enhance Magic specialty
+ */
+static void calc_timed_effects(struct player *p, struct player_state *state,
+		bool update, bool enhance, int *extra_blows)
+{
+	/* Effects of food outside the "Fed" range */
+	if (!player_timed_grade_eq(p, TMD_FOOD, "Fed")) {
+		int excess = p->timed[TMD_FOOD] - PY_FOOD_FULL;
+		int lack = PY_FOOD_HUNGRY - p->timed[TMD_FOOD];
+		if ((excess > 0) && !p->timed[TMD_ATT_VAMP]) {
+			/* Scale to units 1/10 of the range and subtract from speed */
+			excess = (excess * 10) / (PY_FOOD_MAX - PY_FOOD_FULL);
+			state->speed -= excess;
+		} else if (lack > 0) {
+			/* Scale to units 1/20 of the range */
+			lack = (lack * 20) / PY_FOOD_HUNGRY;
+
+			/* Apply effects progressively */
+			state->to_h -= lack;
+			state->to_d -= lack;
+			if ((lack > 10) && (lack <= 15)) {
+				adjust_skill_scale(&state->skills[SKILL_DEVICE],
+					-1, 10, 0);
+			} else if ((lack > 15) && (lack <= 18)) {
+				adjust_skill_scale(&state->skills[SKILL_DEVICE],
+					-1, 5, 0);
+				state->skills[SKILL_DISARM_PHYS] *= 9;
+				state->skills[SKILL_DISARM_PHYS] /= 10;
+				state->skills[SKILL_DISARM_MAGIC] *= 9;
+				state->skills[SKILL_DISARM_MAGIC] /= 10;
+			} else if (lack > 18) {
+				adjust_skill_scale(&state->skills[SKILL_DEVICE],
+					-3, 10, 0);
+				state->skills[SKILL_DISARM_PHYS] *= 8;
+				state->skills[SKILL_DISARM_PHYS] /= 10;
+				state->skills[SKILL_DISARM_MAGIC] *= 8;
+				state->skills[SKILL_DISARM_MAGIC] /= 10;
+				state->skills[SKILL_SAVE] *= 9;
+				state->skills[SKILL_SAVE] /= 10;
+				state->skills[SKILL_SEARCH] *=9;
+				state->skills[SKILL_SEARCH] /= 10;
+			}
+		}
+	}
+
+	/* Other timed effects */
+	player_flags_timed(p, state->flags);
+
+	if (player_timed_grade_eq(p, TMD_STUN, "Heavy Stun")) {
+		state->to_h -= 20;
+		state->to_d -= 20;
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 5, 0);
+		if (update) {
+			p->timed[TMD_FASTCAST] = 0;
+		}
+	} else if (player_timed_grade_eq(p, TMD_STUN, "Stun")) {
+		state->to_h -= 5;
+		state->to_d -= 5;
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 10, 0);
+		if (update) {
+			p->timed[TMD_FASTCAST] = 0;
+		}
+	}
+	if (p->timed[TMD_INVULN]) {
+		state->to_a += 100;
+	}
+	if (p->timed[TMD_BLESSED]) {
+		state->to_a += enhance ? 10 : 5;
+		state->to_h += enhance ? 15 : 10;
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], 1, 20, 0);
+	}
+	if (p->timed[TMD_SHIELD]) {
+		state->to_a += enhance ? 65 : 50;
+	}
+	if (p->timed[TMD_STONESKIN]) {
+		state->to_a += 40;
+		state->speed -= 5;
+	}
+	if (p->timed[TMD_HERO]) {
+		of_on(state->flags, OF_PROT_FEAR);
+		state->to_h += enhance ? 18 : 12;
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], 1, 20, 0);
+	}
+	if (p->timed[TMD_SHERO]) {
+		of_on(state->flags, OF_PROT_FEAR);
+		state->skills[SKILL_TO_HIT_MELEE] += enhance ? 90 : 72;
+		state->to_a -= 10;
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 10, 0);
+	}
+	if (p->timed[TMD_FAST] || p->timed[TMD_SPRINT]) {
+		state->speed += enhance ? 13 : 10;
+	}
+	if (p->timed[TMD_SLOW]) {
+		state->speed -= 10;
+	}
+	if (p->timed[TMD_SINFRA]) {
+		state->see_infra += enhance ? 8 : 5;
+	}
+	if (p->timed[TMD_TERROR]) {
+		state->speed += 10;
+	}
+	if (p->timed[TMD_OPP_ACID]) {
+		apply_resist(&state->el_info[ELEM_ACID].res_level, RES_BOOST_NORMAL);
+	}
+	if (p->timed[TMD_OPP_ELEC]) {
+		apply_resist(&state->el_info[ELEM_ELEC].res_level, RES_BOOST_NORMAL);
+	}
+	if (p->timed[TMD_OPP_FIRE]) {
+		apply_resist(&state->el_info[ELEM_FIRE].res_level, RES_BOOST_NORMAL);
+	}
+	if (p->timed[TMD_OPP_COLD]) {
+		apply_resist(&state->el_info[ELEM_COLD].res_level, RES_BOOST_NORMAL);
+	}
+	if (p->timed[TMD_OPP_POIS]) {
+		apply_resist(&state->el_info[ELEM_POIS].res_level, RES_BOOST_NORMAL);
+	}
+	if (p->timed[TMD_CONFUSED]) {
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 4, 0);
+	}
+	if (p->timed[TMD_AMNESIA]) {
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 5, 0);
+	}
+	if (p->timed[TMD_POISONED]) {
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 20, 0);
+	}
+	if (p->timed[TMD_IMAGE]) {
+		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 5, 0);
+	}
+	if (p->timed[TMD_BLOODLUST]) {
+		state->to_d += p->timed[TMD_BLOODLUST] / 2;
+		*extra_blows += p->timed[TMD_BLOODLUST] / 20;
+	}
+	if (p->timed[TMD_STEALTH]) {
+		state->skills[SKILL_STEALTH] += enhance ? 13 : 10;
+	}
+}
+
 /**
  * Calculate the players current "state", taking into account
  * not only race/class intrinsics, but also objects being worn
@@ -2106,7 +2519,6 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	int topography = world ? world->levels[p->place].topography : 0;
 	struct object *launcher = equipped_item_by_slot_name(p, "shooting");
 	struct object *weapon = equipped_item_by_slot_name(p, "weapon");
-	bitflag f[OF_SIZE];
 	bitflag collect_f[OF_SIZE];
 
 	/* Hack to allow calculating hypothetical blows for extra STR, DEX - NRM */
@@ -2116,6 +2528,8 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	/* Specialty ability Enhance Magic */
 	bool enhance = player_has(p, PF_ENHANCE_MAGIC);
 
+	PROFILE_BEGIN(CALC_BONUSES);
+
 	/* Reset */
 	memset(state, 0, sizeof *state);
 
@@ -2143,121 +2557,8 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 
 	/* Analyze equipment */
 	for (i = 0; i < p->body.count; i++) {
-		int index = 0;
-		struct object *obj = slot_object(p, i);
-		struct curse_data *curse = obj ? obj->curses : NULL;
-
-		while (obj) {
-			int dig = 0;
-
-			/* Extract the item flags */
-			if (known_only) {
-				object_flags_known(obj, f);
-			} else {
-				object_flags(obj, f);
-			}
-			of_union(collect_f, f);
-
-			/* Apply modifiers */
-			state->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
-				* p->obj_k->modifiers[OBJ_MOD_STR];
-			state->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
-				* p->obj_k->modifiers[OBJ_MOD_INT];
-			state->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
-				* p->obj_k->modifiers[OBJ_MOD_WIS];
-			state->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
-				* p->obj_k->modifiers[OBJ_MOD_DEX];
-			state->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
-				* p->obj_k->modifiers[OBJ_MOD_CON];
-			state->skills[SKILL_STEALTH] += obj->modifiers[OBJ_MOD_STEALTH]
-				* p->obj_k->modifiers[OBJ_MOD_STEALTH];
-			state->skills[SKILL_SEARCH] += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
-				* p->obj_k->modifiers[OBJ_MOD_SEARCH];
-			state->skills[SKILL_DEVICE] +=
-				(obj->modifiers[OBJ_MOD_MAGIC_MASTERY] * 5) *
-				p->obj_k->modifiers[OBJ_MOD_SEARCH];
-
-			state->see_infra += obj->modifiers[OBJ_MOD_INFRA]
-				* p->obj_k->modifiers[OBJ_MOD_INFRA];
-			if (tval_is_digger(obj)) {
-				if (of_has(obj->flags, OF_DIG_1))
-					dig = 1;
-				else if (of_has(obj->flags, OF_DIG_2))
-					dig = 2;
-				else if (of_has(obj->flags, OF_DIG_3))
-					dig = 3;
-			}
-			dig += obj->modifiers[OBJ_MOD_TUNNEL]
-				* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
-			state->skills[SKILL_DIGGING] += (dig * 20);
-			state->speed += obj->modifiers[OBJ_MOD_SPEED]
-				* p->obj_k->modifiers[OBJ_MOD_SPEED];
-			state->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
-				* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
-			extra_blows += obj->modifiers[OBJ_MOD_BLOWS]
-				* p->obj_k->modifiers[OBJ_MOD_BLOWS];
-			extra_shots += obj->modifiers[OBJ_MOD_SHOTS]
-				* p->obj_k->modifiers[OBJ_MOD_SHOTS];
-			extra_might += obj->modifiers[OBJ_MOD_MIGHT]
-				* p->obj_k->modifiers[OBJ_MOD_MIGHT];
-			extra_moves += obj->modifiers[OBJ_MOD_MOVES]
-				* p->obj_k->modifiers[OBJ_MOD_MOVES];
-
-			/* Apply element info, noting vulnerabilites for later processing */
-			for (j = 0; j < ELEM_MAX; j++) {
-				if (known_only) {
-					apply_resist(&state->el_info[j].res_level,
-								 obj->known->el_info[j].res_level);
-				} else {
-					apply_resist(&state->el_info[j].res_level,
-								 obj->el_info[j].res_level);
-				}
-			}
-
-			/* Apply combat bonuses */
-			state->ac += obj->ac;
-			if (slot_type_is(p, i, EQUIP_BODY_ARMOR) &&
-				pf_has(state->pflags, PF_ARMOR_MAST)) {
-				state->ac += (obj->ac * 2) / 3;
-			}
-			if (slot_type_is(p, i, EQUIP_SHIELD) &&
-				pf_has(state->pflags, PF_SHIELD_MAST)) {
-				state->ac += obj->ac;
-			}
-			if (!known_only || obj->known->to_a) {
-				state->to_a += obj->to_a;
-			}
-			if (!slot_type_is(p, i, EQUIP_WEAPON)
-					&& !slot_type_is(p, i, EQUIP_BOW)) {
-				if (!known_only || obj->known->to_h) {
-					state->to_h += obj->to_h;
-				}
-				if (!known_only || obj->known->to_d) {
-					state->to_d += obj->to_d;
-				}
-			}
-
-			/* Calculate armor weight */
-			if (tval_is_armor(obj)) {
-				armor_weight += obj->weight;
-			}
-
-			/* Move to any unprocessed curse object */
-			if (curse) {
-				index++;
-				obj = NULL;
-				while (index < z_info->curse_max) {
-					if (curse[index].power) {
-						obj = curses[index].obj;
-						break;
-					} else {
-						index++;
-					}
-				}
-			} else {
-				obj = NULL;
-			}
-		}
+		apply_slot_bonuses(p, state, i, known_only, collect_f, &extra_blows,
+			&extra_shots, &extra_might, &extra_moves, &armor_weight);
 	}
 
 	/* Apply the collected flags */
@@ -2409,136 +2710,8 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 		}
 	}
 
-	/* Effects of food outside the "Fed" range */
-	if (!player_timed_grade_eq(p, TMD_FOOD, "Fed")) {
-		int excess = p->timed[TMD_FOOD] - PY_FOOD_FULL;
-		int lack = PY_FOOD_HUNGRY - p->timed[TMD_FOOD];
-		if ((excess > 0) && !p->timed[TMD_ATT_VAMP]) {
-			/* Scale to units 1/10 of the range and subtract from speed */
-			excess = (excess * 10) / (PY_FOOD_MAX - PY_FOOD_FULL);
-			state->speed -= excess;
-		} else if (lack > 0) {
-			/* Scale to units 1/20 of the range */
-			lack = (lack * 20) / PY_FOOD_HUNGRY;
-
-			/* Apply effects progressively */
-			state->to_h -= lack;
-			state->to_d -= lack;
-			if ((lack > 10) && (lack <= 15)) {
-				adjust_skill_scale(&state->skills[SKILL_DEVICE],
-					-1, 10, 0);
-			} else if ((lack > 15) && (lack <= 18)) {
-				adjust_skill_scale(&state->skills[SKILL_DEVICE],
-					-1, 5, 0);
-				state->skills[SKILL_DISARM_PHYS] *= 9;
-				state->skills[SKILL_DISARM_PHYS] /= 10;
-				state->skills[SKILL_DISARM_MAGIC] *= 9;
-				state->skills[SKILL_DISARM_MAGIC] /= 10;
-			} else if (lack > 18) {
-				adjust_skill_scale(&state->skills[SKILL_DEVICE],
-					-3, 10, 0);
-				state->skills[SKILL_DISARM_PHYS] *= 8;
-				state->skills[SKILL_DISARM_PHYS] /= 10;
-				state->skills[SKILL_DISARM_MAGIC] *= 8;
-				state->skills[SKILL_DISARM_MAGIC] /= 10;
-				state->skills[SKILL_SAVE] *= 9;
-				state->skills[SKILL_SAVE] /= 10;
-				state->skills[SKILL_SEARCH] *=9;
-				state->skills[SKILL_SEARCH] /= 10;
-			}
-		}
-	}
-
-	/* Other timed effects */
-	player_flags_timed(p, state->flags);
-
-	if (player_timed_grade_eq(p, TMD_STUN, "Heavy Stun")) {
-		state->to_h -= 20;
-		state->to_d -= 20;
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 5, 0);
-		if (update) {
-			p->timed[TMD_FASTCAST] = 0;
-		}
-	} else if (player_timed_grade_eq(p, TMD_STUN, "Stun")) {
-		state->to_h -= 5;
-		state->to_d -= 5;
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 10, 0);
-		if (update) {
-			p->timed[TMD_FASTCAST] = 0;
-		}
-	}
-	if (p->timed[TMD_INVULN]) {
-		state->to_a += 100;
-	}
-	if (p->timed[TMD_BLESSED]) {
-		state->to_a += enhance ? 10 : 5;
-		state->to_h += enhance ? 15 : 10;
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], 1, 20, 0);
-	}
-	if (p->timed[TMD_SHIELD]) {
-		state->to_a += enhance ? 65 : 50;
-	}
-	if (p->timed[TMD_STONESKIN]) {
-		state->to_a += 40;
-		state->speed -= 5;
-	}
-	if (p->timed[TMD_HERO]) {
-		of_on(state->flags, OF_PROT_FEAR);
-		state->to_h += enhance ? 18 : 12;
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], 1, 20, 0);
-	}
-	if (p->timed[TMD_SHERO]) {
-		of_on(state->flags, OF_PROT_FEAR);
-		state->skills[SKILL_TO_HIT_MELEE] += enhance ? 90 : 72;
-		state->to_a -= 10;
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 10, 0);
-	}
-	if (p->timed[TMD_FAST] || p->timed[TMD_SPRINT]) {
-		state->speed += enhance ? 13 : 10;
-	}
-	if (p->timed[TMD_SLOW]) {
-		state->speed -= 10;
-	}
-	if (p->timed[TMD_SINFRA]) {
-		state->see_infra += enhance ? 8 : 5;
-	}
-	if (p->timed[TMD_TERROR]) {
-		state->speed += 10;
-	}
-	if (p->timed[TMD_OPP_ACID]) {
-		apply_resist(&state->el_info[ELEM_ACID].res_level, RES_BOOST_NORMAL);
-	}
-	if (p->timed[TMD_OPP_ELEC]) {
-		apply_resist(&state->el_info[ELEM_ELEC].res_level, RES_BOOST_NORMAL);
-	}
-	if (p->timed[TMD_OPP_FIRE]) {
-		apply_resist(&state->el_info[ELEM_FIRE].res_level, RES_BOOST_NORMAL);
-	}
-	if (p->timed[TMD_OPP_COLD]) {
-		apply_resist(&state->el_info[ELEM_COLD].res_level, RES_BOOST_NORMAL);
-	}
-	if (p->timed[TMD_OPP_POIS]) {
-		apply_resist(&state->el_info[ELEM_POIS].res_level, RES_BOOST_NORMAL);
-	}
-	if (p->timed[TMD_CONFUSED]) {
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 4, 0);
-	}
-	if (p->timed[TMD_AMNESIA]) {
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 5, 0);
-	}
-	if (p->timed[TMD_POISONED]) {
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 20, 0);
-	}
-	if (p->timed[TMD_IMAGE]) {
-		adjust_skill_scale(&state->skills[SKILL_DEVICE], -1, 5, 0);
-	}
-	if (p->timed[TMD_BLOODLUST]) {
-		state->to_d += p->timed[TMD_BLOODLUST] / 2;
-		extra_blows += p->timed[TMD_BLOODLUST] / 20;
-	}
-	if (p->timed[TMD_STEALTH]) {
-		state->skills[SKILL_STEALTH] += enhance ? 13 : 10;
-	}
+	/* Timed effects */
+	calc_timed_effects(p, state, update, enhance, &extra_blows);
 
 	/* Analyze flags - check for fear */
 	if (of_has(state->flags, OF_AFRAID)) {
@@ -2713,7 +2886,7 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	/* Movement speed */
 	state->num_moves = extra_moves;
 
-	return;
+	PROFILE_END(CALC_BONUSES);
 }
 
 /**
@@ -2940,6 +3113,11 @@ void notice_stuff(struct player *p)
 	if (p->upkeep->notice & PN_IGNORE) {
 		p->upkeep->notice &= ~(PN_IGNORE);
 		ignore_drop(p);
+
+		/* Floor objects may have been ignored or unignored */
+		map_render_forget_all();
+		object_desc_forget_all();
+		p->upkeep->redraw |= PR_MAP;
 	}
 
 	/* Combine the pack */
@@ -3110,6 +3288,23 @@ void redraw_stuff(struct player *p)
 	if (redraw & PR_MAP) {
 		/* Mark the whole map to be redrawn */
 		event_signal_point(EVENT_MAP, -1, -1);
+		if (p->cave) {
+			p->upkeep->known_drawn = p->cave->journal.next;
+		}
+	} else if ((redraw & PR_KNOWN) && p->cave) {
+		const struct known_change *changes;
+		int i, n;
+
+		/* Mark just the grids the player has learned about */
+		if (cave_journal_read(p->cave, &p->upkeep->known_drawn,
+				&changes, &n)) {
+			for (i = 0; i < n; i++) {
+				event_signal_point(EVENT_MAP, changes[i].grid.x,
+					changes[i].grid.y);
+			}
+		} else {
+			event_signal_point(EVENT_MAP, -1, -1);
+		}
 	}
 
 	p->upkeep->redraw &= ~redraw;
@@ -75,6 +75,7 @@
 #define PR_ITEMLIST		0x00800000L /* Display item list */
 #define PR_FEELING		0x01000000L /* Display level feeling */
 #define PR_LIGHT		0x02000000L /* Display light level */
+#define PR_KNOWN		0x04000000L /* Redraw grids whose knowledge changed */
 
 /**
  * Display Basic Info
@@ -107,6 +108,8 @@ extern const int adj_str_hold[STAT_RANGE];
 bool earlier_object(struct object *orig, struct object *new, bool store);
 int equipped_item_slot(struct player_body body, struct object *obj);
 void calc_inventory(struct player *p);
+void calc_bonuses_hold(void);
+void calc_bonuses_release(void);
 void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 				  bool update);
 void calc_digging_chances(struct player_state *state, int chances[DIGGING_MAX]);
@@ -51,9 +51,43 @@
 static struct loc top_left, bottom_right;
 
 /**
- * Array of distances from the player
+ * Search state for a grid.  The entry only belongs to the current search if
+ * its stamp matches path_stamp, so the buffer never needs to be cleared.
  */
-static int path_distance[MAX_PF_RADIUS][MAX_PF_RADIUS];
+struct path_node {
+	u32b stamp;
+	int dist;		/* Distance from the player, -1 for invalid grids */
+	int heap_pos;	/* Index in path_heap, PATH_UNSEEN or PATH_CLOSED */
+};
+
+#define PATH_UNSEEN -1
+#define PATH_CLOSED -2
+
+/**
+ * Search buffers, sized for the current cave and reused between searches
+ */
+static struct path_node *path_nodes;
+static int *path_heap;
+static int path_heap_n;
+static int path_buf_size;
+static u32b path_stamp;
+
+/**
+ * Target of the current search
+ */
+static struct loc path_goal;
+
+/**
+ * Long distance travel in progress, if any
+ */
+enum {
+	TRAVEL_NONE = 0,
+	TRAVEL_LOCATION,
+	TRAVEL_EXPLORE
+};
+
+static int travel_mode;
+static struct loc travel_goal;
 
 /**
  * Pathfinding results
@@ -82,10 +116,17 @@ static bool is_valid_pf(struct loc grid)
 }
 
 /**
- * Get pathfinding region
+ * Get pathfinding region; in the wilderness this is the whole level
  */
 static void get_pathfind_region(void)
 {
+	if ((level_topography(player->place) != TOP_CAVE) &&
+		(level_topography(player->place) != TOP_TOWN)) {
+		top_left = loc(0, 0);
+		bottom_right = loc(cave->width, cave->height);
+		return;
+	}
+
 	top_left.x = MAX(player->grid.x - MAX_PF_RADIUS / 2, 0);
 	top_left.y = MAX(player->grid.y - MAX_PF_RADIUS / 2, 0);
 
@@ -94,103 +135,254 @@ static void get_pathfind_region(void)
 }
 
 /**
- * Get the path distance info for a grid
+ * Check whether a grid is inside the pathfinding region
+ */
+static bool in_pathfind_region(struct loc grid)
+{
+	return (grid.x >= top_left.x) && (grid.x < bottom_right.x) &&
+		(grid.y >= top_left.y) && (grid.y < bottom_right.y);
+}
+
+/**
+ * Convert between grids and indices into the search buffers
+ */
+static int path_index(struct loc grid)
+{
+	return grid.y * cave->width + grid.x;
+}
+
+static struct loc path_grid(int n)
+{
+	return loc(n % cave->width, n / cave->width);
+}
+
+/**
+ * Start a new search, making sure the buffers cover the current cave
+ */
+static void path_search_start(void)
+{
+	int size = cave->height * cave->width;
+
+	if (size > path_buf_size) {
+		mem_free(path_nodes);
+		mem_free(path_heap);
+		path_nodes = mem_zalloc(size * sizeof(*path_nodes));
+		path_heap = mem_zalloc(size * sizeof(*path_heap));
+		path_buf_size = size;
+		path_stamp = 0;
+	}
+
+	/* On wrapping round, clear out any stale stamps */
+	if (++path_stamp == 0) {
+		memset(path_nodes, 0, path_buf_size * sizeof(*path_nodes));
+		path_stamp = 1;
+	}
+	path_heap_n = 0;
+}
+
+/**
+ * Get the search state for a grid in the region, initialising it if it was
+ * not yet part of this search
+ */
+static struct path_node *path_node(struct loc grid)
+{
+	struct path_node *node = &path_nodes[path_index(grid)];
+
+	if (node->stamp != path_stamp) {
+		node->stamp = path_stamp;
+		node->dist = is_valid_pf(grid) ? MAX_PF_LENGTH : -1;
+		node->heap_pos = PATH_UNSEEN;
+	}
+	return node;
+}
+
+/**
+ * Get the path distance info for a grid; grids the search never reached
+ * count as invalid
  */
 static int path_dist(struct loc grid)
 {
-	return path_distance[grid.y - top_left.y][grid.x - top_left.x];
+	struct path_node *node;
+
+	if (!in_pathfind_region(grid)) return -1;
+	node = &path_nodes[path_index(grid)];
+	if (node->stamp != path_stamp) return -1;
+	return node->dist;
 }
 
 /**
- * Set the path distance info for a grid
+ * Estimate of the remaining distance from a grid to the target.  Diagonal
+ * steps cost the same as orthogonal ones, so the octile distance reduces to
+ * the larger of the two offsets; it never overestimates and changes by at
+ * most one per step, so grids leave the open heap with their true distance.
  */
-static void set_path_dist(struct loc grid, int dist)
+static int path_estimate(struct loc grid)
 {
-	assert(grid.y >= top_left.y);
-	assert(grid.x >= top_left.x);
-	assert(grid.y < bottom_right.y);
-	assert(grid.x < bottom_right.x);
-	path_distance[grid.y - top_left.y][grid.x - top_left.x] = dist;
+	return MAX(ABS(grid.x - path_goal.x), ABS(grid.y - path_goal.y));
 }
 
 /**
- * Initialize terrain information
+ * Order two open grids: lower estimated total first, then the one further
+ * along
  */
-static void path_dist_info_init(void)
+static bool path_heap_before(int a, int b)
 {
-	struct loc grid;
+	struct loc ga, gb;
+	int fa, fb;
+
+	ga = path_grid(a);
+	gb = path_grid(b);
+	fa = path_nodes[a].dist + path_estimate(ga);
+	fb = path_nodes[b].dist + path_estimate(gb);
+	if (fa != fb) return fa < fb;
+	return path_nodes[a].dist > path_nodes[b].dist;
+}
+
+/**
+ * Put a grid at a heap position, recording the position in its node
+ */
+static void path_heap_set(int pos, int n)
+{
+	path_heap[pos] = n;
+	path_nodes[n].heap_pos = pos;
+}
+
+/**
+ * Move the grid at a heap position up until the heap is ordered
+ */
+static void path_heap_up(int pos)
+{
+	int n = path_heap[pos];
+
+	while (pos > 0) {
+		int parent = (pos - 1) / 2;
+		if (!path_heap_before(n, path_heap[parent])) break;
+		path_heap_set(pos, path_heap[parent]);
+		pos = parent;
+	}
+	path_heap_set(pos, n);
+}
+
+/**
+ * Move the grid at a heap position down until the heap is ordered
+ */
+static void path_heap_down(int pos)
+{
+	int n = path_heap[pos];
 
-	/* Set distance of all grids in the region to -1 */
-	for (grid.y = 0; grid.y < MAX_PF_RADIUS; grid.y++)
-		for (grid.x = 0; grid.x < MAX_PF_RADIUS; grid.x++)
-			path_distance[grid.y][grid.x] = -1;
+	while (2 * pos + 1 < path_heap_n) {
+		int child = 2 * pos + 1;
+		if (child + 1 < path_heap_n &&
+			path_heap_before(path_heap[child + 1], path_heap[child])) {
+			child++;
+		}
+		if (!path_heap_before(path_heap[child], n)) break;
+		path_heap_set(pos, path_heap[child]);
+		pos = child;
+	}
+	path_heap_set(pos, n);
+}
 
-	/* Set distance of valid grids to MAX_PF_LENGTH */
-	for (grid.y = top_left.y; grid.y < bottom_right.y; grid.y++)
-		for (grid.x = top_left.x; grid.x < bottom_right.x; grid.x++)
-			if (is_valid_pf(grid))
-				set_path_dist(grid, MAX_PF_LENGTH);
+/**
+ * Remove and return the best open grid
+ */
+static int path_heap_pop(void)
+{
+	int n = path_heap[0];
 
-	/* Set distance of the player's grid to 0 */
-	set_path_dist(player->grid, 0);
+	path_heap_n--;
+	if (path_heap_n > 0) {
+		path_heap_set(0, path_heap[path_heap_n]);
+		path_heap_down(0);
+	}
+	path_nodes[n].heap_pos = PATH_CLOSED;
+	return n;
 }
 
 /**
  * Try to find a path from the player's grid
  * \param grid the target grid
+ * \param quiet whether to fail without complaint
+ *
+ * This is an A* search outward from the player.  It doesn't stop as soon as
+ * the target is reached, but carries on until every grid which could be on
+ * a shortest path has its true distance.  That is what find_path() needs to
+ * step back along exactly the path a full breadth-first flood would give.
  */
-static bool set_up_path_distances(struct loc grid)
+static bool set_up_path_distances(struct loc grid, bool quiet)
 {
-	int i;
-	struct point_set *reached = point_set_new(MAX_PF_RADIUS * MAX_PF_RADIUS);
+	struct path_node *start;
+	int goal_dist = -1;
 
 	/* Initialize the pathfinding region */
 	get_pathfind_region();
-	path_dist_info_init();
+	path_search_start();
+	path_goal = grid;
 
 	/* Check bounds */
-	if ((grid.x >= top_left.x) && (grid.x < bottom_right.x) &&
-		(grid.y >= top_left.y) && (grid.y < bottom_right.y)) {
+	if (in_pathfind_region(grid)) {
 		if ((square(cave, grid)->mon > 0) &&
 			monster_is_visible(square_monster(cave, grid))) {
-			set_path_dist(grid, MAX_PF_LENGTH);
+			path_node(grid)->dist = MAX_PF_LENGTH;
 		}
 	} else {
-		bell("Target out of range.");
+		if (!quiet) bell("Target out of range.");
 		return false;
 	}
 
-	/* Add the player's grid to the set of marked grids */
-	add_to_point_set(reached, player->grid);
+	/* Start from the player's grid */
+	start = path_node(player->grid);
+	start->dist = 0;
+	path_heap_n = 1;
+	path_heap_set(0, path_index(player->grid));
+
+	while (path_heap_n > 0) {
+		int k, cur_distance, n;
+		struct loc cur;
+
+		/* Stop once nothing left open can be on a shortest path */
+		if (goal_dist >= 0) {
+			struct loc best;
+			best = path_grid(path_heap[0]);
+			if (path_nodes[path_heap[0]].dist + path_estimate(best) >
+				goal_dist) {
+				break;
+			}
+		}
+
+		n = path_heap_pop();
+		cur = path_grid(n);
+		cur_distance = path_nodes[n].dist + 1;
+		if (loc_eq(cur, grid)) goal_dist = path_nodes[n].dist;
+
+		/* Enforce length bounds */
+		if (cur_distance >= MAX_PF_LENGTH) continue;
 
-	/* Add the neighbours of any marked grid in the area */
-	for (i = 0; i < reached->n; i++) {
-		int k, cur_distance = path_dist(reached->pts[i]) + 1;
+		/* Add or improve the neighbours */
 		for (k = 0; k < 8; k++) {
-			struct loc next = loc_sum(reached->pts[i], ddgrid_ddd[k]);
-
-			/* Enforce length and area bounds */
-			if ((path_dist(next) <= cur_distance) ||
-				(path_dist(next) > MAX_PF_LENGTH) ||
-				(next.y < top_left.y) ||
-				(next.y >= bottom_right.y) ||
-				(next.x < top_left.x) ||
-				(next.x >= bottom_right.x)) {
-				continue;
-			}
+			struct loc next = loc_sum(cur, ddgrid_ddd[k]);
+			struct path_node *node;
+
+			/* Enforce area bounds */
+			if (!in_pathfind_region(next)) continue;
+
+			node = path_node(next);
+			if (node->dist <= cur_distance) continue;
+			if (node->heap_pos == PATH_CLOSED) continue;
 
 			/* Add the grid */
-			set_path_dist(next, cur_distance);
-			add_to_point_set(reached, next);
+			node->dist = cur_distance;
+			if (node->heap_pos == PATH_UNSEEN) {
+				path_heap_set(path_heap_n, path_index(next));
+				path_heap_n++;
+			}
+			path_heap_up(node->heap_pos);
 		}
 	}
 
-	/* Grid distances have been recorded, so we can get rid of the point set */
-	point_set_dispose(reached);
-
 	/* Failure to find a path */
 	if (path_dist(grid) == -1 || path_dist(grid) == MAX_PF_LENGTH) {
-		bell("Target space unreachable.");
+		if (!quiet) bell("Target space unreachable.");
 		return false;
 	}
 
@@ -201,14 +393,15 @@ static bool set_up_path_distances(struct loc grid)
 /**
  * Fill the array of path step directions
  * \param grid the target grid
+ * \param quiet whether to fail without complaint
  */
-bool find_path(struct loc grid)
+static bool find_path_aux(struct loc grid, bool quiet)
 {
 	struct loc new = grid;
 
 	/* Attempt to find a path if necessary */
 	if (loc_eq(new, player->grid)) return false;
-	if (!set_up_path_distances(grid)) return false;
+	if (!set_up_path_distances(grid, quiet)) return false;
 
 	/* Now travel along the path, backwards */
 	path_step_idx = 0;
@@ -237,6 +430,659 @@ bool find_path(struct loc grid)
 	return true;
 }
 
+/**
+ * Fill the array of path step directions, abandoning any travel in progress
+ * \param grid the target grid
+ */
+bool find_path(struct loc grid)
+{
+	travel_mode = TRAVEL_NONE;
+	return find_path_aux(grid, false);
+}
+
+/**
+ * ------------------------------------------------------------------------
+ * Region graph for long distance travel
+ *
+ * The known map is cut into square clusters, and each cluster's open grids
+ * are split into regions which are connected within the cluster.  Regions
+ * in neighbouring clusters which touch are linked, so the graph of regions
+ * is a coarse version of the known map which is cheap to search over any
+ * distance.  Travel follows a route through the graph, a leg at a time,
+ * using the ordinary pathfinder to get from the player to a region as far
+ * along the route as it can reach.
+ *
+ * Clusters are relabelled only when the player's knowledge of one of their
+ * grids (or their neighbours, for the edges) changes, and then only when
+ * the graph is next needed.
+ * ------------------------------------------------------------------------ */
+
+/**
+ * Width and height of a cluster, and the most regions one can hold
+ */
+#define REGION_CLUSTER 16
+#define REGION_MAX 64
+
+/**
+ * How far from the player a leg of a journey can end
+ */
+#define TRAVEL_LEG_RANGE (MAX_PF_RADIUS / 2 - 2)
+
+/**
+ * A connected set of open grids within a cluster
+ */
+struct path_region {
+	struct loc rep;		/* Grid nearest the middle of the cluster */
+	bool frontier;		/* Some grid is next to an unknown grid */
+	int *links;			/* Regions touching this one in other clusters */
+	int num_links;
+	int links_size;
+
+	/* Search state, current if stamp matches region_stamp */
+	u32b stamp;
+	int dist;
+	int parent;
+	bool closed;
+};
+
+struct path_cluster {
+	bool dirty;			/* Grids need relabelling */
+	bool relink;		/* Links to neighbouring clusters need redoing */
+	int num_regions;
+	struct path_region regions[REGION_MAX];
+};
+
+/**
+ * An entry in the search queue; entries are left in place when a better one
+ * for the same region comes along, and skipped when they surface
+ */
+struct region_open {
+	int est;
+	int id;
+};
+
+/**
+ * The graph, valid for region_chunk as at region_chunk_stamp
+ */
+static struct chunk *region_chunk;
+static u32b region_chunk_stamp;
+static int region_chunk_height, region_chunk_width;
+static int region_wid, region_hgt;
+static struct path_cluster *region_clusters;
+static byte *region_label;
+
+/**
+ * Search state
+ */
+static struct region_open *region_queue;
+static int region_queue_n, region_queue_size;
+static u32b region_stamp;
+static int *region_route;
+static int region_route_n, region_route_size;
+
+/**
+ * Check whether a grid can be part of a region
+ */
+static bool region_isopen(struct loc grid)
+{
+	return square_isknown(cave, grid) &&
+		square_ispassable(player->cave, grid);
+}
+
+/**
+ * Get the cluster index of a grid
+ */
+static int region_cluster_idx(struct loc grid)
+{
+	return (grid.y / REGION_CLUSTER) * region_wid + grid.x / REGION_CLUSTER;
+}
+
+/**
+ * Get the region containing a grid, or -1 if it is not open
+ */
+static int region_at(struct loc grid)
+{
+	int label = region_label[path_index(grid)];
+
+	if (!label) return -1;
+	return region_cluster_idx(grid) * REGION_MAX + label - 1;
+}
+
+static struct path_region *region_get(int id)
+{
+	return &region_clusters[id / REGION_MAX].regions[id % REGION_MAX];
+}
+
+/**
+ * Get the grids covered by a cluster
+ */
+static void region_cluster_bounds(int idx, struct loc *tl, struct loc *br)
+{
+	tl->x = (idx % region_wid) * REGION_CLUSTER;
+	tl->y = (idx / region_wid) * REGION_CLUSTER;
+	br->x = MIN(tl->x + REGION_CLUSTER, cave->width);
+	br->y = MIN(tl->y + REGION_CLUSTER, cave->height);
+}
+
+/**
+ * Mark a grid's cluster, and any neighbouring ones it touches, for
+ * relabelling
+ */
+static void region_mark_dirty(struct loc grid)
+{
+	int k;
+
+	region_clusters[region_cluster_idx(grid)].dirty = true;
+	for (k = 0; k < 8; k++) {
+		struct loc next = loc_sum(grid, ddgrid_ddd[k]);
+		if (!square_in_bounds(cave, next)) continue;
+		region_clusters[region_cluster_idx(next)].dirty = true;
+	}
+}
+
+/**
+ * Note that the player's knowledge of a grid has changed
+ */
+void path_regions_note(struct loc grid)
+{
+	if (!region_clusters || region_chunk != player->cave) return;
+	region_mark_dirty(grid);
+}
+
+/**
+ * Free the region graph
+ */
+static void region_wipe(void)
+{
+	int i, j;
+
+	for (i = 0; i < region_wid * region_hgt; i++) {
+		struct path_cluster *cluster = &region_clusters[i];
+		for (j = 0; j < REGION_MAX; j++) {
+			mem_free(cluster->regions[j].links);
+		}
+	}
+	mem_free(region_clusters);
+	region_clusters = NULL;
+	mem_free(region_label);
+	region_label = NULL;
+	region_chunk = NULL;
+	region_wid = 0;
+	region_hgt = 0;
+}
+
+/**
+ * Split a cluster into regions
+ */
+static void region_relabel(int idx)
+{
+	struct path_cluster *cluster = &region_clusters[idx];
+	struct loc tl, br, grid, middle;
+	struct loc queue[REGION_CLUSTER * REGION_CLUSTER];
+	int i;
+
+	region_cluster_bounds(idx, &tl, &br);
+	middle = loc((tl.x + br.x) / 2, (tl.y + br.y) / 2);
+	for (grid.y = tl.y; grid.y < br.y; grid.y++) {
+		for (grid.x = tl.x; grid.x < br.x; grid.x++) {
+			region_label[path_index(grid)] = 0;
+		}
+	}
+
+	cluster->num_regions = 0;
+	for (grid.y = tl.y; grid.y < br.y; grid.y++) {
+		for (grid.x = tl.x; grid.x < br.x; grid.x++) {
+			struct path_region *region;
+			int head = 0, tail = 0, best = -1;
+
+			if (region_label[path_index(grid)]) continue;
+			if (!region_isopen(grid)) continue;
+
+			/* Flood fill a new region */
+			assert(cluster->num_regions < REGION_MAX);
+			region = &cluster->regions[cluster->num_regions++];
+			region->frontier = false;
+			region->stamp = 0;
+			region_label[path_index(grid)] = cluster->num_regions;
+			queue[tail++] = grid;
+			while (head < tail) {
+				struct loc cur = queue[head++];
+				int k, dist = MAX(ABS(cur.x - middle.x),
+								  ABS(cur.y - middle.y));
+
+				if (best < 0 || dist < best) {
+					best = dist;
+					region->rep = cur;
+				}
+
+				for (k = 0; k < 8; k++) {
+					struct loc next = loc_sum(cur, ddgrid_ddd[k]);
+
+					if (!square_in_bounds(cave, next)) continue;
+					if (!square_isknown(cave, next)) {
+						region->frontier = true;
+						continue;
+					}
+					if ((next.x < tl.x) || (next.x >= br.x) ||
+						(next.y < tl.y) || (next.y >= br.y)) continue;
+					if (region_label[path_index(next)]) continue;
+					if (!region_isopen(next)) continue;
+					region_label[path_index(next)] = cluster->num_regions;
+					queue[tail++] = next;
+				}
+			}
+		}
+	}
+	cluster->dirty = false;
+
+	/* This cluster's links, and those into it, need redoing */
+	for (i = 0; i < 9; i++) {
+		struct loc next = loc_sum(loc(idx % region_wid, idx / region_wid),
+								  ddgrid_ddd[i]);
+		if ((next.x < 0) || (next.x >= region_wid) ||
+			(next.y < 0) || (next.y >= region_hgt)) continue;
+		region_clusters[next.y * region_wid + next.x].relink = true;
+	}
+}
+
+/**
+ * Add a link from one region to another, if it isn't there already
+ */
+static void region_add_link(struct path_region *region, int id)
+{
+	int i;
+
+	for (i = 0; i < region->num_links; i++) {
+		if (region->links[i] == id) return;
+	}
+	if (region->num_links == region->links_size) {
+		region->links_size = region->links_size ? 2 * region->links_size : 8;
+		region->links = mem_realloc(region->links,
+									region->links_size * sizeof(int));
+	}
+	region->links[region->num_links++] = id;
+}
+
+/**
+ * Find the links from a cluster's regions to those of its neighbours
+ */
+static void region_relink(int idx)
+{
+	struct path_cluster *cluster = &region_clusters[idx];
+	struct loc tl, br, grid;
+	int i;
+
+	for (i = 0; i < cluster->num_regions; i++) {
+		cluster->regions[i].num_links = 0;
+	}
+
+	/* Only the grids round the edge can touch another cluster */
+	region_cluster_bounds(idx, &tl, &br);
+	for (grid.y = tl.y; grid.y < br.y; grid.y++) {
+		for (grid.x = tl.x; grid.x < br.x; grid.x++) {
+			struct path_region *region;
+			int k, id;
+
+			if ((grid.y > tl.y) && (grid.y < br.y - 1) && (grid.x > tl.x) &&
+				(grid.x < br.x - 1)) {
+				grid.x = br.x - 2;
+				continue;
+			}
+			id = region_at(grid);
+			if (id < 0) continue;
+			region = region_get(id);
+
+			for (k = 0; k < 8; k++) {
+				struct loc next = loc_sum(grid, ddgrid_ddd[k]);
+				int next_id;
+
+				if (!square_in_bounds(cave, next)) continue;
+				if (region_cluster_idx(next) == idx) continue;
+				next_id = region_at(next);
+				if (next_id >= 0) region_add_link(region, next_id);
+			}
+		}
+	}
+	cluster->relink = false;
+}
+
+/**
+ * Bring the region graph up to date with the player's knowledge
+ */
+static void region_update(void)
+{
+	int i, n;
+
+	/* Start again for a different map */
+	if (!region_clusters || region_chunk != player->cave ||
+		region_chunk_stamp != player->cave->terrain_stamp ||
+		region_chunk_height != cave->height ||
+		region_chunk_width != cave->width) {
+		region_wipe();
+		region_chunk = player->cave;
+		region_chunk_stamp = player->cave->terrain_stamp;
+		region_chunk_height = cave->height;
+		region_chunk_width = cave->width;
+		region_wid = (cave->width + REGION_CLUSTER - 1) / REGION_CLUSTER;
+		region_hgt = (cave->height + REGION_CLUSTER - 1) / REGION_CLUSTER;
+		region_clusters = mem_zalloc(region_wid * region_hgt *
+									 sizeof(*region_clusters));
+		region_label = mem_zalloc(cave->width * cave->height *
+								  sizeof(*region_label));
+		for (i = 0; i < region_wid * region_hgt; i++) {
+			region_clusters[i].dirty = true;
+		}
+	}
+
+	n = region_wid * region_hgt;
+	for (i = 0; i < n; i++) {
+		if (region_clusters[i].dirty) region_relabel(i);
+	}
+	for (i = 0; i < n; i++) {
+		if (region_clusters[i].relink) region_relink(i);
+	}
+}
+
+/**
+ * Get the region the travel from a grid should start in
+ */
+static int region_near(struct loc grid)
+{
+	int k, id = region_at(grid);
+
+	for (k = 0; (id < 0) && (k < 8); k++) {
+		struct loc next = loc_sum(grid, ddgrid_ddd[k]);
+		if (square_in_bounds(cave, next)) id = region_at(next);
+	}
+	return id;
+}
+
+/**
+ * Add a region to the search queue
+ */
+static void region_push(int id, int est)
+{
+	int pos;
+
+	if (region_queue_n == region_queue_size) {
+		region_queue_size = region_queue_size ? 2 * region_queue_size : 64;
+		region_queue = mem_realloc(region_queue,
+								   region_queue_size * sizeof(*region_queue));
+	}
+	pos = region_queue_n++;
+	while (pos > 0) {
+		int parent = (pos - 1) / 2;
+		if (region_queue[parent].est <= est) break;
+		region_queue[pos] = region_queue[parent];
+		pos = parent;
+	}
+	region_queue[pos].est = est;
+	region_queue[pos].id = id;
+}
+
+/**
+ * Take the best region off the search queue
+ */
+static int region_pop(void)
+{
+	int id = region_queue[0].id;
+	struct region_open last = region_queue[--region_queue_n];
+	int pos = 0;
+
+	while (2 * pos + 1 < region_queue_n) {
+		int child = 2 * pos + 1;
+		if ((child + 1 < region_queue_n) &&
+			(region_queue[child + 1].est < region_queue[child].est)) {
+			child++;
+		}
+		if (region_queue[child].est >= last.est) break;
+		region_queue[pos] = region_queue[child];
+		pos = child;
+	}
+	if (region_queue_n > 0) region_queue[pos] = last;
+	return id;
+}
+
+/**
+ * Distance between grids, counting diagonal steps as one
+ */
+static int region_distance(struct loc grid1, struct loc grid2)
+{
+	return MAX(ABS(grid1.x - grid2.x), ABS(grid1.y - grid2.y));
+}
+
+/**
+ * Search the region graph from one region, either towards a goal region or,
+ * if the goal is negative, for the nearest region next to unknown grids
+ * \return the region found, or -1 if there is none
+ */
+static int region_search(int start, int goal)
+{
+	struct path_region *region;
+	struct loc target = goal >= 0 ? region_get(goal)->rep : loc(0, 0);
+
+	if (++region_stamp == 0) {
+		int i, j;
+		for (i = 0; i < region_wid * region_hgt; i++) {
+			for (j = 0; j < REGION_MAX; j++) {
+				region_clusters[i].regions[j].stamp = 0;
+			}
+		}
+		region_stamp = 1;
+	}
+	region_queue_n = 0;
+
+	region = region_get(start);
+	region->stamp = region_stamp;
+	region->dist = 0;
+	region->parent = -1;
+	region->closed = false;
+	region_push(start, 0);
+
+	while (region_queue_n > 0) {
+		int i, id = region_pop();
+
+		region = region_get(id);
+		if (region->closed) continue;
+		region->closed = true;
+		if ((goal >= 0) ? (id == goal) : region->frontier) return id;
+
+		for (i = 0; i < region->num_links; i++) {
+			int next_id = region->links[i];
+			struct path_region *next = region_get(next_id);
+			int dist = region->dist + region_distance(region->rep, next->rep);
+
+			if (next->stamp != region_stamp) {
+				next->stamp = region_stamp;
+				next->closed = false;
+			} else if (next->closed || (next->dist <= dist)) {
+				continue;
+			}
+			next->dist = dist;
+			next->parent = id;
+			region_push(next_id, (goal >= 0) ?
+						dist + region_distance(next->rep, target) : dist);
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Record the route found by the last search, from the start to a region
+ */
+static void region_set_route(int id)
+{
+	int i;
+
+	region_route_n = 0;
+	for (; id >= 0; id = region_get(id)->parent) {
+		if (region_route_n == region_route_size) {
+			region_route_size = region_route_size ? 2 * region_route_size : 32;
+			region_route = mem_realloc(region_route,
+									   region_route_size * sizeof(int));
+		}
+		region_route[region_route_n++] = id;
+	}
+
+	/* Put it in order */
+	for (i = 0; i < region_route_n / 2; i++) {
+		int swap = region_route[i];
+		region_route[i] = region_route[region_route_n - 1 - i];
+		region_route[region_route_n - 1 - i] = swap;
+	}
+}
+
+/**
+ * Find the grid nearest the player next to an unknown grid in a region
+ */
+static struct loc region_frontier_grid(int id)
+{
+	struct loc tl, br, grid, best = player->grid;
+	int label = id % REGION_MAX + 1, best_dist = -1;
+
+	region_cluster_bounds(id / REGION_MAX, &tl, &br);
+	for (grid.y = tl.y; grid.y < br.y; grid.y++) {
+		for (grid.x = tl.x; grid.x < br.x; grid.x++) {
+			int k, dist;
+
+			if (region_label[path_index(grid)] != label) continue;
+			dist = region_distance(grid, player->grid);
+			if ((best_dist >= 0) && (dist >= best_dist)) continue;
+			for (k = 0; k < 8; k++) {
+				struct loc next = loc_sum(grid, ddgrid_ddd[k]);
+				if (square_in_bounds(cave, next) &&
+					!square_isknown(cave, next)) {
+					best = grid;
+					best_dist = dist;
+					break;
+				}
+			}
+		}
+	}
+	return best;
+}
+
+/**
+ * Plan the next leg of the current journey and set the pathfinder going
+ * along it
+ * \return whether there is a leg to follow
+ */
+static bool travel_leg(void)
+{
+	int start, goal, i;
+
+	if (travel_mode == TRAVEL_NONE) return false;
+
+	/* Arrived */
+	if ((travel_mode == TRAVEL_LOCATION) &&
+		loc_eq(travel_goal, player->grid)) {
+		travel_mode = TRAVEL_NONE;
+		return false;
+	}
+
+	/* Nearby places can be reached directly */
+	if ((travel_mode == TRAVEL_LOCATION) &&
+		(region_distance(travel_goal, player->grid) <= TRAVEL_LEG_RANGE) &&
+		find_path_aux(travel_goal, true)) {
+		return true;
+	}
+
+	region_update();
+	start = region_near(player->grid);
+	if (start < 0) {
+		travel_mode = TRAVEL_NONE;
+		return false;
+	}
+
+	if (travel_mode == TRAVEL_EXPLORE) {
+		goal = region_search(start, -1);
+		if (goal < 0) {
+			msg("There is nowhere left to explore.");
+			travel_mode = TRAVEL_NONE;
+			return false;
+		}
+		travel_goal = region_frontier_grid(goal);
+
+		/* Nowhere to go that standing here hasn't revealed */
+		if (loc_eq(travel_goal, player->grid)) {
+			travel_mode = TRAVEL_NONE;
+			return false;
+		}
+		if ((region_distance(travel_goal, player->grid) <=
+			 TRAVEL_LEG_RANGE) && find_path_aux(travel_goal, true)) {
+			return true;
+		}
+	} else {
+		goal = region_near(travel_goal);
+		if ((goal < 0) || (region_search(start, goal) < 0)) {
+			travel_mode = TRAVEL_NONE;
+			return false;
+		}
+	}
+
+	/* Head for the furthest region along the route which is in reach and
+	 * which the pathfinder can actually get to */
+	region_set_route(goal);
+	for (i = region_route_n - 1; i > 0; i--) {
+		struct loc grid = region_get(region_route[i])->rep;
+
+		if (region_distance(grid, player->grid) > TRAVEL_LEG_RANGE) continue;
+		if (find_path_aux(grid, true)) return true;
+	}
+
+	travel_mode = TRAVEL_NONE;
+	return false;
+}
+
+/**
+ * Start travelling to a grid, however far away
+ */
+bool path_travel(struct loc grid)
+{
+	travel_mode = TRAVEL_LOCATION;
+	travel_goal = grid;
+	if (travel_leg()) return true;
+	bell("Target space unreachable.");
+	return false;
+}
+
+/**
+ * Start travelling to the nearest place next to an unknown grid
+ */
+bool path_explore(void)
+{
+	travel_mode = TRAVEL_EXPLORE;
+	return travel_leg();
+}
+
+/**
+ * Free the pathfinding search buffers
+ */
+static void cleanup_path(void)
+{
+	mem_free(path_nodes);
+	path_nodes = NULL;
+	mem_free(path_heap);
+	path_heap = NULL;
+	path_buf_size = 0;
+	path_stamp = 0;
+	region_wipe();
+	mem_free(region_queue);
+	region_queue = NULL;
+	region_queue_size = 0;
+	mem_free(region_route);
+	region_route = NULL;
+	region_route_size = 0;
+	travel_mode = TRAVEL_NONE;
+}
+
+struct init_module player_path_module = {
+	.name = "player-path",
+	.init = NULL,
+	.cleanup = cleanup_path
+};
+
 /**
  * Compute the direction (in the angband 123456789 sense) from a point to a
  * point. We decide to use diagonals if dx and dy are within a factor of two of
@@ -869,8 +1715,8 @@ void run_step(int dir)
 				disturb(player);
 				return;
 			}
-		} else if (path_step_idx < 0) {
-			/* Pathfinding, and the path is finished */
+		} else if ((path_step_idx < 0) && !travel_leg()) {
+			/* Pathfinding, and the path (and any journey) is finished */
 			disturb(player);
 			player->upkeep->running_withpathfind = false;
 			return;
@@ -933,11 +1779,16 @@ void run_step(int dir)
 				/* Get step after */
 				grid = loc_sum(grid, ddgrid[path_step_dir[path_step_idx - 1]]);
 
-				/* Known wall, so run the direction we were going */
+				/* Known wall, so plan the journey afresh or run the
+				 * direction we were going */
 				if (square_isknown(cave, grid) &&
 					!square_ispassable(cave, grid)) {
-					player->upkeep->running_withpathfind = false;
-					run_init(path_step_dir[path_step_idx]);
+					int run_dir = path_step_dir[path_step_idx];
+
+					if (!travel_leg()) {
+						player->upkeep->running_withpathfind = false;
+						run_init(run_dir);
+					}
 				}
 			}
 
@@ -24,6 +24,9 @@
 
 int pathfind_direction_to(struct loc from, struct loc to);
 bool find_path(struct loc grid);
+void path_regions_note(struct loc grid);
+bool path_travel(struct loc grid);
+bool path_explore(void);
 void run_step(int dir);
 
 #endif /* !PLAYER_PATH_H */
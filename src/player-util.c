@@ -738,6 +738,8 @@ struct object *player_best_digger(struct player *p, bool forbid_stack)
 	int best_score = (player_has(p, PF_WOODEN)) ? p->lev * 10 : -1;
 	struct player_state local_state;
 
+	/* Only the weapon slot changes between the calc_bonuses() calls */
+	calc_bonuses_hold();
 	for (obj = p->gear; obj; obj = obj->next) {
 		int score, old_number;
 		if (!tval_is_melee_weapon(obj)) continue;
@@ -773,6 +775,7 @@ struct object *player_best_digger(struct player *p, bool forbid_stack)
 		}
 	}
 
+	calc_bonuses_release();
 	return best;
 }
 
@@ -518,6 +518,8 @@ struct player_upkeep {
 	u32b redraw;			/* Bit flags for things that /have/ changed,
 							 * and just need to be redrawn by the UI,
 							 * such as HP, Speed, etc.*/
+	u32b known_drawn;		/* Position in the known map's change
+							 * journal the map display is up to */
 
 	int command_wrk;		/* Used by the UI to decide whether
 							 * to start off showing equipment or
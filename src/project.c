@@ -29,6 +29,7 @@
 #include "project.h"
 #include "source.h"
 #include "trap.h"
+#include "z-profile.h"
 
 struct projection *projections;
 
@@ -393,6 +394,29 @@ bool projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
 	return (true);
 }
 
+/**
+ * As projectable(), but reuse the answer remembered in memo if nothing it
+ * depends on has changed, and remember the new answer otherwise.
+ *
+ * Only terrain is remembered, so this must not be used with flags that make
+ * the path depend on monsters, the player's map or the player's state.
+ */
+bool projectable_memo(struct projectable_memo *memo, struct chunk *c,
+					  struct loc grid1, struct loc grid2, int flg)
+{
+	assert(!(flg & (PROJECT_STOP | PROJECT_INFO | PROJECT_SHORT)));
+
+	if (memo->stamp != c->terrain_stamp || memo->flg != flg ||
+			!loc_eq(memo->grid1, grid1) || !loc_eq(memo->grid2, grid2)) {
+		memo->stamp = c->terrain_stamp;
+		memo->grid1 = grid1;
+		memo->grid2 = grid2;
+		memo->flg = flg;
+		memo->result = projectable(c, grid1, grid2, flg);
+	}
+	return memo->result;
+}
+
 
 
 
@@ -624,6 +648,8 @@ bool project(struct source origin, int rad, struct loc finish,
 	/* Precalculated damage values for each distance. */
 	int *dam_at_dist = malloc((z_info->max_range + 1) * sizeof(*dam_at_dist));
 
+	PROFILE_BEGIN(PROJECT);
+
 	/* Flush any pending output */
 	handle_stuff(player);
 
@@ -1006,6 +1032,7 @@ bool project(struct source origin, int rad, struct loc finish,
 				notice = true;
 				if (player->is_dead) {
 					free(dam_at_dist);
+					PROFILE_END(PROJECT);
 					return notice;
 				}
 				break;
@@ -1033,6 +1060,7 @@ bool project(struct source origin, int rad, struct loc finish,
 	if (player->upkeep->update) update_stuff(player);
 
 	free(dam_at_dist);
+	PROFILE_END(PROJECT);
 
 	/* Return "something was noticed" */
 	return (notice);
@@ -100,6 +100,18 @@ enum
 	PROJECT_ROCK  = 0x8000,
 };
 
+/**
+ * A remembered result of projectable(), valid while the chunk's terrain stamp
+ * and both grids are unchanged
+ */
+struct projectable_memo {
+	u32b stamp;
+	struct loc grid1;
+	struct loc grid2;
+	int flg;
+	bool result;
+};
+
 /* Display attrs and chars */
 extern byte proj_to_attr[PROJ_MAX][BOLT_MAX];
 extern wchar_t proj_to_char[PROJ_MAX][BOLT_MAX];
@@ -121,6 +133,8 @@ bool project_p(struct source, int r, struct loc grid, int dam, int typ,
 int project_path(struct chunk *c, struct loc *gp, int range, struct loc grid1,
 				 struct loc grid2, int flg);
 bool projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg);
+bool projectable_memo(struct projectable_memo *memo, struct chunk *c,
+					  struct loc grid1, struct loc grid2, int flg);
 int proj_name_to_idx(const char *name);
 const char *proj_idx_to_name(int type);
 
@@ -204,7 +204,8 @@ static void wr_item(const struct object *obj)
 /**
  * Write a monster record (including held or mimicked objects)
  */
-static void wr_monster(const struct monster *mon)
+static void wr_monster(const struct monster *mon,
+		const struct monster_cold *cold)
 {
 	size_t j;
 	struct object *obj = mon->held_obj; 
@@ -247,10 +248,10 @@ static void wr_monster(const struct monster *mon)
 		wr_byte(mon->mflag[j]);
 
 	for (j = 0; j < OF_SIZE; j++)
-		wr_byte(mon->known_pstate.flags[j]);
+		wr_byte(cold->known_pstate.flags[j]);
 
 	for (j = 0; j < ELEM_MAX; j++)
-		wr_s16b(mon->known_pstate.el_info[j].res_level);
+		wr_s16b(cold->known_pstate.el_info[j].res_level);
 
 	/* Write mimicked object marker, if any */
 	if (mon->mimicked_obj) {
@@ -680,8 +681,9 @@ void wr_misc(void)
 		wr_byte(world->levels[j].visited ? 1 : 0);
 	}
 
-	/* Random artifact seed */
+	/* Random artifact seed, and how the set was designed from it */
 	wr_u32b(seed_randart);
+	wr_byte(randart_streams ? 1 : 0);
 
 	/* Write the "object seeds" */
 	wr_u32b(seed_flavor);
@@ -840,79 +842,157 @@ void wr_stores(void)
 
 
 /**
- * Write the current dungeon terrain features and info flags
+ * The encoded squares of the player's map from the last save, and the terrain
+ * stamp and journal position they were encoded at.  If neither has moved
+ * since, the player's map is unchanged and the encoding is reused.
+ */
+static byte *known_squares;
+static u32b known_squares_len;
+static u32b known_squares_stamp;
+static u32b known_squares_serial;
+
+/**
+ * Write a run of squares bytes: a varint with the length shifted up one bit,
+ * and then either the one repeated byte (low bit set) or the literal bytes
+ */
+static void wr_squares_run(const byte *bytes, u32b len, bool repeat)
+{
+	if (!len) return;
+	wr_varint((len << 1) | (repeat ? 1 : 0));
+	if (repeat) {
+		wr_byte(bytes[0]);
+	} else {
+		wr_bytes(bytes, len);
+	}
+}
+
+/**
+ * Write the terrain features and info flags of a chunk's squares
  *
- * Note that the cost and when fields of c->squares[y][x] are not saved
+ * The features and then each info plane are laid out one after another as a
+ * single stream of rows.  Each row is XORed with the row above it in the same
+ * plane wherever that leaves fewer breaks between runs, as it does for the
+ * walls and floors most rows share with their neighbours, and a bitmap notes
+ * which rows were.  The stream is then written as runs with varint lengths,
+ * so that one run can cover any number of rows.
  */
-static void wr_dungeon_aux(struct chunk *c)
+static void wr_dungeon_squares(struct chunk *c)
 {
 	int y, x;
 	size_t i;
+	u32b width = c->width, rows = c->height * (1 + SQUARE_SIZE);
+	u32b len = width * rows;
+	u32b r, n, start, end;
+	byte *bytes = mem_alloc(len ? len : 1);
+	byte *flags = mem_zalloc((rows + 7) / 8);
 
-	byte tmp8u;
+	/* Lay out the planes */
+	for (y = 0; y < c->height; y++) {
+		for (x = 0; x < c->width; x++) {
+			const struct square *sq = square(c, loc(x, y));
 
-	byte count;
-	byte prev_char;
+			bytes[y * width + x] = sq->feat;
+			for (i = 0; i < SQUARE_SIZE; i++)
+				bytes[((i + 1) * c->height + y) * width + x] = sq->info[i];
+		}
+	}
 
-	/* Dungeon specific info follows */
-	wr_string(c->name ? c->name : "Blank");
-	wr_u16b(c->height);
-	wr_u16b(c->width);
+	/* Difference rows against the ones above, working upwards */
+	for (r = rows; r-- > 0; ) {
+		byte *row = bytes + r * width;
+		const byte *above;
+		u32b plain = 0, diff = 0;
 
-	/* Run length encoding of c->squares[y][x].info */
-	for (i = 0; i < SQUARE_SIZE; i++) {
-		count = 0;
-		prev_char = 0;
-
-		/* Dump for each grid */
-		for (y = 0; y < c->height; y++) {
-			for (x = 0; x < c->width; x++) {
-				/* Extract the important c->squares[y][x].info flags */
-				tmp8u = square(c, loc(x, y))->info[i];
-
-				/* If the run is broken, or too full, flush it */
-				if ((tmp8u != prev_char) || (count == UCHAR_MAX)) {
-					wr_byte((byte)count);
-					wr_byte((byte)prev_char);
-					prev_char = tmp8u;
-					count = 1;
-				} else /* Continue the run */
-					count++;
-			}
-		}
+		/* The top row of each plane is left alone */
+		if (r % c->height == 0) continue;
 
-		/* Flush the data (if any) */
-		if (count) {
-			wr_byte((byte)count);
-			wr_byte((byte)prev_char);
+		above = row - width;
+		for (n = 1; n < width; n++) {
+			if (row[n] != row[n - 1]) plain++;
+			if ((row[n] ^ above[n]) != (row[n - 1] ^ above[n - 1])) diff++;
+		}
+		if (diff < plain) {
+			for (n = 0; n < width; n++)
+				row[n] ^= above[n];
+			flags[r / 8] |= 1 << (r % 8);
+		}
+	}
+	wr_bytes(flags, (rows + 7) / 8);
+	mem_free(flags);
+
+	/* Split into repeated runs of three or more, and literals between them */
+	for (start = n = 0; n < len; n = end) {
+		for (end = n + 1; end < len && bytes[end] == bytes[n]; end++) ;
+		if (end - n >= 3) {
+			wr_squares_run(bytes + start, n - start, false);
+			wr_squares_run(bytes + n, end - n, true);
+			start = end;
 		}
 	}
+	wr_squares_run(bytes + start, len - start, false);
 
-	/* Now the terrain */
-	count = 0;
-	prev_char = 0;
+	mem_free(bytes);
+}
 
-	/* Dump for each grid */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
-			/* Extract a byte */
-			tmp8u = square(c, loc(x, y))->feat;
-
-			/* If the run is broken, or too full, flush it */
-			if ((tmp8u != prev_char) || (count == UCHAR_MAX)) {
-				wr_byte((byte)count);
-				wr_byte((byte)prev_char);
-				prev_char = tmp8u;
-				count = 1;
-			} else /* Continue the run */
-				count++;
-		}
+/**
+ * Write the squares of the player's map, reusing the last save's encoding
+ * if the map hasn't changed since
+ */
+static void wr_known_squares(struct chunk *c)
+{
+	u32b start;
+
+	if (known_squares && known_squares_stamp == c->terrain_stamp &&
+		known_squares_serial == c->journal.next) {
+		wr_bytes(known_squares, known_squares_len);
+		return;
 	}
 
-	/* Flush the data (if any) */
-	if (count) {
-		wr_byte((byte)count);
-		wr_byte((byte)prev_char);
+	start = wr_position();
+	wr_dungeon_squares(c);
+	mem_free(known_squares);
+	known_squares = wr_copy_since(start, &known_squares_len);
+	known_squares_stamp = c->terrain_stamp;
+	known_squares_serial = c->journal.next;
+}
+
+/**
+ * Free the player's map kept from the last save
+ */
+static void cleanup_save(void)
+{
+	mem_free(known_squares);
+	known_squares = NULL;
+	known_squares_len = 0;
+	known_squares_stamp = 0;
+	known_squares_serial = 0;
+}
+
+struct init_module save_module = {
+	.name = "save",
+	.init = NULL,
+	.cleanup = cleanup_save
+};
+
+/**
+ * Write the current dungeon terrain features and info flags
+ *
+ * Note that the cost and when fields of c->squares[y][x] are not saved
+ */
+static void wr_dungeon_aux(struct chunk *c)
+{
+	size_t i;
+
+	/* Dungeon specific info follows */
+	wr_string(c->name ? c->name : "Blank");
+	wr_u16b(c->height);
+	wr_u16b(c->width);
+
+	/* Terrain and info flags */
+	if (c == player->cave) {
+		wr_known_squares(c);
+	} else {
+		wr_dungeon_squares(c);
 	}
 
 	/* Write feeling */
@@ -1002,7 +1082,7 @@ static void wr_monsters_aux(struct chunk *c)
 	for (i = 1; i < cave_monster_max(c); i++) {
 		const struct monster *mon = cave_monster(c, i);
 
-		wr_monster(mon);
+		wr_monster(mon, cave_monster_cold(c, i));
 	}
 }
 
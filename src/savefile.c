@@ -112,17 +112,17 @@ static const struct {
 	{ "quests", wr_quests, 1 },
 	{ "player", wr_player, 1 },
 	{ "ignore", wr_ignore, 1 },
-	{ "misc", wr_misc, 1 },
+	{ "misc", wr_misc, 2 },
 	{ "artifacts", wr_artifacts, 1 },
 	{ "player hp", wr_player_hp, 1 },
 	{ "player spells", wr_player_spells, 1 },
 	{ "gear", wr_gear, 1 },
 	{ "stores", wr_stores, 1 },
-	{ "dungeon", wr_dungeon, 1 },
+	{ "dungeon", wr_dungeon, 2 },
 	{ "objects", wr_objects, 1 },
 	{ "monsters", wr_monsters, 1 },
 	{ "traps", wr_traps, 1 },
-	{ "chunks", wr_chunks, 1 },
+	{ "chunks", wr_chunks, 2 },
 	{ "history", wr_history, 1 },
 };
 
@@ -139,17 +139,20 @@ static const struct blockinfo loaders[] = {
 	{ "quests", rd_quests, 1 },
 	{ "player", rd_player, 1 },
 	{ "ignore", rd_ignore, 1 },
-	{ "misc", rd_misc, 1 },
+	{ "misc", rd_misc, 2 },
+	{ "misc", rd_misc_1, 1 },
 	{ "artifacts", rd_artifacts, 1 },
 	{ "player hp", rd_player_hp, 1 },
 	{ "player spells", rd_player_spells, 1 },
 	{ "gear", rd_gear, 1 },	
 	{ "stores", rd_stores, 1 },	
-	{ "dungeon", rd_dungeon, 1 },
+	{ "dungeon", rd_dungeon, 2 },
+	{ "dungeon", rd_dungeon_1, 1 },
 	{ "objects", rd_objects, 1 },	
 	{ "monsters", rd_monsters, 1 },
 	{ "traps", rd_traps, 1 },
-	{ "chunks", rd_chunks, 1 },
+	{ "chunks", rd_chunks, 2 },
+	{ "chunks", rd_chunks_1, 1 },
 	{ "history", rd_history, 1 },
 };
 
@@ -303,6 +306,20 @@ void rd_string(char *str, int max)
 	str[max - 1] = '\0';
 }
 
+void rd_varint(u32b *ip)
+{
+	byte tmp8u;
+	int shift = 0;
+
+	*ip = 0;
+	do {
+		tmp8u = sf_get();
+		if (shift < 32)
+			*ip |= ((u32b)(tmp8u & 0x7F)) << shift;
+		shift += 7;
+	} while (tmp8u & 0x80);
+}
+
 void strip_bytes(int n)
 {
 	byte tmp8u;
@@ -314,6 +331,50 @@ void pad_bytes(int n)
 	while (n--) wr_byte(0);
 }
 
+/**
+ * Write a run of bytes
+ */
+void wr_bytes(const byte *v, u32b n)
+{
+	while (n--) sf_put(*v++);
+}
+
+/**
+ * Write an unsigned number seven bits at a time, low bits first, with the top
+ * bit of each byte set if more follow
+ */
+void wr_varint(u32b v)
+{
+	while (v >= 0x80) {
+		sf_put((byte)((v & 0x7F) | 0x80));
+		v >>= 7;
+	}
+	sf_put((byte)v);
+}
+
+/**
+ * Return the current position in the block being written
+ */
+u32b wr_position(void)
+{
+	return buffer_pos;
+}
+
+/**
+ * Return a copy of what has been written to the current block since the
+ * given position; the caller frees it.
+ */
+byte *wr_copy_since(u32b pos, u32b *len)
+{
+	byte *copy;
+
+	assert(pos <= buffer_pos);
+	*len = buffer_pos - pos;
+	copy = mem_alloc(*len ? *len : 1);
+	memcpy(copy, buffer + pos, *len);
+	return copy;
+}
+
 
 /**
  * ------------------------------------------------------------------------
@@ -65,6 +65,10 @@ void wr_u32b(u32b v);
 void wr_s32b(s32b v);
 void wr_string(const char *str);
 void pad_bytes(int n);
+void wr_bytes(const byte *v, u32b n);
+void wr_varint(u32b v);
+u32b wr_position(void);
+byte *wr_copy_since(u32b pos, u32b *len);
 
 /* Reading bits */
 void rd_byte(byte *ip);
@@ -73,6 +77,7 @@ void rd_s16b(s16b *ip);
 void rd_u32b(u32b *ip);
 void rd_s32b(s32b *ip);
 void rd_string(char *str, int max);
+void rd_varint(u32b *ip);
 void strip_bytes(int n);
 
 
@@ -88,12 +93,15 @@ int rd_artifacts(void);
 int rd_player(void);
 int rd_ignore(void);
 int rd_misc(void);
+int rd_misc_1(void);
 int rd_player_hp(void);
 int rd_player_spells(void);
 int rd_gear(void);
 int rd_stores(void);
 int rd_dungeon(void);
+int rd_dungeon_1(void);
 int rd_chunks(void);
+int rd_chunks_1(void);
 int rd_objects(void);
 int rd_monsters(void);
 int rd_monster_groups(void);
@@ -1600,52 +1600,246 @@ static void store_maint(struct store *s)
 }
 
 /**
- * Update the stores on the return to town.
+ * Number of days of maintenance after which a store's stock is taken to have
+ * turned over completely.  Each day sells about (turnover + 1) / 2 of the
+ * store's slots, so after this many days any one item has less than a 1 in 20
+ * chance of still being on the shelves.  Stores without turnover never
+ * qualify, since their maintenance is cheap anyway.
  */
-void store_update(void)
+static int store_turnover_days(const struct store *s)
 {
-	if (OPT(player, cheat_xtra)) msg("Updating Shops...");
-	while (daycount--) {
-		int i;
-		struct store *s;
+	int slots = s->normal_stock_max + s->always_num;
 
-		/* Maintain each shop (except home) */
-		for (i = 0; i < world->num_towns; i++) {
-			struct town *town = &world->towns[i];
-			for (s = town->stores; s; s = s->next) {
-				/* Skip the home */
-				if (store_is_home(s)) continue;
+	if (!s->turnover) return 0;
+	return (6 * slots + s->turnover) / (s->turnover + 1);
+}
 
-				/* Maintain */
-				store_maint(s);
+/**
+ * Bring a store up to date after a number of days at once, rather than one
+ * day at a time.
+ *
+ * The number of slots in stock only depends on the daily sales and restock
+ * rolls, so that is followed through every day without creating or deleting
+ * any objects; the old stock, which has all been sold by now, is then
+ * cleared and the store is stocked afresh to the final number of slots.
+ */
+static void store_catch_up(struct store *s, int days)
+{
+	int stock = s->stock_num;
+	size_t i;
+
+	/* Follow the number of slots through store_maint() */
+	while (days--) {
+		stock -= randint1(s->turnover);
+		if (stock > s->normal_stock_max) stock = s->normal_stock_max;
+		if (stock < (int) s->always_num) stock = s->always_num;
+		stock += randint1(s->turnover);
+		if (stock > s->normal_stock_max + (int) s->always_num)
+			stock = s->normal_stock_max + s->always_num;
+		if (stock < s->normal_stock_min + (int) s->always_num)
+			stock = s->normal_stock_min + s->always_num;
+	}
+
+	/* Everything on the shelves has been sold */
+	while (s->stock)
+		store_delete(s, s->stock, s->stock->number);
+
+	/* Staples */
+	for (i = 0; i < s->always_num; i++) {
+		struct object *obj = store_find_kind(s, s->always_table[i], NULL);
+
+		if (!obj)
+			obj = store_create_item(s, s->always_table[i]);
+		obj->number = obj->kind->base->max_stack;
+		obj->known->number = obj->kind->base->max_stack;
+	}
+
+	/* Fresh stock */
+	i = 100000;
+	while (s->stock_num < stock && --i)
+		store_create_random(s);
+	if (!i)
+		quit_fmt("Unable to (re-)stock store %d. Please report this bug",
+				 s->sidx + 1);
+}
+
+/**
+ * Maintain all the stores (except the homes) for a number of days.
+ *
+ * \param days is the number of days which have passed.
+ * \param replay forces every day to be run through store_maint(), even for
+ * stores which store_catch_up() could handle.
+ *
+ * Stores are done one after the other and the shopkeeper shuffles last, all
+ * from the one random number stream, so the order is fixed.
+ */
+void store_update_days(int days, bool replay)
+{
+	int i, d;
+	struct store *s;
+
+	/* Maintain each shop (except home) */
+	for (i = 0; i < world->num_towns; i++) {
+		struct town *town = &world->towns[i];
+		for (s = town->stores; s; s = s->next) {
+			int turnover_days = store_turnover_days(s);
+
+			/* Skip the home */
+			if (store_is_home(s)) continue;
+
+			/* Maintain */
+			if (!replay && turnover_days && days >= turnover_days) {
+				store_catch_up(s, days);
+			} else {
+				for (d = 0; d < days; d++)
+					store_maint(s);
 			}
 		}
+	}
 
-		/* Sometimes, shuffle the shop-keepers */
-		if (one_in_(z_info->store_shuffle)) {
-			/* Message */
-			if (OPT(player, cheat_xtra)) msg("Shuffling a Shopkeeper...");
-
-			/* Pick a random shop in a random town */
-			while (1) {
-				int m = randint0(world->num_towns);
-				struct town *town = &world->towns[m];
-				unsigned int n = randint0(z_info->store_max);
-				if (n == store_home_idx) continue;
-				for (s = town->stores; s; s = s->next) {
-					if (n == s->sidx) break;
-				}
-				if (s) break;
-			}
+	/* Sometimes, shuffle the shop-keepers */
+	for (d = 0; d < days; d++) {
+		if (!one_in_(z_info->store_shuffle)) continue;
 
-			/* Shuffle it */
-			store_shuffle(s);
+		/* Message */
+		if (OPT(player, cheat_xtra)) msg("Shuffling a Shopkeeper...");
+
+		/* Pick a random shop in a random town */
+		while (1) {
+			int m = randint0(world->num_towns);
+			struct town *town = &world->towns[m];
+			unsigned int n = randint0(z_info->store_max);
+			if (n == store_home_idx) continue;
+			for (s = town->stores; s; s = s->next) {
+				if (n == s->sidx) break;
+			}
+			if (s) break;
 		}
+
+		/* Shuffle it */
+		store_shuffle(s);
 	}
+}
+
+/**
+ * Update the stores on the return to town.
+ */
+void store_update(void)
+{
+	if (OPT(player, cheat_xtra)) msg("Updating Shops...");
+	store_update_days(daycount, false);
 	daycount = 0;
 	if (OPT(player, cheat_xtra)) msg("Done.");
 }
 
+/**
+ * A copy of the stock and owners of all the stores but the homes, so
+ * maintenance can be tried out and then undone.
+ */
+struct store_snapshot {
+	int num;
+	struct store **store;
+	struct owner **owner;
+	struct object **stock;
+	struct object **stock_k;
+	byte *stock_num;
+};
+
+/**
+ * Copy a pile of store stock, each object with its own copy of the known
+ * version, keeping the order.
+ */
+static void store_copy_stock(struct object *stock, struct object **copy_pile,
+		struct object **known_pile)
+{
+	struct object *obj;
+
+	*copy_pile = NULL;
+	*known_pile = NULL;
+	for (obj = stock; obj; obj = obj->next) {
+		struct object *copy = object_new(), *known_copy = object_new();
+
+		object_copy(copy, obj);
+		object_copy(known_copy, obj->known);
+		copy->known = known_copy;
+		pile_insert_end(copy_pile, copy);
+		pile_insert_end(known_pile, known_copy);
+	}
+}
+
+/**
+ * Take a copy of the stock and owners of all the stores except the homes.
+ */
+struct store_snapshot *store_snapshot_new(void)
+{
+	struct store_snapshot *snap = mem_zalloc(sizeof(*snap));
+	struct store *s;
+	int i, n = 0;
+
+	for (i = 0; i < world->num_towns; i++) {
+		for (s = world->towns[i].stores; s; s = s->next) {
+			if (!store_is_home(s)) n++;
+		}
+	}
+	snap->store = mem_zalloc(n * sizeof(*snap->store));
+	snap->owner = mem_zalloc(n * sizeof(*snap->owner));
+	snap->stock = mem_zalloc(n * sizeof(*snap->stock));
+	snap->stock_k = mem_zalloc(n * sizeof(*snap->stock_k));
+	snap->stock_num = mem_zalloc(n * sizeof(*snap->stock_num));
+
+	for (i = 0; i < world->num_towns; i++) {
+		for (s = world->towns[i].stores; s; s = s->next) {
+			/* Maintenance leaves the home alone */
+			if (store_is_home(s)) continue;
+			snap->store[snap->num] = s;
+			snap->owner[snap->num] = s->owner;
+			snap->stock_num[snap->num] = s->stock_num;
+			store_copy_stock(s->stock, &snap->stock[snap->num],
+				&snap->stock_k[snap->num]);
+			snap->num++;
+		}
+	}
+	return snap;
+}
+
+/**
+ * Put the stores back as they were when the snapshot was taken; the snapshot
+ * can be used again.
+ */
+void store_snapshot_restore(struct store_snapshot *snap)
+{
+	int i;
+
+	for (i = 0; i < snap->num; i++) {
+		struct store *s = snap->store[i];
+
+		object_pile_free(NULL, s->stock_k);
+		object_pile_free(NULL, s->stock);
+		store_copy_stock(snap->stock[i], &s->stock, &s->stock_k);
+		s->owner = snap->owner[i];
+		s->stock_num = snap->stock_num[i];
+	}
+}
+
+/**
+ * Free a snapshot, leaving the stores as they are.
+ */
+void store_snapshot_free(struct store_snapshot *snap)
+{
+	int i;
+
+	for (i = 0; i < snap->num; i++) {
+		object_pile_free(NULL, snap->stock_k[i]);
+		object_pile_free(NULL, snap->stock[i]);
+	}
+	mem_free(snap->stock_num);
+	mem_free(snap->stock_k);
+	mem_free(snap->stock);
+	mem_free(snap->owner);
+	mem_free(snap->store);
+	mem_free(snap);
+}
+
 /** Owner stuff **/
 
 struct owner *store_ownerbyidx(struct store *s, unsigned int idx) {
@@ -73,6 +73,8 @@ struct store {
 
 extern struct store *stores;
 
+struct store_snapshot;
+
 struct store *store_at(struct chunk *c, struct loc grid);
 void free_store(struct store *store);
 void store_init(void);
@@ -87,7 +89,11 @@ void home_carry(struct object *obj);
 struct object *store_carry(struct store *store, struct object *obj);
 void store_reset(void);
 void store_shuffle(struct store *store);
+void store_update_days(int days, bool replay);
 void store_update(void);
+struct store_snapshot *store_snapshot_new(void);
+void store_snapshot_restore(struct store_snapshot *snap);
+void store_snapshot_free(struct store_snapshot *snap);
 int price_item(struct store *store, const struct object *obj,
 			   bool store_buying, int qty);
 
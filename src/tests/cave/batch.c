@@ -0,0 +1,192 @@
+/* cave/batch */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "cave.h"
+#include "effects.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-util.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "player-util.h"
+#include "source.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/* Check the feature counts against looking at every grid */
+static bool counts_match(struct chunk *c)
+{
+	int *count = mem_zalloc((z_info->f_max + 1) * sizeof(int));
+	int i, x, y;
+	bool same = true;
+
+	for (y = 0; y < c->height; y++)
+		for (x = 0; x < c->width; x++)
+			if (square(c, loc(x, y))->feat)
+				count[square(c, loc(x, y))->feat]++;
+	for (i = 0; i <= z_info->f_max; i++)
+		if (count[i] != c->feat_count[i]) same = false;
+	mem_free(count);
+	return same;
+}
+
+/* Check that the planes know of every door and stair, and nothing else */
+static bool planes_match(struct chunk *c)
+{
+	struct point_set *doors = cave_plane_find(c, PLANE_DOOR, loc(0, 0),
+		loc(c->width, c->height));
+	struct point_set *stairs = cave_plane_find(c, PLANE_STAIR, loc(0, 0),
+		loc(c->width, c->height));
+	int n_doors = 0, n_stairs = 0, x, y;
+	bool same = true;
+
+	for (y = 0; y < c->height; y++) {
+		for (x = 0; x < c->width; x++) {
+			if (square_isdoor(c, loc(x, y))) n_doors++;
+			if (square_isstairs(c, loc(x, y))) n_stairs++;
+		}
+	}
+	same = (n_doors == doors->n) && (n_stairs == stairs->n);
+	for (x = 0; same && x < doors->n; x++)
+		same = square_isdoor(c, doors->pts[x]);
+	for (x = 0; same && x < stairs->n; x++)
+		same = square_isstairs(c, stairs->pts[x]);
+	point_set_dispose(doors);
+	point_set_dispose(stairs);
+	return same;
+}
+
+static int test_level(void *state) {
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player_change_place(player, 30);
+	prepare_next_level(player);
+	on_new_level();
+	notnull(cave);
+	player->upkeep->generate_level = false;
+
+	require(counts_match(cave));
+	require(planes_match(cave));
+	ok;
+}
+
+/* Changes in a batch are only counted once it ends */
+static int test_batch(void *state) {
+	struct loc grid = player->grid;
+	struct loc tl = loc(grid.x - 3, grid.y - 3);
+	struct loc br = loc(grid.x + 4, grid.y + 4);
+	struct loc stair = loc(grid.x + 1, grid.y);
+	u32b stamp = cave->terrain_stamp;
+	int granite = cave->feat_count[FEAT_GRANITE];
+	int x, y;
+
+	require(planes_match(cave));
+	require(cave_planes_current(cave));
+	cave_batch_begin(cave, tl, br);
+	require(cave_batch_holds(cave, grid));
+	require(!cave_batch_holds(cave, br));
+	for (y = tl.y; y < br.y; y++) {
+		for (x = tl.x; x < br.x; x++) {
+			if (square_in_bounds_fully(cave, loc(x, y)) &&
+				!loc_eq(loc(x, y), grid)) {
+				square_set_feat(cave, loc(x, y), FEAT_GRANITE);
+			}
+		}
+	}
+	square_set_feat(cave, stair, FEAT_MORE);
+	eq(cave->feat_count[FEAT_GRANITE], granite);
+	eq(cave->terrain_stamp, stamp);
+	require(!cave_planes_current(cave));
+	cave_batch_end(cave);
+
+	null(cave->batch);
+	require(cave->feat_count[FEAT_GRANITE] > granite);
+	require(cave->terrain_stamp != stamp);
+	require(cave_planes_current(cave));
+	require(counts_match(cave));
+	require(planes_match(cave));
+	require(player->upkeep->redraw & PR_MAP);
+	ok;
+}
+
+/* Walling a remembered pile removes it, and the memory of it goes later */
+static int test_piles(void *state) {
+	struct loc grid = loc(player->grid.x + 1, player->grid.y);
+	struct loc tl = loc(grid.x - 1, grid.y - 1);
+	struct loc br = loc(grid.x + 2, grid.y + 2);
+	struct object *obj = object_new();
+	bool note = false;
+	int oidx;
+
+	square_set_feat(cave, grid, FEAT_FLOOR);
+	object_prep(obj, lookup_kind(TV_FLASK, 1), 0, RANDOMISE);
+	require(floor_carry(cave, grid, obj, &note));
+	oidx = obj->oidx;
+	square_know_pile(cave, grid);
+	notnull(obj->known);
+	notnull(square_object(player->cave, grid));
+
+	cave_batch_begin(cave, tl, br);
+	square_set_feat(cave, grid, FEAT_GRANITE);
+	cave_batch_end(cave);
+
+	/* The real object is gone, but is kept while it is remembered */
+	null(square_object(cave, grid));
+	object_lists_check_integrity(cave, player->cave);
+	require(counts_match(cave));
+
+	/* Seeing the grid again forgets it for good */
+	square_know_pile(cave, grid);
+	null(square_object(player->cave, grid));
+	null(cave->objects[oidx]);
+	null(player->cave->objects[oidx]);
+	ok;
+}
+
+/* Earthquakes and destruction move the terrain stamp on just once */
+static int test_effects(void *state) {
+	u32b stamp;
+
+	player->mhp = player->chp = 30000;
+
+	stamp = cave->terrain_stamp;
+	effect_simple(EF_EARTHQUAKE, source_player(), "0", 0, 10, 0, 0, 0,
+		NULL);
+	null(cave->batch);
+	eq(cave->terrain_stamp, stamp + 1);
+	require(counts_match(cave));
+	require(planes_match(cave));
+
+	stamp = cave->terrain_stamp;
+	effect_simple(EF_DESTRUCTION, source_player(), "0", 0, 15, 0, 0, 0,
+		NULL);
+	null(cave->batch);
+	eq(cave->terrain_stamp, stamp + 1);
+	require(counts_match(cave));
+	require(planes_match(cave));
+	ok;
+}
+
+const char *suite_name = "cave/batch";
+struct test tests[] = {
+	{ "level", test_level },
+	{ "piles", test_piles },
+	{ "batch", test_batch },
+	{ "effects", test_effects },
+	{ NULL, NULL }
+};
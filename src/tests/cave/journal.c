@@ -0,0 +1,139 @@
+/* cave/journal */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "init.h"
+#include "player.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		*state = NULL;
+		return 1;
+	}
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		*state = NULL;
+		return 1;
+	}
+
+	/* Stand in for the player's map */
+	player->cave = cave_new(20, 30);
+	*state = player->cave;
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	player->cave = NULL;
+	cleanup_angband();
+	return 0;
+}
+
+static int test_note_read(void *state) {
+	struct chunk *c = state;
+	const struct known_change *changes;
+	u32b cursor = c->journal.next;
+	int n;
+
+	player->upkeep->redraw = 0;
+	cave_journal_note(c, loc(3, 4), KNOWN_CHANGE_FEAT);
+	cave_journal_note(c, loc(3, 4), KNOWN_CHANGE_TRAP);
+	cave_journal_note(c, loc(5, 6), KNOWN_CHANGE_OBJECT);
+	require(player->upkeep->redraw & PR_KNOWN);
+
+	eq(cave_journal_read(c, &cursor, &changes, &n), true);
+	eq(n, 3);
+	require(loc_eq(changes[0].grid, loc(3, 4)));
+	eq(changes[0].what, KNOWN_CHANGE_FEAT);
+	require(loc_eq(changes[1].grid, loc(3, 4)));
+	eq(changes[1].what, KNOWN_CHANGE_TRAP);
+	require(loc_eq(changes[2].grid, loc(5, 6)));
+	eq(changes[2].what, KNOWN_CHANGE_OBJECT);
+
+	/* Nothing more to read */
+	eq(cave_journal_read(c, &cursor, &changes, &n), true);
+	eq(n, 0);
+
+	/* A change to the grid changed last is still new to readers */
+	cave_journal_note(c, loc(5, 6), KNOWN_CHANGE_FEAT);
+	eq(cursor + 1, c->journal.next);
+	eq(cave_journal_read(c, &cursor, &changes, &n), true);
+	eq(n, 1);
+	require(loc_eq(changes[0].grid, loc(5, 6)));
+	eq(changes[0].what, KNOWN_CHANGE_FEAT);
+	ok;
+}
+
+static int test_other_chunk(void *state) {
+	struct chunk *other = cave_new(5, 5);
+	u32b next = other->journal.next;
+
+	/* Only the player's map keeps a journal */
+	cave_journal_note(other, loc(1, 1), KNOWN_CHANGE_FEAT);
+	eq(other->journal.next, next);
+	null(other->journal.changes);
+	cave_free(other);
+	ok;
+}
+
+static int test_overflow(void *state) {
+	struct chunk *c = state;
+	const struct known_change *changes;
+	u32b cursor = c->journal.next, behind;
+	int i, n;
+
+	/* A reader that falls too far behind has to redraw everything */
+	for (i = 0; i < KNOWN_JOURNAL_MAX + 5; i++) {
+		cave_journal_note(c, loc(i % c->width, (i / c->width) % c->height),
+			KNOWN_CHANGE_FEAT);
+	}
+	behind = cursor;
+	eq(cave_journal_read(c, &cursor, &changes, &n), false);
+	eq(n, 0);
+	eq(cursor, c->journal.next);
+	eq(cave_journal_read(c, &cursor, &changes, &n), true);
+	eq(n, 0);
+
+	/* So does one whose cursor is from some other map */
+	behind = c->journal.next + 10;
+	eq(cave_journal_read(c, &behind, &changes, &n), false);
+
+	/* And everyone does after a change to the whole map */
+	cave_journal_all(c);
+	eq(cave_journal_read(c, &cursor, &changes, &n), false);
+	eq(cave_journal_read(c, &cursor, &changes, &n), true);
+	ok;
+}
+
+static int test_memorize(void *state) {
+	struct chunk *c = state;
+	const struct known_change *changes;
+	u32b cursor = c->journal.next;
+	int n;
+
+	/* Learning terrain is journalled, relearning the same isn't */
+	cave = cave_new(c->height, c->width);
+	square_set_feat(cave, loc(2, 2), FEAT_FLOOR);
+	square_memorize(cave, loc(2, 2));
+	square_memorize(cave, loc(2, 2));
+	cave_free(cave);
+	cave = NULL;
+	eq(cave_journal_read(c, &cursor, &changes, &n), true);
+	eq(n, 1);
+	eq(changes[0].what, KNOWN_CHANGE_FEAT);
+	ok;
+}
+
+const char *suite_name = "cave/journal";
+struct test tests[] = {
+	{ "note_read", test_note_read },
+	{ "other_chunk", test_other_chunk },
+	{ "overflow", test_overflow },
+	{ "memorize", test_memorize },
+	{ NULL, NULL }
+};
@@ -0,0 +1,168 @@
+/* cave/planes */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "cave.h"
+#include "effects.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "player-util.h"
+#include "source.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/* What each plane should hold for a grid */
+static bool in_plane(struct chunk *c, int plane, struct loc grid)
+{
+	switch (plane) {
+		case PLANE_DOOR: return square_isdoor(c, grid);
+		case PLANE_SECRET_DOOR: return square_issecretdoor(c, grid);
+		case PLANE_STAIR: return square_isstairs(c, grid);
+		case PLANE_GOLD: return square_hasgoldvein(c, grid);
+	}
+	return false;
+}
+
+/* Check a plane search against looking at every grid of the area */
+static bool plane_matches(struct chunk *c, int plane, struct loc tl,
+		struct loc br)
+{
+	struct point_set *found = cave_plane_find(c, plane, tl, br);
+	int n = 0, x, y;
+	bool same = true;
+
+	for (y = tl.y; same && y < br.y; y++) {
+		for (x = tl.x; same && x < br.x; x++) {
+			if (!in_plane(c, plane, loc(x, y))) continue;
+			same = (n < found->n) && loc_eq(found->pts[n], loc(x, y));
+			n++;
+		}
+	}
+	same = same && (n == found->n);
+	point_set_dispose(found);
+	return same;
+}
+
+static bool all_planes_match(struct chunk *c)
+{
+	int plane;
+
+	for (plane = 0; plane < PLANE_MAX; plane++) {
+		if (!plane_matches(c, plane, loc(0, 0), loc(c->width, c->height)) ||
+			!plane_matches(c, plane, loc(5, 3), loc(c->width / 2, 20)))
+			return false;
+	}
+	return true;
+}
+
+static int test_level(void *state) {
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player_change_place(player, 10);
+	prepare_next_level(player);
+	on_new_level();
+	notnull(cave);
+	player->upkeep->generate_level = false;
+
+	require(all_planes_match(cave));
+	cave_known(player);
+	require(all_planes_match(player->cave));
+	ok;
+}
+
+/* Changes to terrain, real or known, are kept up with */
+static int test_changes(void *state) {
+	struct loc grid;
+
+	require(cave_find(cave, &grid, square_isempty));
+	require(cave_planes_current(cave));
+	place_secret_door(cave, grid);
+	require(cave_planes_current(cave));
+	require(all_planes_match(cave));
+
+	square_memorize(cave, grid);
+	require(all_planes_match(player->cave));
+	square_set_feat(cave, grid, FEAT_MORE);
+	square_memorize(cave, grid);
+	require(all_planes_match(cave));
+	require(all_planes_match(player->cave));
+	square_set_feat(cave, grid, FEAT_FLOOR);
+	square_forget(cave, grid);
+	require(all_planes_match(cave));
+	require(all_planes_match(player->cave));
+	ok;
+}
+
+/* Detection finds what looking at every grid would */
+static int test_detect(void *state) {
+	int i, x, y, doors = 0;
+	struct loc grid;
+	struct point_set *secret = point_set_new(16);
+
+	/* Add some doors in case the level has none */
+	for (i = 0; i < 10 && cave_find(cave, &grid, square_isempty); i++) {
+		place_closed_door(cave, grid);
+	}
+
+	/* Forget the level, and hide some doors */
+	for (y = 1; y < cave->height - 1; y++) {
+		for (x = 1; x < cave->width - 1; x++) {
+			grid = loc(x, y);
+
+			if (square_isdoor(cave, grid) && (doors++ % 2)) {
+				place_secret_door(cave, grid);
+				add_to_point_set(secret, grid);
+			}
+			square_forget(cave, grid);
+		}
+	}
+
+	require(point_set_size(secret) > 1);
+	effect_simple(EF_DETECT_DOORS, source_player(), "0", 0, 0, 0,
+		cave->height, cave->width, NULL);
+	effect_simple(EF_DETECT_STAIRS, source_player(), "0", 0, 0, 0,
+		cave->height, cave->width, NULL);
+	effect_simple(EF_DETECT_GOLD, source_player(), "0", 0, 0, 0,
+		cave->height, cave->width, NULL);
+
+	for (y = 1; y < cave->height - 1; y++) {
+		for (x = 1; x < cave->width - 1; x++) {
+			struct loc grid = loc(x, y);
+
+			/* Door detection only memorizes the doors that were hidden */
+			require(!square_issecretdoor(cave, grid));
+			if (point_set_contains(secret, grid) ||
+				square_isstairs(cave, grid) ||
+				square_hasgoldvein(cave, grid)) {
+				require(!square_isnotknown(cave, grid));
+			} else {
+				require(!square_isknown(cave, grid));
+			}
+		}
+	}
+	point_set_dispose(secret);
+	require(all_planes_match(cave));
+	require(all_planes_match(player->cave));
+	ok;
+}
+
+const char *suite_name = "cave/planes";
+struct test tests[] = {
+	{ "level", test_level },
+	{ "changes", test_changes },
+	{ "detect", test_detect },
+	{ NULL, NULL }
+};
@@ -0,0 +1,208 @@
+/* cave/render */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include <stdio.h>
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "obj-ignore.h"
+#include "obj-pile.h"
+#include "object.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "player-util.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/* What map_info() used to work out for every grid, to check against */
+static void ref_known(struct loc grid, struct grid_data *g)
+{
+	struct object *obj;
+
+	g->f_idx = square(player->cave, grid)->feat;
+	if (f_info[g->f_idx].mimic)
+		g->f_idx = lookup_feat(f_info[g->f_idx].mimic);
+
+	g->first_kind = NULL;
+	g->multiple_objects = false;
+	g->unseen_object = false;
+	g->unseen_money = false;
+	for (obj = square_object(player->cave, grid); obj; obj = obj->next) {
+		if (obj->kind == unknown_gold_kind) {
+			g->unseen_money = true;
+		} else if (obj->kind == unknown_item_kind) {
+			g->unseen_object = true;
+		} else if (ignore_known_item_ok(player, obj)) {
+			/* Item stays hidden */
+		} else if (!g->first_kind) {
+			g->first_kind = obj->kind;
+		} else {
+			g->multiple_objects = true;
+			break;
+		}
+	}
+}
+
+static bool same_as_ref(struct loc grid)
+{
+	struct grid_data g, ref;
+
+	map_info(grid, &g);
+	ref_known(grid, &ref);
+	return g.f_idx == ref.f_idx && g.first_kind == ref.first_kind &&
+		g.multiple_objects == ref.multiple_objects &&
+		g.unseen_object == ref.unseen_object &&
+		g.unseen_money == ref.unseen_money;
+}
+
+static int check_all(void)
+{
+	int x, y;
+
+	for (y = 0; y < cave->height; y++)
+		for (x = 0; x < cave->width; x++)
+			if (!same_as_ref(loc(x, y))) return 0;
+	return 1;
+}
+
+/* Mimics are resolved when the terrain is read in */
+static int test_mimic(void *state) {
+	int i, mimics = 0;
+
+	for (i = 0; i < z_info->f_max; i++) {
+		if (f_info[i].mimic) {
+			eq(f_info[i].mimic_idx, lookup_feat(f_info[i].mimic));
+			mimics++;
+		} else {
+			eq(f_info[i].mimic_idx, i);
+		}
+	}
+	require(mimics > 0);
+	ok;
+}
+
+static int test_level(void *state) {
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player_change_place(player, 10);
+	prepare_next_level(player);
+	on_new_level();
+	notnull(cave);
+	notnull(player->cave);
+
+	/* Once to fill the cache, and again to read it */
+	cave_known(player);
+	require(check_all());
+	require(check_all());
+	ok;
+}
+
+/* Changes to the player's knowledge of a grid show straight away */
+static int test_objects(void *state) {
+	struct loc grid = player->grid;
+	struct grid_data g;
+	struct object *obj;
+
+	map_info(grid, &g);
+	place_object(cave, grid, 10, false, false, ORIGIN_FLOOR, 0);
+	place_object(cave, grid, 10, false, false, ORIGIN_FLOOR, 0);
+	obj = square_object(cave, grid);
+	notnull(obj);
+	square_know_pile(cave, grid);
+	require(same_as_ref(grid));
+	map_info(grid, &g);
+	notnull(g.first_kind);
+
+	/* Ignoring an object changes how the grid looks */
+	obj->known->notice |= OBJ_NOTICE_IGNORE;
+	player->upkeep->notice |= PN_IGNORE;
+	notice_stuff(player);
+	require(same_as_ref(grid));
+	map_info(grid, &g);
+	null(g.first_kind);
+
+	/* Showing ignored items brings it back before notice_stuff() runs */
+	player->unignoring = true;
+	ignore_settings_changed(player);
+	require(same_as_ref(grid));
+	map_info(grid, &g);
+	notnull(g.first_kind);
+	player->unignoring = false;
+	ignore_settings_changed(player);
+	require(same_as_ref(grid));
+	map_info(grid, &g);
+	null(g.first_kind);
+	notice_stuff(player);
+
+	/* As does forgetting the pile */
+	square_excise_pile(player->cave, grid);
+	require(same_as_ref(grid));
+	map_info(grid, &g);
+	null(g.first_kind);
+	eq(g.multiple_objects, false);
+	ok;
+}
+
+/*
+ * Time map_info() over the whole level with the cache in use and with it
+ * thrown away every pass.  This only reports the times (when run verbosely);
+ * it doesn't fail on slow machines.
+ */
+static int test_benchmark(void *state) {
+	struct grid_data g;
+	clock_t start, cold, warm;
+	int n, x, y;
+	long sink = 0;
+
+	start = clock();
+	for (n = 0; n < 100; n++) {
+		map_render_forget_all();
+		for (y = 0; y < cave->height; y++) {
+			for (x = 0; x < cave->width; x++) {
+				map_info(loc(x, y), &g);
+				sink += g.f_idx;
+			}
+		}
+	}
+	cold = clock() - start;
+
+	start = clock();
+	for (n = 0; n < 100; n++) {
+		for (y = 0; y < cave->height; y++) {
+			for (x = 0; x < cave->width; x++) {
+				map_info(loc(x, y), &g);
+				sink += g.f_idx;
+			}
+		}
+	}
+	warm = clock() - start;
+
+	if (verbose) {
+		printf("\n    100 maps: uncached %ld ms, cached %ld ms (%ld)  ",
+			(long) (cold * 1000 / CLOCKS_PER_SEC),
+			(long) (warm * 1000 / CLOCKS_PER_SEC), sink & 1);
+	}
+	ok;
+}
+
+const char *suite_name = "cave/render";
+struct test tests[] = {
+	{ "mimic", test_mimic },
+	{ "level", test_level },
+	{ "objects", test_objects },
+	{ "benchmark", test_benchmark },
+	{ NULL, NULL }
+};
@@ -1 +1,5 @@
 TESTPROGS += cave/scatter
+TESTPROGS += cave/journal
+TESTPROGS += cave/render
+TESTPROGS += cave/planes
+TESTPROGS += cave/batch
@@ -0,0 +1,112 @@
+/* game/event */
+
+#include "unit-test.h"
+
+#include "game-event.h"
+
+NOSETUP
+
+int teardown_tests(void *state) {
+	event_remove_all_handlers();
+	return 0;
+}
+
+/* Record of the order the handlers were called in */
+static char calls[32];
+static int n_calls;
+
+static void note_call(game_event_type type, game_event_data *data, void *user)
+{
+	if (n_calls < (int) sizeof(calls) - 1)
+		calls[n_calls++] = *((const char *) user);
+	calls[n_calls] = '\0';
+}
+
+static void remove_self(game_event_type type, game_event_data *data,
+		void *user)
+{
+	note_call(type, data, user);
+	event_remove_handler(type, remove_self, user);
+}
+
+static void reset_calls(void)
+{
+	n_calls = 0;
+	calls[0] = '\0';
+}
+
+/* Handlers are called newest first, and can come and go */
+static int test_order(void *state) {
+	event_stats_reset(false);
+	reset_calls();
+	event_add_handler(EVENT_GOLD, note_call, "a");
+	event_add_handler(EVENT_GOLD, note_call, "b");
+	event_add_handler(EVENT_GOLD, remove_self, "c");
+	event_add_handler(EVENT_GOLD, note_call, "d");
+	event_signal(EVENT_GOLD);
+	require(streq(calls, "dcba"));
+
+	reset_calls();
+	event_remove_handler(EVENT_GOLD, note_call, "b");
+	event_signal(EVENT_GOLD);
+	require(streq(calls, "da"));
+
+	eq(event_stats(EVENT_GOLD)->signals, 2);
+	eq(event_stats(EVENT_GOLD)->deliveries, 6);
+	require(streq(event_name(EVENT_GOLD), "GOLD"));
+	require(streq(event_name(EVENT_END), "END"));
+
+	event_remove_handler_type(EVENT_GOLD);
+	reset_calls();
+	event_signal(EVENT_GOLD);
+	require(streq(calls, ""));
+	ok;
+}
+
+/* List redraws are merged and delivered before the screen is refreshed */
+static int test_coalesce(void *state) {
+	event_stats_reset(false);
+	reset_calls();
+	event_add_handler(EVENT_MONSTERLIST, note_call, "m");
+	event_add_handler(EVENT_ITEMLIST, note_call, "i");
+	event_add_handler(EVENT_REFRESH, note_call, "r");
+
+	event_signal(EVENT_MONSTERLIST);
+	event_signal(EVENT_ITEMLIST);
+	event_signal(EVENT_MONSTERLIST);
+	event_signal(EVENT_MONSTERLIST);
+	require(streq(calls, ""));
+
+	event_signal(EVENT_REFRESH);
+	require(streq(calls, "imr"));
+	eq(event_stats(EVENT_MONSTERLIST)->signals, 3);
+	eq(event_stats(EVENT_MONSTERLIST)->coalesced, 2);
+	eq(event_stats(EVENT_MONSTERLIST)->deliveries, 1);
+
+	/* Nothing is left waiting */
+	reset_calls();
+	event_signal(EVENT_REFRESH);
+	require(streq(calls, "r"));
+
+	/* Or delivered on demand */
+	reset_calls();
+	event_signal(EVENT_ITEMLIST);
+	event_deliver_pending();
+	require(streq(calls, "i"));
+
+	/* A signal with no one to hear it is dropped */
+	reset_calls();
+	event_remove_handler(EVENT_ITEMLIST, note_call, "i");
+	event_signal(EVENT_ITEMLIST);
+	event_add_handler(EVENT_ITEMLIST, note_call, "i");
+	event_signal(EVENT_REFRESH);
+	require(streq(calls, "r"));
+	ok;
+}
+
+const char *suite_name = "game/event";
+struct test tests[] = {
+	{ "order", test_order },
+	{ "coalesce", test_coalesce },
+	{ NULL, NULL }
+};
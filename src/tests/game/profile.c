@@ -0,0 +1,108 @@
+/* game/profile */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "mon-move.h"
+#include "mon-util.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "player-util.h"
+#include "z-profile.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+static void play_turns(int n)
+{
+	while (n--) {
+		update_view(cave, player);
+		make_noise(cave, player, NULL);
+		update_monsters(player, true);
+		player->chp = player->mhp;
+		process_monsters(0);
+		reset_monsters();
+		turn++;
+		profile_turn();
+	}
+}
+
+/* Builds without profiling measure nothing, and say so */
+static int test_disabled(void *state) {
+	int i;
+
+	if (profile_is_enabled()) ok;
+
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player_change_place(player, 20);
+	prepare_next_level(player);
+	on_new_level();
+	player->upkeep->generate_level = false;
+
+	profile_start();
+	eq(profile_running(), false);
+	play_turns(5);
+	for (i = 0; i < PZ_MAX; i++) {
+		notnull(profile_zone_name(i));
+		eq(profile_stats(i)->calls, 0);
+	}
+	ok;
+}
+
+/* The zones count their calls and turns, and fill in their histograms */
+static int test_zones(void *state) {
+	const struct profile_zone_stats *stats;
+	long sum = 0;
+	int i;
+
+	if (!profile_is_enabled()) ok;
+
+	profile_start();
+	require(profile_running());
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player_change_place(player, 20);
+	prepare_next_level(player);
+	on_new_level();
+	player->upkeep->generate_level = false;
+	play_turns(10);
+	profile_stop();
+	eq(profile_running(), false);
+
+	stats = profile_stats(PZ_CAVE_GENERATE);
+	require(stats->calls >= 1);
+	stats = profile_stats(PZ_UPDATE_VIEW);
+	require(stats->calls >= 10);
+	require(stats->turns >= 10);
+	for (i = 0; i < PROFILE_BUCKETS; i++)
+		sum += stats->histogram[i];
+	eq(sum, stats->turns);
+	require(stats->total >= stats->worst_turn);
+	eq(profile_stats(PZ_MAKE_NOISE)->turns, 10);
+	eq(profile_stats(PZ_PROCESS_MONSTERS)->calls, 10);
+
+	/* Nothing more is counted once stopped */
+	play_turns(1);
+	eq(profile_stats(PZ_PROCESS_MONSTERS)->calls, 10);
+	ok;
+}
+
+const char *suite_name = "game/profile";
+struct test tests[] = {
+	{ "disabled", test_disabled },
+	{ "zones", test_zones },
+	{ NULL, NULL }
+};
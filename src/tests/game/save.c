@@ -0,0 +1,190 @@
+/* game/save.c */
+/* Check that the dungeon squares come back from a savefile as they went in. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "savefile.h"
+#include "player.h"
+#include "player-birth.h"
+#include "z-util.h"
+
+/* The squares of a chunk as they were before saving */
+struct squares_copy {
+	int height, width;
+	byte *feat;
+	bitflag *info;
+};
+
+static struct squares_copy saved_cave, saved_known;
+
+static void copy_squares(struct chunk *c, struct squares_copy *copy)
+{
+	int y, x;
+
+	mem_free(copy->feat);
+	mem_free(copy->info);
+	copy->height = c->height;
+	copy->width = c->width;
+	copy->feat = mem_zalloc(c->height * c->width);
+	copy->info = mem_zalloc(c->height * c->width * SQUARE_SIZE);
+	for (y = 0; y < c->height; y++) {
+		for (x = 0; x < c->width; x++) {
+			int n = y * c->width + x;
+
+			copy->feat[n] = c->squares[y][x].feat;
+			sqinfo_copy(copy->info + n * SQUARE_SIZE,
+				c->squares[y][x].info);
+		}
+	}
+}
+
+static void free_copy(struct squares_copy *copy)
+{
+	mem_free(copy->feat);
+	copy->feat = NULL;
+	mem_free(copy->info);
+	copy->info = NULL;
+}
+
+static bool squares_match(struct chunk *c, const struct squares_copy *copy)
+{
+	int y, x;
+
+	if (c->height != copy->height || c->width != copy->width) return false;
+	for (y = 0; y < c->height; y++) {
+		for (x = 0; x < c->width; x++) {
+			int n = y * c->width + x;
+
+			if (c->squares[y][x].feat != copy->feat[n]) return false;
+			if (!sqinfo_is_equal(c->squares[y][x].info,
+					copy->info + n * SQUARE_SIZE)) return false;
+		}
+	}
+	return true;
+}
+
+static void reset_before_load(void) {
+	play_again = true;
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	chunk_list_max = 0;
+	init_angband();
+	play_again = false;
+}
+
+/*
+ * Get a feature for a grid, making rows that repeat the one above, rows of
+ * single grids, rows of runs of every length from one up, and rows with no
+ * pattern to speak of
+ */
+static int painted_feat(int x, int y)
+{
+	int feats[4] = { FEAT_GRANITE, FEAT_MAGMA, FEAT_QUARTZ, FEAT_RUBBLE };
+	int run = 1;
+
+	switch (y % 8) {
+		case 0: case 1: case 2: case 3:
+			return feats[x % 2];
+		case 4:
+			while (x >= run) {
+				x -= run;
+				run++;
+			}
+			return feats[run % 4];
+		case 5:
+			return feats[(x * 7 + y * 13 + x * x) % 4];
+		default:
+			return -1;
+	}
+}
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	file_delete("TestSave");
+	free_copy(&saved_cave);
+	free_copy(&saved_known);
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+static int test_save(void *state) {
+	struct loc grid;
+	int i;
+
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	prepare_next_level(player);
+	on_new_level();
+	notnull(cave);
+
+	/* Paint the level, leaving the player and its edges alone */
+	for (i = 1; i < cave_monster_max(cave); i++) {
+		if (cave_monster(cave, i)->race) delete_monster_idx(i);
+	}
+	for (grid.y = 1; grid.y < cave->height - 1; grid.y++) {
+		for (grid.x = 1; grid.x < cave->width - 1; grid.x++) {
+			int feat = painted_feat(grid.x, grid.y);
+
+			if (feat < 0 || loc_eq(grid, player->grid)) continue;
+			square_set_feat(cave, grid, feat);
+			square_memorize(cave, grid);
+		}
+	}
+	copy_squares(cave, &saved_cave);
+	copy_squares(player->cave, &saved_known);
+
+	/* The second save reuses the first one's map of the level */
+	eq(savefile_save("TestSave"), true);
+	eq(savefile_save("TestSave"), true);
+	ok;
+}
+
+static int test_load(void *state) {
+	reset_before_load();
+	eq(savefile_load("TestSave", false), true);
+	notnull(cave);
+	require(squares_match(cave, &saved_cave));
+	require(squares_match(player->cave, &saved_known));
+	ok;
+}
+
+/* A change to the player's map after a save is in the next one */
+static int test_resave(void *state) {
+	struct loc grid = loc(2, 1);
+
+	require(square_isknown(cave, grid));
+	square_forget(cave, grid);
+	copy_squares(cave, &saved_cave);
+	copy_squares(player->cave, &saved_known);
+	eq(savefile_save("TestSave"), true);
+
+	reset_before_load();
+	eq(savefile_load("TestSave", false), true);
+	require(squares_match(cave, &saved_cave));
+	require(squares_match(player->cave, &saved_known));
+	eq(square(player->cave, grid)->feat, FEAT_NONE);
+	ok;
+}
+
+const char *suite_name = "game/save";
+struct test tests[] = {
+	{ "save", test_save },
+	{ "load", test_load },
+	{ "resave", test_resave },
+	{ NULL, NULL }
+};
@@ -1,2 +1,5 @@
 TESTPROGS += game/basic \
-	game/mage
+	game/event \
+	game/mage \
+	game/profile \
+	game/save
@@ -0,0 +1,174 @@
+/* monster/crowd */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include <stdio.h>
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "mon-move.h"
+#include "mon-timed.h"
+#include "mon-util.h"
+#include "monster.h"
+#include "player-birth.h"
+#include "player-util.h"
+
+#define CROWD_SIZE 600
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/*
+ * Fill a dungeon level with sleeping monsters; this is also the benchmark
+ * level for the per-turn monster loops.
+ */
+static int test_crowd(void *state) {
+	int tries, placed;
+
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player_change_place(player, 30);
+	prepare_next_level(player);
+	on_new_level();
+	notnull(cave);
+	player->upkeep->generate_level = false;
+
+	placed = cave_monster_count(cave);
+	for (tries = 0; placed < CROWD_SIZE && tries < 10 * CROWD_SIZE; tries++) {
+		struct loc grid;
+
+		if (!cave_find(cave, &grid, square_isempty)) break;
+		if (pick_and_place_monster(cave, grid, player->depth, true, false,
+				ORIGIN_DROP)) {
+			placed = cave_monster_count(cave);
+		}
+	}
+	require(cave_monster_count(cave) >= 500);
+	ok;
+}
+
+/* A monster's rarely used parts follow it when the list is compacted */
+static int test_compact(void *state) {
+	int i, last = 0;
+	struct loc grid;
+	struct monster *mon;
+
+	for (i = 1; i < cave_monster_max(cave); i++)
+		if (cave_monster(cave, i)->race) last = i;
+	require(last > 1);
+	grid = cave_monster(cave, last)->grid;
+	of_on(cave_monster_cold(cave, last)->known_pstate.flags, OF_PROT_FEAR);
+
+	/* Open a hole below it and close it up again */
+	for (i = 1; i < last; i++) {
+		if (cave_monster(cave, i)->race) {
+			delete_monster_idx(i);
+			break;
+		}
+	}
+	compact_monsters(cave, 0);
+
+	mon = square_monster(cave, grid);
+	notnull(mon);
+	require(mon->midx < last);
+	eq(of_has(cave_monster_cold(cave, mon->midx)->known_pstate.flags,
+		OF_PROT_FEAR), true);
+	require(of_is_empty(cave_monster_cold(cave, last)->known_pstate.flags));
+	ok;
+}
+
+/*
+ * Time the loops over every monster on the crowded level.  This only reports
+ * the times (when run verbosely); it doesn't fail on slow machines.
+ */
+static int test_benchmark(void *state) {
+	clock_t start, update, process;
+	int n;
+
+	start = clock();
+	for (n = 0; n < 500; n++)
+		update_monsters(player, true);
+	update = clock() - start;
+
+	start = clock();
+	for (n = 0; n < 500 && !player->is_dead; n++) {
+		player->chp = player->mhp;
+		process_monsters(0);
+		reset_monsters();
+		turn++;
+	}
+	process = clock() - start;
+
+	if (verbose) {
+		printf("\n    %d monsters: 500 updates %ld ms, 500 turns %ld ms  ",
+			cave_monster_count(cave),
+			(long) (update * 1000 / CLOCKS_PER_SEC),
+			(long) (process * 1000 / CLOCKS_PER_SEC));
+	}
+	ok;
+}
+
+/*
+ * Wake and hurt the crowd so it all acts, then frighten half the crowd and
+ * move the player about, checking that the shared maps never change where a
+ * monster chooses to flee or hide.
+ */
+static int test_flee(void *state) {
+	int i, n;
+
+	for (i = 1; i < cave_monster_max(cave); i++) {
+		struct monster *mon = cave_monster(cave, i);
+		if (!mon->race) continue;
+		mon->m_timed[MON_TMD_SLEEP] = 0;
+		if (mon->maxhp > 1) mon->hp = mon->maxhp - 1;
+		if (i % 2) mon->m_timed[MON_TMD_FEAR] = 200;
+	}
+
+	memset(&flee_map_stats, 0, sizeof(flee_map_stats));
+	flee_maps_verify = true;
+	for (n = 0; n < 200 && !player->is_dead; n++) {
+		struct loc grid;
+
+		if (n % 20 == 0 && cave_find(cave, &grid, square_isempty)) {
+			monster_swap(player->grid, grid);
+			update_view(cave, player);
+			make_noise(cave, player, NULL);
+			update_monsters(player, true);
+		}
+		player->chp = player->mhp;
+		process_monsters(0);
+		reset_monsters();
+		turn++;
+	}
+	flee_maps_verify = false;
+
+	require(flee_map_stats.searches > 0);
+	require(flee_map_stats.updates > 1);
+	eq(flee_map_stats.mismatches, 0);
+	if (verbose) {
+		printf("\n    %ld searches, %ld rings skipped, %ld map updates  ",
+			flee_map_stats.searches, flee_map_stats.rings_skipped,
+			flee_map_stats.updates);
+	}
+	ok;
+}
+
+const char *suite_name = "monster/crowd";
+struct test tests[] = {
+	{ "crowd", test_crowd },
+	{ "compact", test_compact },
+	{ "benchmark", test_benchmark },
+	{ "flee", test_flee },
+	{ NULL, NULL }
+};
@@ -0,0 +1,83 @@
+/* monster/list */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-list.h"
+#include "mon-make.h"
+#include "monster.h"
+#include "player-birth.h"
+#include "player-util.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/* Fill a list with some races in collection order, shallowest first */
+static size_t fill_list(monster_list_t *list)
+{
+	size_t n = 0;
+	int i;
+
+	monster_list_reset(list);
+	for (i = 1; i < z_info->r_max && n < 6 && n < list->entries_size; i++) {
+		if (!r_info[i].name || r_info[i].level < (int) n * 5) continue;
+		list->entries[n].race = &r_info[i];
+		list->entries[n].count[MONSTER_LIST_SECTION_LOS] = n + 1;
+		n++;
+	}
+	list->distinct_entries = n;
+	return n;
+}
+
+/* Sorting the same races twice gives the same order, through the kept one */
+static int test_sort(void *state) {
+	monster_list_t *list;
+	struct monster_race *sorted[6];
+	size_t i, n;
+
+	eq(player_make_simple(NULL, NULL, "Tester"), true);
+	player_change_place(player, 10);
+	prepare_next_level(player);
+	on_new_level();
+	player->upkeep->generate_level = false;
+
+	list = monster_list_new();
+	n = fill_list(list);
+	require(n > 2);
+	monster_list_sort(list, monster_list_standard_compare);
+	for (i = 0; i < n; i++) {
+		require(list->order[i] < n);
+		sorted[i] = list->entries[i].race;
+		if (i) require(sorted[i - 1]->level >= sorted[i]->level);
+	}
+
+	fill_list(list);
+	monster_list_sort(list, monster_list_standard_compare);
+	for (i = 0; i < n; i++) {
+		ptreq(list->entries[i].race, sorted[i]);
+		eq(list->entries[i].count[MONSTER_LIST_SECTION_LOS],
+			list->order[i] + 1);
+	}
+
+	monster_list_free(list);
+	ok;
+}
+
+const char *suite_name = "monster/list";
+struct test tests[] = {
+	{ "sort", test_sort },
+	{ NULL, NULL }
+};
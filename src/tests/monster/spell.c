@@ -0,0 +1,104 @@
+/* monster/spell */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "init.h"
+#include "mon-attack.h"
+#include "mon-spell.h"
+#include "monster.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/* Spells are found by index just as a walk through the list finds them */
+static int test_index(void *state) {
+	int i, found = 0;
+
+	for (i = FLAG_START; i < RSF_MAX; i++) {
+		const struct monster_spell *spell = monster_spells;
+
+		while (spell && spell->index != i) spell = spell->next;
+		ptreq(monster_spell_by_index(i), spell);
+		if (spell) found++;
+	}
+	require(found > 0);
+	null(monster_spell_by_index(RSF_NONE));
+	null(monster_spell_by_index(RSF_MAX));
+	ok;
+}
+
+/* The spell type masks agree with testing spells one at a time */
+static int test_masks(void *state) {
+	int i, type;
+
+	for (type = RST_BOLT; type <= RST_ARCHERY; type <<= 1) {
+		bitflag mask[RSF_SIZE];
+
+		create_mon_spell_mask(mask, type, RST_NONE);
+		for (i = FLAG_START; i < RSF_MAX; i++) {
+			bitflag one[RSF_SIZE];
+
+			rsf_wipe(one);
+			rsf_on(one, i);
+			eq(test_spells(one, type), rsf_has(mask, i));
+			ignore_spells(one, type);
+			eq(rsf_is_empty(one), rsf_has(mask, i));
+			if (type == RST_INNATE) {
+				eq(mon_spell_is_innate(i) ? true : false, rsf_has(mask, i));
+			}
+		}
+	}
+	ok;
+}
+
+/* Spells are picked from the right kind, in flag order */
+static int test_choose(void *state) {
+	int i, r, fix;
+	bitflag none[RSF_SIZE];
+
+	rsf_wipe(none);
+	eq(choose_attack_spell(none, true, true), 0);
+
+	for (r = 0; r < z_info->r_max; r++) {
+		const struct monster_race *race = &r_info[r];
+		int kind;
+
+		if (!race->name || rsf_is_empty(race->spell_flags)) continue;
+		for (kind = 0; kind < 3; kind++) {
+			bool innate = kind != 1, non_innate = kind != 0;
+			int spells[RSF_MAX], num = 0;
+
+			for (i = FLAG_START; i < RSF_MAX; i++) {
+				if (!innate && mon_spell_is_innate(i)) continue;
+				if (!non_innate && !mon_spell_is_innate(i)) continue;
+				if (rsf_has(race->spell_flags, i)) spells[num++] = i;
+			}
+			for (fix = 0; fix < 100; fix += 33) {
+				bitflag f[RSF_SIZE];
+
+				rsf_copy(f, race->spell_flags);
+				rand_fix(fix);
+				eq(choose_attack_spell(f, innate, non_innate),
+					num ? spells[randint0(num)] : 0);
+			}
+		}
+	}
+	ok;
+}
+
+const char *suite_name = "monster/spell";
+struct test tests[] = {
+	{ "index", test_index },
+	{ "masks", test_masks },
+	{ "choose", test_choose },
+	{ NULL, NULL }
+};
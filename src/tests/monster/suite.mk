@@ -1 +1,2 @@
-TESTPROGS += monster/attack monster/monster
+TESTPROGS += monster/attack monster/crowd monster/list monster/monster \
+	monster/spell
@@ -0,0 +1,197 @@
+/* object/desc */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "angband.h"
+#include "init.h"
+#include "obj-desc.h"
+#include "obj-ignore.h"
+#include "obj-knowledge.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-util.h"
+#include "player-birth.h"
+#include "z-quark.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+static const int modes[] = {
+	ODESC_BASE,
+	ODESC_PREFIX | ODESC_FULL,
+	ODESC_PREFIX | ODESC_FULL | ODESC_TERSE,
+	ODESC_FULL | ODESC_STORE,
+	ODESC_PLURAL | ODESC_SPOIL,
+	ODESC_CAPITAL | ODESC_SINGULAR | ODESC_NOEGO
+};
+
+static struct object *setup_object(int tval, int sval, int num)
+{
+	struct object *obj = object_new();
+
+	object_prep(obj, lookup_kind(tval, sval), 0, RANDOMISE);
+	obj->number = num;
+	obj->known = object_new();
+	object_set_base_known(player, obj);
+	object_touch(player, obj);
+	return obj;
+}
+
+static void free_object(struct object *obj)
+{
+	object_free(obj->known);
+	object_free(obj);
+}
+
+/* Check a description, possibly from the cache, against making it afresh */
+static bool desc_matches(const struct object *obj, int mode, size_t max)
+{
+	char buf[200], fresh[200];
+	size_t len, fresh_len;
+
+	len = object_desc(buf, max, obj, mode, player);
+	object_desc_forget_all();
+	fresh_len = object_desc(fresh, max, obj, mode, player);
+	return (len == fresh_len) && streq(buf, fresh);
+}
+
+static bool all_match(const struct object *obj)
+{
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(modes); i++) {
+		char buf[200];
+
+		/* Once to fill the cache, and again to read it */
+		object_desc(buf, sizeof(buf), obj, modes[i], player);
+		if (!desc_matches(obj, modes[i], sizeof(buf))) return false;
+	}
+	return true;
+}
+
+/* Descriptions are only made again when something in them has changed */
+static int test_hits(void *state) {
+	struct object *obj = setup_object(TV_SWORD, 1, 1);
+	char buf[80];
+	long hits;
+
+	object_desc(buf, sizeof(buf), obj, ODESC_PREFIX | ODESC_FULL, player);
+	hits = object_desc_stats.hits;
+	object_desc(buf, sizeof(buf), obj, ODESC_PREFIX | ODESC_FULL, player);
+	eq(object_desc_stats.hits, hits + 1);
+	require(all_match(obj));
+
+	/* Nothing is cached for an object once it has gone */
+	object_desc(buf, sizeof(buf), obj, ODESC_PREFIX | ODESC_FULL, player);
+	object_desc_forget(obj);
+	hits = object_desc_stats.hits;
+	object_desc(buf, sizeof(buf), obj, ODESC_PREFIX | ODESC_FULL, player);
+	eq(object_desc_stats.hits, hits);
+	free_object(obj);
+	ok;
+}
+
+/* Changes to the object or what the player knows show straight away */
+static int test_changes(void *state) {
+	struct object *potion = setup_object(TV_POTION, 1, 1);
+	struct object *sword = setup_object(TV_SWORD, 1, 1);
+	struct object *light = setup_object(TV_LIGHT, 1, 1);
+	char before[80], after[80];
+
+	require(all_match(potion));
+	require(all_match(sword));
+	require(all_match(light));
+
+	/* Stack size */
+	object_desc(before, sizeof(before), potion, ODESC_PREFIX | ODESC_FULL,
+		player);
+	potion->number = 3;
+	potion->known->number = 3;
+	object_desc(after, sizeof(after), potion, ODESC_PREFIX | ODESC_FULL,
+		player);
+	require(!streq(before, after));
+	require(all_match(potion));
+
+	/* Inscription */
+	potion->note = quark_add("cache");
+	object_desc(after, sizeof(after), potion, ODESC_PREFIX | ODESC_FULL,
+		player);
+	require(strstr(after, "cache") != NULL);
+	require(all_match(potion));
+
+	/* Flavour awareness */
+	object_desc(before, sizeof(before), potion, ODESC_BASE, player);
+	object_flavor_aware(player, potion);
+	object_desc(after, sizeof(after), potion, ODESC_BASE, player);
+	require(!streq(before, after));
+	require(all_match(potion));
+
+	/* Ignoring the kind, and showing ignored items again */
+	kind_ignore_when_aware(potion->kind);
+	object_desc(after, sizeof(after), potion, ODESC_FULL, player);
+	require(strstr(after, "ignore}") != NULL);
+	player->unignoring = true;
+	object_desc(after, sizeof(after), potion, ODESC_FULL, player);
+	require(strstr(after, "ignore}") == NULL);
+	player->unignoring = false;
+	object_desc(after, sizeof(after), potion, ODESC_FULL, player);
+	require(strstr(after, "ignore}") != NULL);
+	kind_ignore_clear(potion->kind);
+	object_desc(after, sizeof(after), potion, ODESC_FULL, player);
+	require(strstr(after, "ignore}") == NULL);
+	require(all_match(potion));
+
+	/* Combat bonuses, once the runes are known */
+	sword->to_h = 7;
+	sword->to_d = 3;
+	player_learn_all_runes(player);
+	player_know_object(player, sword);
+	object_desc(after, sizeof(after), sword, ODESC_FULL, player);
+	require(strstr(after, "(+7,+3)") != NULL);
+	require(all_match(sword));
+
+	/* Fuel */
+	light->timeout = 123;
+	require(all_match(light));
+
+	free_object(potion);
+	free_object(sword);
+	free_object(light);
+	ok;
+}
+
+/* Short buffers get what they would have without the cache */
+static int test_short(void *state) {
+	struct object *obj = setup_object(TV_SWORD, 1, 1);
+	size_t max;
+
+	for (max = 1; max < 40; max++) {
+		char buf[200];
+
+		object_desc(buf, sizeof(buf), obj, ODESC_PREFIX | ODESC_FULL, player);
+		require(desc_matches(obj, ODESC_PREFIX | ODESC_FULL, max));
+	}
+	free_object(obj);
+	ok;
+}
+
+const char *suite_name = "object/desc";
+struct test tests[] = {
+	{ "hits", test_hits },
+	{ "changes", test_changes },
+	{ "short", test_short },
+	{ NULL, NULL }
+};
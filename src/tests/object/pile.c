@@ -5,14 +5,23 @@
 #include "unit-test.h"
 #include "unit-test-data.h"
 
+#include "init.h"
 #include "object.h"
 #include "obj-pile.h"
 
 int setup_tests(void **state) {
+	z_info = mem_zalloc(sizeof(struct angband_constants));
+	z_info->slay_max = 12;
+	z_info->brand_max = 10;
+	z_info->curse_max = 6;
 	return 0;
 }
 
-NOTEARDOWN
+int teardown_tests(void *state) {
+	mem_free(z_info);
+	z_info = NULL;
+	return 0;
+}
 
 /* Testing the linked list functions in obj-pile.c */
 static int test_obj_piles(void *state) {
@@ -91,8 +100,63 @@ static int test_obj_piles(void *state) {
 	ok;
 }
 
+/* Freed objects and arrays are handed out again, cleared, while the pools
+ * are open */
+static int test_obj_pools(void *state) {
+	struct object_pool_stats before, after;
+	struct object *o1, *o2, *copy;
+	bool *slays;
+
+	obj_pile_module.init();
+
+	o1 = object_new();
+	o1->slays = object_new_slays();
+	o1->slays[3] = true;
+	o1->curses = object_new_curses();
+	o1->curses[2].power = 50;
+	o1->pval = 7;
+	slays = o1->slays;
+
+	/* Copies take their arrays from the pools too */
+	copy = object_new();
+	object_copy(copy, o1);
+	require(copy->slays != o1->slays);
+	eq(copy->slays[3], true);
+	eq(copy->curses[2].power, 50);
+	object_free(copy);
+
+	object_pool_stats(OBJ_POOL_OBJECT, &before);
+	object_free(o1);
+	object_pool_stats(OBJ_POOL_OBJECT, &after);
+	eq(after.cached, before.cached + 1);
+
+	/* The most recently freed blocks come back first, and clean */
+	o2 = object_new();
+	ptreq(o2, o1);
+	eq(o2->pval, 0);
+	null(o2->slays);
+	o2->slays = object_new_slays();
+	ptreq(o2->slays, slays);
+	eq(o2->slays[3], false);
+	object_pool_stats(OBJ_POOL_OBJECT, &after);
+	eq(after.reused, before.reused + 1);
+	eq(after.cached, before.cached);
+
+	/* Once closed, blocks go straight back to the system */
+	obj_pile_module.cleanup();
+	object_pool_stats(OBJ_POOL_SLAYS, &before);
+	eq(before.cached, 0);
+	object_free(o2);
+	object_pool_stats(OBJ_POOL_SLAYS, &after);
+	eq(after.cached, 0);
+	eq(after.returned, before.returned);
+
+	ok;
+}
+
 const char *suite_name = "object/pile";
 struct test tests[] = {
 	{ "pile checking", test_obj_piles },
+	{ "pools", test_obj_pools },
 	{ NULL, NULL }
 };
@@ -0,0 +1,142 @@
+/* object/randart */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#include "angband.h"
+#include "init.h"
+#include "obj-design.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+static bool flags_same(const bool *a, const bool *b, int max)
+{
+	int i;
+
+	for (i = 1; i < max; i++) {
+		if ((a && a[i]) != (b && b[i])) return false;
+	}
+	return true;
+}
+
+static bool same_artifact(const struct artifact *a, const struct artifact *b)
+{
+	int i;
+
+	if (!a->name || !b->name || !streq(a->name, b->name)) return false;
+	if (!a->text || !b->text || !streq(a->text, b->text)) return false;
+	if (a->tval != b->tval || a->sval != b->sval) return false;
+	if (a->to_h != b->to_h || a->to_d != b->to_d || a->to_a != b->to_a)
+		return false;
+	if (a->dd != b->dd || a->ds != b->ds || a->ac != b->ac) return false;
+	if (a->cost != b->cost || a->weight != b->weight) return false;
+	if (a->alloc_prob != b->alloc_prob || a->alloc_min != b->alloc_min ||
+		a->alloc_max != b->alloc_max) return false;
+	if (a->activation != b->activation) return false;
+	if (!of_is_equal(a->flags, b->flags)) return false;
+	if (memcmp(a->modifiers, b->modifiers, sizeof(a->modifiers))) return false;
+	if (memcmp(a->el_info, b->el_info, sizeof(a->el_info))) return false;
+	if (!flags_same(a->slays, b->slays, z_info->slay_max)) return false;
+	if (!flags_same(a->brands, b->brands, z_info->brand_max)) return false;
+	for (i = 1; i < z_info->curse_max; i++) {
+		int ca = a->curses ? a->curses[i] : 0;
+		int cb = b->curses ? b->curses[i] : 0;
+		if (ca != cb) return false;
+	}
+	return true;
+}
+
+/* Each artifact comes out the same whatever else is designed, in any order */
+static int test_streams(void *state) {
+	struct artifact *all = mem_zalloc(ART_NUM_RANDOM * sizeof(*all));
+	struct artifact *one = mem_zalloc(ART_NUM_RANDOM * sizeof(*one));
+	struct artifact part[5];
+	int i;
+
+	design_random_artifacts(0x1234567, all, 0, ART_NUM_RANDOM);
+	for (i = ART_NUM_RANDOM - 1; i >= 0; i--) {
+		design_random_artifacts(0x1234567, &one[i], i, 1);
+	}
+	for (i = 0; i < ART_NUM_RANDOM; i++) {
+		require(same_artifact(&all[i], &one[i]));
+	}
+
+	memset(part, 0, sizeof(part));
+	design_random_artifacts(0x1234567, part, 17, 5);
+	for (i = 0; i < 5; i++) {
+		require(same_artifact(&part[i], &all[17 + i]));
+	}
+
+	free_random_artifacts(all, ART_NUM_RANDOM);
+	free_random_artifacts(one, ART_NUM_RANDOM);
+	free_random_artifacts(part, 5);
+	mem_free(all);
+	mem_free(one);
+	ok;
+}
+
+/* Different seeds give different sets */
+static int test_seeds(void *state) {
+	struct artifact *a = mem_zalloc(ART_NUM_RANDOM * sizeof(*a));
+	struct artifact *b = mem_zalloc(ART_NUM_RANDOM * sizeof(*b));
+	int i, same = 0;
+
+	design_random_artifacts(1, a, 0, ART_NUM_RANDOM);
+	design_random_artifacts(2, b, 0, ART_NUM_RANDOM);
+	for (i = 0; i < ART_NUM_RANDOM; i++) {
+		if (same_artifact(&a[i], &b[i])) same++;
+	}
+	require(same < ART_NUM_RANDOM);
+
+	free_random_artifacts(a, ART_NUM_RANDOM);
+	free_random_artifacts(b, ART_NUM_RANDOM);
+	mem_free(a);
+	mem_free(b);
+	ok;
+}
+
+/* Serial sets, for older characters, are made in order from the set's seed */
+static int test_serial(void *state) {
+	struct artifact *all = mem_zalloc(ART_NUM_RANDOM * sizeof(*all));
+	struct artifact *streams = mem_zalloc(ART_NUM_RANDOM * sizeof(*streams));
+	struct artifact part[5];
+	int i, same = 0;
+
+	design_random_artifacts_serial(0x1234567, all, ART_NUM_RANDOM);
+	memset(part, 0, sizeof(part));
+	design_random_artifacts_serial(0x1234567, part, 5);
+	for (i = 0; i < 5; i++) {
+		require(same_artifact(&part[i], &all[i]));
+	}
+
+	/* The streams give a different set from the same seed */
+	design_random_artifacts(0x1234567, streams, 0, ART_NUM_RANDOM);
+	for (i = 0; i < ART_NUM_RANDOM; i++) {
+		if (same_artifact(&all[i], &streams[i])) same++;
+	}
+	require(same < ART_NUM_RANDOM);
+
+	free_random_artifacts(all, ART_NUM_RANDOM);
+	free_random_artifacts(streams, ART_NUM_RANDOM);
+	free_random_artifacts(part, 5);
+	mem_free(all);
+	mem_free(streams);
+	ok;
+}
+
+const char *suite_name = "object/randart";
+struct test tests[] = {
+	{ "streams", test_streams },
+	{ "seeds", test_seeds },
+	{ "serial", test_serial },
+	{ NULL, NULL }
+};
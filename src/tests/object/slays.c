@@ -7,6 +7,8 @@
 #include "init.h"
 #include "mon-spell.h"
 #include "obj-slays.h"
+#include "obj-tval.h"
+#include "player-attack.h"
 #include "player-birth.h"
 #include "player-timed.h"
 #include "z-color.h"
@@ -120,12 +122,9 @@ static void fill_in_monster(struct monster *mon, struct monster_race *race)
 	mon->mimicked_obj = NULL;
 	mon->held_obj = NULL;
 	mon->attr = race->d_attr;
-	memset(&mon->known_pstate, 0, sizeof(mon->known_pstate));
 	mon->target.grid = loc(0, 0);
 	mon->target.midx = 0;
 	memset(mon->group_info, 0, GROUP_MAX * sizeof(mon->group_info[0]));
-	mon->noise.grids = NULL;
-	mon->scent.grids = NULL;
 	mon->min_range = 0;
 	mon->best_range = 0;
 }
@@ -1114,6 +1113,191 @@ static int test_react_to_slay(void *state)
 	ok;
 }
 
+/*
+ * Attack profiles pick the same brand, slay and verb as passing the same
+ * sources through improve_attack_modifier(), for every race, and follow
+ * changes to what is on offer.
+ */
+static int test_attack_profile(void *state)
+{
+	struct slays_test_state *ts = state;
+	struct object_base weapon_base;
+	struct object_kind weapon_kind;
+	struct object weapon;
+	struct monster dummy;
+	struct attack_profile prof;
+	int trial, i1, n_races = 0;
+
+	fill_in_object_base(&weapon_base);
+	fill_in_object_kind(&weapon_kind, &weapon_base);
+	fill_in_object(&weapon, &weapon_kind);
+	weapon.brands = ts->brands;
+	weapon.slays = ts->slays;
+	memset(&prof, 0, sizeof(prof));
+
+	for (trial = 0; trial < 40; trial++) {
+		bool range = (trial % 2) != 0;
+		int temp_brand = 0;
+
+		/* A handful of brands and slays on the weapon, some temporary */
+		memset(ts->slays, 0, z_info->slay_max * sizeof(*ts->slays));
+		memset(ts->brands, 0, z_info->brand_max * sizeof(*ts->brands));
+		for (i1 = 1; i1 < z_info->brand_max; ++i1)
+			if (one_in_(3)) ts->brands[i1] = true;
+		for (i1 = 1; i1 < z_info->slay_max; ++i1)
+			if (one_in_(3)) ts->slays[i1] = true;
+		if (trial % 4 < 2) {
+			temp_brand = rand_range(1, z_info->brand_max - 1);
+			if (!set_temporary_brand(player, temp_brand)) temp_brand = 0;
+		}
+
+		attack_profile_begin(&prof, range);
+		attack_profile_add(&prof, player, &weapon);
+		attack_profile_add(&prof, player, NULL);
+		attack_profile_end(&prof);
+
+		for (i1 = 1; i1 < z_info->r_max; ++i1) {
+			struct monster_race *race = &r_info[i1];
+			int b, s, pb, ps;
+			char verb[20], pverb[20];
+
+			if (!race->name || !race->base) continue;
+			n_races++;
+			fill_in_monster(&dummy, race);
+
+			b = 0;
+			s = 0;
+			my_strcpy(verb, "hit", sizeof(verb));
+			improve_attack_modifier(player, &weapon, &dummy, &b, &s,
+				verb, range);
+			improve_attack_modifier(player, NULL, &dummy, &b, &s,
+				verb, range);
+
+			/* Twice, to check the kept choice as well */
+			my_strcpy(pverb, "hit", sizeof(pverb));
+			attack_profile_choose(&prof, &dummy, &pb, &ps, pverb);
+			require(pb == b && ps == s && streq(pverb, verb));
+			my_strcpy(pverb, "hit", sizeof(pverb));
+			attack_profile_choose(&prof, &dummy, &pb, &ps, pverb);
+			require(pb == b && ps == s && streq(pverb, verb));
+		}
+
+		if (temp_brand) require(clear_temporary_brand(player, temp_brand));
+	}
+	require(n_races > 0);
+
+	attack_profile_free(&prof);
+	weapon.brands = NULL;
+	weapon.slays = NULL;
+	ok;
+}
+
+/* A race whose flags change between blows gets a fresh choice */
+static int test_attack_profile_race_change(void *state)
+{
+	struct slays_test_state *ts = state;
+	struct object_base weapon_base;
+	struct object_kind weapon_kind;
+	struct object weapon;
+	struct monster_base dummy_base;
+	struct monster_race dummy_race;
+	struct monster dummy;
+	struct attack_profile prof;
+	int i1, b, s;
+	char verb[20];
+
+	fill_in_object_base(&weapon_base);
+	fill_in_object_kind(&weapon_kind, &weapon_base);
+	fill_in_object(&weapon, &weapon_kind);
+	fill_in_monster_base(&dummy_base);
+	fill_in_monster_race(&dummy_race, &dummy_base);
+	fill_in_monster(&dummy, &dummy_race);
+	memset(&prof, 0, sizeof(prof));
+
+	for (i1 = 1; i1 < z_info->slay_max; ++i1) {
+		if (slays[i1].race_flag) break;
+	}
+	require(i1 < z_info->slay_max);
+	memset(ts->slays, 0, z_info->slay_max * sizeof(*ts->slays));
+	memset(ts->brands, 0, z_info->brand_max * sizeof(*ts->brands));
+	ts->slays[i1] = true;
+	weapon.slays = ts->slays;
+	weapon.brands = ts->brands;
+
+	attack_profile_begin(&prof, false);
+	attack_profile_add(&prof, player, &weapon);
+	attack_profile_end(&prof);
+	my_strcpy(verb, "hit", sizeof(verb));
+	attack_profile_choose(&prof, &dummy, &b, &s, verb);
+	require(b == 0 && s == 0 && streq(verb, "hit"));
+
+	/* The same race, now vulnerable to the slay */
+	rf_on(dummy_race.flags, slays[i1].race_flag);
+	attack_profile_choose(&prof, &dummy, &b, &s, verb);
+	require(b == 0 && s == i1 && streq(verb, slays[i1].melee_verb));
+
+	/* And no longer */
+	rf_off(dummy_race.flags, slays[i1].race_flag);
+	my_strcpy(verb, "hit", sizeof(verb));
+	attack_profile_choose(&prof, &dummy, &b, &s, verb);
+	require(b == 0 && s == 0 && streq(verb, "hit"));
+
+	attack_profile_free(&prof);
+	weapon.brands = NULL;
+	weapon.slays = NULL;
+	ok;
+}
+
+/* Expected damage goes up with the dice, and with a slay against its races */
+static int test_attack_expected_damage(void *state)
+{
+	struct slays_test_state *ts = state;
+	struct object_base weapon_base;
+	struct object_kind weapon_kind;
+	struct object weapon;
+	int *brand_dam = mem_zalloc(z_info->brand_max * sizeof(*brand_dam));
+	int *slay_dam = mem_zalloc(z_info->slay_max * sizeof(*slay_dam));
+	int normal, bigger;
+	bool nonweap_slay;
+
+	fill_in_object_base(&weapon_base);
+	weapon_base.tval = TV_SWORD;
+	fill_in_object_kind(&weapon_kind, &weapon_base);
+	fill_in_object(&weapon, &weapon_kind);
+	weapon.known = &weapon;
+	memset(ts->slays, 0, z_info->slay_max * sizeof(*ts->slays));
+	memset(ts->brands, 0, z_info->brand_max * sizeof(*ts->brands));
+	weapon.slays = ts->slays;
+	weapon.brands = ts->brands;
+
+	require(!attack_expected_damage(player, &weapon, false, &normal,
+		brand_dam, slay_dam, &nonweap_slay));
+	require(normal > 0);
+	weapon.ds = 8;
+	require(!attack_expected_damage(player, &weapon, false, &bigger,
+		brand_dam, slay_dam, &nonweap_slay));
+	require(bigger > normal);
+
+	/* A slay only adds to the damage against the monsters it affects */
+	require(slays[1].multiplier > 10);
+	ts->slays[1] = true;
+	require(attack_expected_damage(player, &weapon, false, &normal,
+		brand_dam, slay_dam, &nonweap_slay));
+	eq(normal, bigger);
+	require(slay_dam[1] > normal);
+
+	/* Thrown, it does something too */
+	require(attack_expected_damage(player, &weapon, true, &normal,
+		brand_dam, slay_dam, &nonweap_slay));
+	require(normal > 0);
+
+	mem_free(brand_dam);
+	mem_free(slay_dam);
+	weapon.brands = NULL;
+	weapon.slays = NULL;
+	ok;
+}
+
 const char *suite_name = "object/slays";
 struct test tests[] = {
 	{ "same_monsters_slain", test_same_monsters_slain },
@@ -1122,5 +1306,8 @@ struct test tests[] = {
 	{ "get_monster_brand_multiplier", test_get_monster_brand_multiplier },
 	{ "improve_attack_modifier", test_improve_attack_modifier },
 	{ "react_to_slay", test_react_to_slay },
+	{ "attack_profile", test_attack_profile },
+	{ "attack_profile_race_change", test_attack_profile_race_change },
+	{ "attack_expected_damage", test_attack_expected_damage },
 	{ NULL, NULL }
 };
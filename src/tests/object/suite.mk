@@ -1 +1,3 @@
 TESTPROGS += object/alloc object/attack object/util object/pile object/slays
+TESTPROGS += object/desc
+TESTPROGS += object/randart
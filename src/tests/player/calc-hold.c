@@ -0,0 +1,273 @@
+/* player/calc-hold.c */
+/* Check that calc_bonuses() gives the same results inside and outside of
+ * a calc_bonuses_hold() window. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "obj-curse.h"
+#include "obj-gear.h"
+#include "obj-knowledge.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-tval.h"
+#include "obj-util.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* Set up the player. */
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	prepare_next_level(player);
+	on_new_level();
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+
+	return 0;
+}
+
+static struct object *make_test_object(int tval, const char *name) {
+	struct object_kind *kind = lookup_kind(tval, lookup_sval(tval, name));
+	struct object *obj;
+
+	if (!kind) return NULL;
+	obj = object_new();
+	object_prep(obj, kind, 0, AVERAGE);
+	obj->known = object_new();
+	object_set_base_known(player, obj);
+	return obj;
+}
+
+static void free_object(struct object *obj) {
+	if (obj->known) {
+		object_free(obj->known);
+	}
+	object_free(obj);
+}
+
+/*
+ * Work out the player's state as obj-info.c does for blows, with the given
+ * offsets to the strength and dexterity indices.
+ */
+static void calc_state(bool known_only, int str_plus, int dex_plus,
+		struct player_state *state) {
+	memcpy(state, &player->state, sizeof(*state));
+	state->stat_ind[STAT_STR] = str_plus;
+	state->stat_ind[STAT_DEX] = dex_plus;
+	calc_bonuses(player, state, known_only, false);
+}
+
+/*
+ * Put each of objs (NULL for an empty slot) in the slot in turn, twice over,
+ * within one hold window, and check each result against a calculation made
+ * with no window open.  Both the true and known states are worked out for
+ * each object so the two sets of remembered slots are mixed.
+ */
+static bool check_swaps(int slot, struct object **objs, int n) {
+	struct object *old = player->body.slots[slot].obj;
+	struct player_state *plain = mem_zalloc(2 * n * sizeof(*plain));
+	struct player_state held;
+	bool result = true;
+	int pass, i, k;
+
+	for (i = 0; i < n; i++) {
+		player->body.slots[slot].obj = objs[i];
+		for (k = 0; k < 2; k++) {
+			calc_state(k == 1, 0, 0, &plain[2 * i + k]);
+		}
+	}
+
+	calc_bonuses_hold();
+	for (pass = 0; pass < 2; pass++) {
+		for (i = 0; i < n; i++) {
+			player->body.slots[slot].obj = objs[i];
+			for (k = 0; k < 2; k++) {
+				/* Nesting leaves the window as it is. */
+				if (pass == 1) calc_bonuses_hold();
+				calc_state(k == 1, 0, 0, &held);
+				if (pass == 1) calc_bonuses_release();
+				if (memcmp(&held, &plain[2 * i + k], sizeof(held))) {
+					result = false;
+				}
+			}
+		}
+	}
+	calc_bonuses_release();
+
+	player->body.slots[slot].obj = old;
+	mem_free(plain);
+	return result;
+}
+
+/* Weapons and diggers swapped into the weapon slot */
+static int test_weapon_swaps(void *state) {
+	int slot = slot_by_name(player, "weapon");
+	struct object *objs[5];
+	int i;
+
+	objs[0] = make_test_object(TV_SWORD, "Dagger");
+	objs[1] = make_test_object(TV_SWORD, "Long Sword");
+	objs[2] = make_test_object(TV_DIGGING, "Shovel");
+	objs[3] = make_test_object(TV_DIGGING, "Mattock");
+	objs[4] = NULL;
+	for (i = 0; i < 4; i++) {
+		require(objs[i]);
+	}
+	objs[1]->modifiers[OBJ_MOD_STR] = 2;
+	objs[1]->modifiers[OBJ_MOD_BLOWS] = 1;
+	objs[3]->modifiers[OBJ_MOD_TUNNEL] = 3;
+	eq(check_swaps(slot, objs, N_ELEMENTS(objs)), true);
+	for (i = 0; i < 4; i++) {
+		free_object(objs[i]);
+	}
+	ok;
+}
+
+/*
+ * Varying the stat offsets within a window, as obj-info.c does, matches
+ * doing the same with no window open.
+ */
+static int test_stat_offsets(void *state) {
+	int slot = slot_by_name(player, "weapon");
+	struct object *old = player->body.slots[slot].obj;
+	struct object *obj = make_test_object(TV_SWORD, "Long Sword");
+	struct player_state held, plain;
+	int str_plus, dex_plus;
+	bool match = true;
+
+	require(obj);
+	obj->modifiers[OBJ_MOD_DEX] = 3;
+	player->body.slots[slot].obj = obj;
+	calc_bonuses_hold();
+	for (dex_plus = 0; dex_plus < 5 && match; dex_plus++) {
+		for (str_plus = 0; str_plus < 5 && match; str_plus++) {
+			calc_state(true, str_plus, dex_plus, &held);
+			calc_bonuses_release();
+			calc_state(true, str_plus, dex_plus, &plain);
+			calc_bonuses_hold();
+			if (memcmp(&held, &plain, sizeof(plain))) {
+				match = false;
+			}
+		}
+	}
+	calc_bonuses_release();
+	player->body.slots[slot].obj = old;
+	free_object(obj);
+	eq(match, true);
+	ok;
+}
+
+/* Curses added or removed between windows are seen by the next window */
+static int test_curses(void *state) {
+	int slot = slot_by_name(player, "weapon");
+	struct object *old = player->body.slots[slot].obj;
+	struct object *obj = make_test_object(TV_SWORD, "Dagger");
+	int curse = lookup_curse("sickliness");
+	int old_rune = player->obj_k->modifiers[OBJ_MOD_STR];
+	struct player_state held, plain, before;
+
+	require(obj);
+	require(curse > 0);
+	player->body.slots[slot].obj = obj;
+	player->obj_k->modifiers[OBJ_MOD_STR] = 1;
+
+	calc_bonuses_hold();
+	calc_state(false, 0, 0, &before);
+	calc_bonuses_release();
+
+	/* The curse lowers strength from the weapon slot. */
+	require(append_object_curse(obj, curse, 10));
+	calc_bonuses_hold();
+	calc_state(false, 0, 0, &held);
+	calc_bonuses_release();
+	calc_state(false, 0, 0, &plain);
+	eq(memcmp(&held, &plain, sizeof(plain)), 0);
+	eq(held.stat_add[STAT_STR], before.stat_add[STAT_STR] - 5);
+
+	/* Lifting it puts things back. */
+	obj->curses[curse].power = 0;
+	calc_bonuses_hold();
+	calc_state(false, 0, 0, &held);
+	calc_bonuses_release();
+	calc_state(false, 0, 0, &plain);
+	eq(memcmp(&held, &plain, sizeof(plain)), 0);
+	eq(memcmp(&held, &before, sizeof(before)), 0);
+
+	player->obj_k->modifiers[OBJ_MOD_STR] = old_rune;
+	player->body.slots[slot].obj = old;
+	free_object(obj);
+	ok;
+}
+
+/*
+ * The known state only uses what is known; learning more between windows
+ * changes the known state but not the true one.
+ */
+static int test_known_only(void *state) {
+	int slot = slot_by_name(player, "body");
+	struct object *old = player->body.slots[slot].obj;
+	struct object *obj = make_test_object(TV_SOFT_ARMOR, "Soft Leather Armour");
+	struct player_state held[2], plain[2];
+	int k;
+
+	require(obj);
+	obj->to_a = 7;
+	obj->known->to_a = 0;
+	player->body.slots[slot].obj = obj;
+
+	calc_bonuses_hold();
+	for (k = 0; k < 2; k++) {
+		calc_state(k == 1, 0, 0, &held[k]);
+	}
+	calc_bonuses_release();
+	for (k = 0; k < 2; k++) {
+		calc_state(k == 1, 0, 0, &plain[k]);
+		eq(memcmp(&held[k], &plain[k], sizeof(plain[k])), 0);
+	}
+	eq(held[0].to_a, held[1].to_a + 7);
+
+	obj->known->to_a = 1;
+	calc_bonuses_hold();
+	for (k = 0; k < 2; k++) {
+		calc_state(k == 1, 0, 0, &held[k]);
+	}
+	calc_bonuses_release();
+	for (k = 0; k < 2; k++) {
+		calc_state(k == 1, 0, 0, &plain[k]);
+		eq(memcmp(&held[k], &plain[k], sizeof(plain[k])), 0);
+	}
+	eq(held[0].to_a, held[1].to_a);
+
+	player->body.slots[slot].obj = old;
+	free_object(obj);
+	ok;
+}
+
+const char *suite_name = "player/calc-hold";
+struct test tests[] = {
+	{ "weapon swaps", test_weapon_swaps },
+	{ "stat offsets", test_stat_offsets },
+	{ "curses", test_curses },
+	{ "known only", test_known_only },
+	{ NULL, NULL }
+};
@@ -1,7 +1,9 @@
 TESTPROGS += player/birth \
+             player/calc-hold \
              player/calc-inventory \
              player/history \
              player/inven-carry-num \
              player/inven-wield \
              player/pathfind \
-             player/playerstat
+             player/playerstat \
+             player/travel
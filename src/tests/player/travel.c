@@ -0,0 +1,240 @@
+/* player/travel */
+/* Exercise the region graph behind path_travel() and path_explore(). */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "cmd-core.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "player-path.h"
+#include "player-util.h"
+#include "trap.h"
+
+/* Further than this and travel has to go by the region graph */
+#define TRAVEL_FAR 60
+
+static struct loc target;
+
+/* Distance counting diagonal steps as one, as travel does */
+static int steps(struct loc grid1, struct loc grid2)
+{
+	return MAX(ABS(grid1.x - grid2.x), ABS(grid1.y - grid2.y));
+}
+
+/*
+ * Remove the level's monsters, which would interrupt travel
+ */
+static void clear_monsters(void)
+{
+	int i;
+
+	for (i = 1; i < cave_monster_max(cave); i++) {
+		if (cave_monster(cave, i)->race) delete_monster_idx(i);
+	}
+}
+
+/*
+ * Clear the level of monsters, objects and traps, so nothing interrupts
+ * travel, and let the player know the lot
+ */
+static void clear_level(void)
+{
+	struct loc grid;
+
+	clear_monsters();
+	for (grid.y = 0; grid.y < cave->height; grid.y++) {
+		for (grid.x = 0; grid.x < cave->width; grid.x++) {
+			while (square_object(cave, grid)) {
+				square_delete_object(cave, grid,
+					square_object(cave, grid), false, false);
+			}
+			square_remove_all_traps(cave, grid);
+			square_memorize(cave, grid);
+		}
+	}
+}
+
+/*
+ * Find the floor grid, reachable on foot from the player, furthest from them
+ */
+static struct loc furthest_grid(void)
+{
+	int n = cave->height * cave->width, head = 0, tail = 0;
+	struct loc *queue = mem_zalloc(n * sizeof(*queue));
+	bool *seen = mem_zalloc(n * sizeof(*seen));
+	struct loc best = player->grid;
+
+	queue[tail++] = player->grid;
+	seen[player->grid.y * cave->width + player->grid.x] = true;
+	while (head < tail) {
+		struct loc cur = queue[head++];
+		int k;
+
+		if (square_isfloor(cave, cur) &&
+			(steps(cur, player->grid) > steps(best, player->grid))) {
+			best = cur;
+		}
+		for (k = 0; k < 8; k++) {
+			struct loc next = loc_sum(cur, ddgrid_ddd[k]);
+			int i = next.y * cave->width + next.x;
+
+			if (!square_in_bounds(cave, next) || seen[i]) continue;
+			if (!square_ispassable(cave, next)) continue;
+			if (square_isdamaging(cave, next)) continue;
+			seen[i] = true;
+			queue[tail++] = next;
+		}
+	}
+	mem_free(seen);
+	mem_free(queue);
+	return best;
+}
+
+/*
+ * Find a dungeon level, where travel has to be planned in legs
+ */
+static int cave_place(void)
+{
+	int i;
+
+	for (i = 0; i < world->num_levels; i++) {
+		struct level *lev = &world->levels[i];
+
+		if ((lev->topography == TOP_CAVE) && (lev->depth >= 10)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+int setup_tests(void **state) {
+	int place, tries;
+
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	/* Get a level with somewhere far enough away to go */
+	place = cave_place();
+	for (tries = 0; (place >= 0) && (tries < 20); tries++) {
+		player_change_place(player, place);
+		prepare_next_level(player);
+		on_new_level();
+		player->upkeep->generate_level = false;
+		clear_level();
+		target = furthest_grid();
+		if (steps(target, player->grid) >= TRAVEL_FAR) break;
+	}
+	if ((place < 0) || (tries == 20)) {
+		cleanup_angband();
+		return 1;
+	}
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/* A known level is split into regions that link up across it */
+static int test_regions(void *state) {
+	eq(path_travel(target), true);
+
+	/* Everything reachable is known, so there is nothing to explore */
+	eq(path_explore(), false);
+	ok;
+}
+
+/* The graph follows what the player knows of the terrain */
+static int test_knowledge_change(void *state) {
+	int k;
+
+	/* Forgetting what surrounds the target cuts it off */
+	for (k = 0; k < 8; k++) {
+		struct loc next = loc_sum(target, ddgrid_ddd[k]);
+		if (square_ispassable(cave, next)) square_forget(cave, next);
+	}
+	eq(path_travel(target), false);
+
+	/* There is now something to explore */
+	eq(path_explore(), true);
+
+	/* Remembering it again joins it back up */
+	for (k = 0; k < 8; k++) {
+		square_memorize(cave, loc_sum(target, ddgrid_ddd[k]));
+	}
+	eq(path_travel(target), true);
+	ok;
+}
+
+/* The graph follows changes to the terrain itself */
+static int test_terrain_change(void *state) {
+	int feats[8];
+	int k;
+
+	/* Walling in the target cuts it off */
+	for (k = 0; k < 8; k++) {
+		struct loc next = loc_sum(target, ddgrid_ddd[k]);
+
+		feats[k] = square(cave, next)->feat;
+		if (square_ispassable(cave, next)) {
+			square_set_feat(cave, next, FEAT_GRANITE);
+			square_memorize(cave, next);
+		}
+	}
+	eq(path_travel(target), false);
+
+	/* Knocking the walls down again joins it back up */
+	for (k = 0; k < 8; k++) {
+		struct loc next = loc_sum(target, ddgrid_ddd[k]);
+
+		if (square(cave, next)->feat != feats[k]) {
+			square_set_feat(cave, next, feats[k]);
+			square_memorize(cave, next);
+		}
+	}
+	eq(path_travel(target), true);
+	ok;
+}
+
+/* Travelling gets the player all the way there */
+static int test_travel(void *state) {
+	int tries;
+
+	for (tries = 0; tries < 10; tries++) {
+		if (loc_eq(player->grid, target)) break;
+
+		/* Anything that has turned up since might stop us */
+		clear_monsters();
+		cmdq_push(CMD_TRAVEL);
+		cmd_set_arg_point(cmdq_peek(), "point", target);
+		run_game_loop();
+	}
+	eq(player->grid.x, target.x);
+	eq(player->grid.y, target.y);
+	ok;
+}
+
+const char *suite_name = "player/travel";
+struct test tests[] = {
+	{ "regions", test_regions },
+	{ "knowledge change", test_knowledge_change },
+	{ "terrain change", test_terrain_change },
+	{ "travel", test_travel },
+	{ NULL, NULL }
+};
@@ -0,0 +1,219 @@
+/* z-bitflag/bitflag */
+
+#include "unit-test.h"
+#include "monster.h"
+#include "obj-properties.h"
+#include "z-bitflag.h"
+
+NOSETUP
+NOTEARDOWN
+
+#define MAX_TEST_SIZE 24
+
+/* Simple generator so the sets are the same on every run */
+static u32b test_seed = 1;
+
+static bitflag test_byte(void)
+{
+	test_seed ^= test_seed << 13;
+	test_seed ^= test_seed >> 17;
+	test_seed ^= test_seed << 5;
+
+	/* Make sparse, empty and full bytes all common */
+	switch (test_seed % 4) {
+		case 0: return 0;
+		case 1: return (bitflag) -1;
+		case 2: return (bitflag) (test_seed >> 8) & (bitflag) (test_seed >> 16);
+		default: return (bitflag) (test_seed >> 8);
+	}
+}
+
+static void test_fill(bitflag *flags, size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		flags[i] = test_byte();
+}
+
+/* Byte at a time versions to check against */
+static int ref_next(const bitflag *flags, size_t size, int flag)
+{
+	int f;
+
+	for (f = MAX(flag, FLAG_START); f < FLAG_MAX(size); f++)
+		if (flags[FLAG_OFFSET(f)] & FLAG_BINARY(f)) return f;
+
+	return FLAG_END;
+}
+
+static int ref_count(const bitflag *flags, size_t size)
+{
+	int f, count = 0;
+
+	for (f = FLAG_START; f < FLAG_MAX(size); f++)
+		if (flags[FLAG_OFFSET(f)] & FLAG_BINARY(f)) count++;
+
+	return count;
+}
+
+static bool ref_union(bitflag *flags1, const bitflag *flags2, size_t size)
+{
+	size_t i;
+	bool delta = false;
+
+	for (i = 0; i < size; i++) {
+		if (~flags1[i] & flags2[i]) delta = true;
+		flags1[i] |= flags2[i];
+	}
+
+	return delta;
+}
+
+static bool ref_is_inter(const bitflag *flags1, const bitflag *flags2,
+		size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		if (flags1[i] & flags2[i]) return true;
+
+	return false;
+}
+
+static bool ref_is_subset(const bitflag *flags1, const bitflag *flags2,
+		size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; i++)
+		if (~flags1[i] & flags2[i]) return false;
+
+	return true;
+}
+
+static int test_query(void *state)
+{
+	bitflag f1[MAX_TEST_SIZE], f2[MAX_TEST_SIZE];
+	size_t size;
+	int n, f;
+
+	for (size = 1; size <= MAX_TEST_SIZE; size++) {
+		for (n = 0; n < 200; n++) {
+			test_fill(f1, size);
+			test_fill(f2, size);
+
+			eq(flag_count(f1, size), ref_count(f1, size));
+			eq(flag_is_empty(f1, size), ref_count(f1, size) == 0);
+			eq(flag_is_full(f1, size),
+				ref_count(f1, size) == (int) (size * FLAG_WIDTH));
+			eq(flag_is_inter(f1, f2, size), ref_is_inter(f1, f2, size));
+			eq(flag_is_subset(f1, f2, size), ref_is_subset(f1, f2, size));
+			for (f = FLAG_END; f <= FLAG_MAX(size); f++)
+				eq(flag_next(f1, size, f), ref_next(f1, size, f));
+		}
+	}
+	ok;
+}
+
+static int test_modify(void *state)
+{
+	bitflag f1[MAX_TEST_SIZE], f2[MAX_TEST_SIZE];
+	bitflag r1[MAX_TEST_SIZE], r2[MAX_TEST_SIZE];
+	size_t size, i;
+	int n;
+
+	for (size = 1; size <= MAX_TEST_SIZE; size++) {
+		for (n = 0; n < 200; n++) {
+			test_fill(f1, size);
+			test_fill(f2, size);
+
+			/* Union */
+			memcpy(r1, f1, size);
+			eq(flag_union(r1, f2, size), ref_union(f1, f2, size));
+			require(!memcmp(r1, f1, size));
+
+			/* Intersection, against the union with the complement */
+			memcpy(r1, f1, size);
+			memcpy(r2, f2, size);
+			flag_negate(r2, size);
+			for (i = 0; i < size; i++)
+				require(r2[i] == (bitflag) ~f2[i]);
+			eq(flag_inter(r1, f2, size), !flag_is_equal(f1, f2, size));
+			for (i = 0; i < size; i++)
+				require(r1[i] == (f1[i] & f2[i]));
+
+			/* Difference */
+			memcpy(r1, f1, size);
+			eq(flag_diff(r1, f2, size), ref_is_inter(f1, f2, size));
+			for (i = 0; i < size; i++)
+				require(r1[i] == (f1[i] & r2[i]));
+		}
+	}
+	ok;
+}
+
+/*
+ * Time the word-wide functions against the byte at a time versions on sets of
+ * the size used for object and monster race flags.  This only reports the
+ * times (when run verbosely); it doesn't fail on slow machines.
+ */
+static int bench_size(size_t size, const char *name)
+{
+	bitflag sets[64][MAX_TEST_SIZE];
+	clock_t start, ref, word;
+	int n, i, f;
+	long sink = 0;
+
+	assert(size <= MAX_TEST_SIZE);
+	for (i = 0; i < 64; i++) test_fill(sets[i], size);
+
+	start = clock();
+	for (n = 0; n < 2000; n++) {
+		for (i = 0; i < 63; i++) {
+			sink += ref_is_inter(sets[i], sets[i + 1], size);
+			sink += ref_is_subset(sets[i], sets[i + 1], size);
+			sink += ref_count(sets[i], size);
+			for (f = ref_next(sets[i], size, FLAG_START); f != FLAG_END;
+					f = ref_next(sets[i], size, f + 1))
+				sink += f;
+		}
+	}
+	ref = clock() - start;
+
+	start = clock();
+	for (n = 0; n < 2000; n++) {
+		for (i = 0; i < 63; i++) {
+			sink += flag_is_inter(sets[i], sets[i + 1], size);
+			sink += flag_is_subset(sets[i], sets[i + 1], size);
+			sink += flag_count(sets[i], size);
+			for (f = flag_next(sets[i], size, FLAG_START); f != FLAG_END;
+					f = flag_next(sets[i], size, f + 1))
+				sink += f;
+		}
+	}
+	word = clock() - start;
+
+	if (verbose) {
+		printf("\n    %s (%d bytes): bytes %ld ms, words %ld ms (%ld)  ",
+			name, (int) size, (long) (ref * 1000 / CLOCKS_PER_SEC),
+			(long) (word * 1000 / CLOCKS_PER_SEC), sink & 1);
+	}
+
+	return 0;
+}
+
+static int test_benchmark(void *state)
+{
+	require(!bench_size(OF_SIZE, "of_*"));
+	require(!bench_size(RF_SIZE, "rf_*"));
+	ok;
+}
+
+const char *suite_name = "z-bitflag/bitflag";
+struct test tests[] = {
+	{ "query", test_query },
+	{ "modify", test_modify },
+	{ "benchmark", test_benchmark },
+	{ NULL, NULL },
+};
@@ -475,6 +475,11 @@ void square_memorize_traps(struct chunk *c, struct loc grid)
 	struct trap *current = NULL;
 	if (c != cave) return;
 
+	/* Note any change */
+	if (trap || square(player->cave, grid)->trap) {
+		cave_journal_note(player->cave, grid, KNOWN_CHANGE_TRAP);
+	}
+
 	/* Clear current knowledge */
 	square_remove_all_traps(player->cave, grid);
 
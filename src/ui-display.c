@@ -2524,6 +2524,9 @@ static void new_level_display_update(game_event_type type,
 	/* Choose panel */
 	verify_panel();
 
+	/* The small-scale maps are of the old level */
+	display_map_forget();
+
 	/* Hack -- Invoke partial update mode */
 	player->upkeep->only_partial = true;
 
@@ -25,8 +25,11 @@
 #include "obj-gear.h"
 #include "obj-ignore.h"
 #include "obj-info.h"
+#include "obj-knowledge.h"
 #include "obj-tval.h"
 #include "player.h"
+#include "player-attack.h"
+#include "player-calcs.h"
 #include "store.h"
 #include "ui-entry.h"
 #include "ui-entry-renderers.h"
@@ -43,6 +46,14 @@
 #include "z-util.h"
 #include "z-virt.h"
 
+/*
+ * The average damage per round of weapons and ammunition, and the best of
+ * that against monsters affected by their brands and slays, are shown in
+ * columns of this width between the names and the properties.
+ */
+#define EQUIP_CMP_DAM_WIDTH 4
+#define EQUIP_CMP_DAM_COLS 2
+
 enum equippable_source {
 	EQUIP_SOURCE_WORN,
 	EQUIP_SOURCE_PACK,
@@ -61,12 +72,14 @@ enum equippable_quality {
 
 struct equippable {
 	char *short_name;
-	int *vals;
-	int *auxvals;
 	const struct object *obj;
+	/* Summarizes what the property values were computed from */
+	u32b sig;
 	enum equippable_source src;
 	enum equippable_quality qual;
 	int slot;
+	/* Average and best damage per round (x10), or -1 if not a weapon */
+	int dam[EQUIP_CMP_DAM_COLS];
 	int nmlen;
 	wchar_t ch;
 	byte at;
@@ -78,8 +91,13 @@ union equippable_selfunc_extra {
 	int slot;
 	int propind;
 };
-typedef bool (*equippable_selfunc)(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
+/*
+ * Selectors work on a whole column of the summary at once:  they set
+ * mask[i] to whether the ith item passes.
+ */
+struct equippable_summary;
+typedef void (*equippable_selfunc)(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
 struct equippable_selector {
 	equippable_selfunc func;
 	union equippable_selfunc_extra ex;
@@ -111,10 +129,14 @@ struct equippable_filter {
 	int nalloc;
 };
 
-typedef int (*equippable_cmpfunc)(const struct equippable *left,
-	const struct equippable *right, int propind);
+/*
+ * Sorting is done on integer keys:  an arranger fills keys[i] for each of
+ * the items so that comparing the keys gives the desired order.
+ */
+typedef void (*equippable_keyfunc)(const struct equippable_summary *s,
+	int propind, int *keys);
 struct equippable_arranger {
-	equippable_cmpfunc func;
+	equippable_keyfunc func;
 	int propind;
 };
 struct equippable_sorter {
@@ -141,6 +163,33 @@ struct prop_category {
 struct equippable_summary {
 	/* Has space for nalloc items; nitems are currently used */
 	struct equippable *items;
+	/*
+	 * Are the property values for the items, stored by column:  the
+	 * values for property j are vals[j * nalloc] to
+	 * vals[j * nalloc + nitems - 1].
+	 */
+	int *vals;
+	int *auxvals;
+	/*
+	 * Are the items, and their values, from the previous time the
+	 * summary was built.  Items whose signature has not changed since
+	 * then are copied from there rather than recomputed.  Has nprev
+	 * items; prev_known is a signature for the player's rune knowledge
+	 * at the time and prev_nshortnm the length used for the names.
+	 */
+	struct equippable *prev_items;
+	int *prev_vals;
+	int *prev_auxvals;
+	int nprev;
+	int prev_nshortnm;
+	u32b prev_known;
+	/*
+	 * Are the sort keys, by column, for the arrangers in sort_keys_for.
+	 * Is only valid if sort_keys_stale is false.
+	 */
+	int *sort_keys;
+	const struct equippable_arranger *sort_keys_for;
+	int nsort_keys;
 	/*
 	 * Has space for nalloc + 1 items; nfilt + 1 are currently used with
 	 * the last a sentinel (-1).
@@ -211,11 +260,13 @@ struct equippable_summary {
 	int term_ncol, term_nrow;
 	bool config_filt_is_on;
 	bool config_sort_is_on;
+	bool sort_keys_stale;
 };
 
 struct indirect_sort_data {
-	const struct equippable *items;
-	const struct equippable_arranger *arr;
+	const int *keys;
+	int nkeys;
+	int stride;
 };
 
 
@@ -263,35 +314,35 @@ static void filter_items(struct equippable_summary *s);
  * is implemented.
  */
 #if 0
-static bool sel_better_than(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
+static void sel_better_than(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
 #endif
-static bool sel_at_least_resists(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
-static bool sel_does_not_resist(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
-static bool sel_has_flag(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
-static bool sel_does_not_have_flag(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
-static bool sel_has_pos_mod(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
-static bool sel_has_nonpos_mod(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
+static void sel_at_least_resists(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
+static void sel_does_not_resist(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
+static void sel_has_flag(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
+static void sel_does_not_have_flag(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
+static void sel_has_pos_mod(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
+static void sel_has_nonpos_mod(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
 /*
  * Not used at the moment; left here in case more configurable filtering
  * is implemented.
  */
 #if 0
-static bool sel_exclude_slot(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
-static bool sel_only_slot(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
+static void sel_exclude_slot(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
+static void sel_only_slot(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
 #endif
-static bool sel_exclude_src(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
-static bool sel_only_src(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex);
+static void sel_exclude_src(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
+static void sel_only_src(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask);
 static void sort_items(struct equippable_summary *s);
 static wchar_t source_to_char(enum equippable_source src);
 
@@ -424,6 +475,10 @@ static void display_equip_cmp_help(void)
 	++irow;
 	prt("I, x        select one or two items for details", irow, 0);
 	++irow;
+	prt("Dam avg     damage per round (weapons and ammunition)", irow, 0);
+	++irow;
+	prt("Dam best    the same, at its best from a brand or slay", irow, 0);
+	++irow;
 	prt("Other ----------------------------------------------", irow, 0);
 	++irow;
 	prt("d           dump to file     R           reset display", irow, 0);
@@ -1618,134 +1673,197 @@ static char *set_short_name(const struct object *obj, size_t length,
 }
 
 
+/**
+ * Return the column of values for a property in the summary.
+ */
+static const int *summary_column(const struct equippable_summary *s,
+	int propind)
+{
+	return s->vals + propind * s->nalloc;
+}
+
+
 #if 0
-static bool sel_better_than(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_better_than(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->qual < ex->qual;
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = s->items[i].qual < ex->qual;
+	}
 }
 #endif
 
 
-static bool sel_at_least_resists(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_at_least_resists(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->vals[ex->propind] < RES_LEVEL_BASE;
+	const int *col = summary_column(s, ex->propind);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = col[i] < RES_LEVEL_BASE;
+	}
 }
 
 
-static bool sel_does_not_resist(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_does_not_resist(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->vals[ex->propind] >= RES_LEVEL_BASE;
+	const int *col = summary_column(s, ex->propind);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = col[i] >= RES_LEVEL_BASE;
+	}
 }
 
 
-static bool sel_has_flag(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_has_flag(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->vals[ex->propind] != 0;
+	const int *col = summary_column(s, ex->propind);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = col[i] != 0;
+	}
 }
 
 
-static bool sel_does_not_have_flag(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_does_not_have_flag(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->vals[ex->propind] == 0;
+	const int *col = summary_column(s, ex->propind);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = col[i] == 0;
+	}
 }
 
 
-static bool sel_has_pos_mod(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_has_pos_mod(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->vals[ex->propind] > 0;
+	const int *col = summary_column(s, ex->propind);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = col[i] > 0;
+	}
 }
 
 
-static bool sel_has_nonpos_mod(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_has_nonpos_mod(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->vals[ex->propind] <= 0;
+	const int *col = summary_column(s, ex->propind);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = col[i] <= 0;
+	}
 }
 
 
 #if 0
-static bool sel_exclude_slot(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_exclude_slot(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->slot != ex->slot;
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = s->items[i].slot != ex->slot;
+	}
 }
 
 
-static bool sel_only_slot(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_only_slot(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->slot == ex->slot;
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = s->items[i].slot == ex->slot;
+	}
 }
 #endif
 
 
-static bool sel_exclude_src(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_exclude_src(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->src != ex->src;
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = s->items[i].src != ex->src;
+	}
 }
 
 
-static bool sel_only_src(const struct equippable *eq,
-	const union equippable_selfunc_extra *ex)
+static void sel_only_src(const struct equippable_summary *s,
+	const union equippable_selfunc_extra *ex, bool *mask)
 {
-	return eq->src == ex->src;
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		mask[i] = s->items[i].src == ex->src;
+	}
 }
 
 
-static void apply_simple_filter(const struct equippable_filter *f,
-	struct equippable_summary *s)
+/**
+ * Set the sorted indices to the items which pass the filter in mask.
+ */
+static void select_from_mask(const bool *mask, struct equippable_summary *s)
 {
 	int i;
 
 	s->nfilt = 0;
+	for (i = 0; i < s->nitems; ++i) {
+		if (mask[i]) {
+			assert(s->nfilt < s->nalloc);
+			s->sorted_indices[s->nfilt] = i;
+			++s->nfilt;
+		}
+	}
+	s->sorted_indices[s->nfilt] = -1;
+}
+
+
+static void apply_simple_filter(const struct equippable_filter *f,
+	struct equippable_summary *s)
+{
+	bool *result, *term;
+	int i, j;
+
+	result = mem_alloc(2 * MAX(s->nitems, 1) * sizeof(*result));
+	term = result + MAX(s->nitems, 1);
 	switch (f->simple) {
 	case EQUIP_EXPR_AND:
 		for (i = 0; i < s->nitems; ++i) {
-			int j = 0;
-
-			while (1) {
-				if (j >= f->nv) {
-					assert(s->nfilt < s->nitems &&
-						s->nfilt < s->nalloc);
-					s->sorted_indices[s->nfilt] = i;
-					++s->nfilt;
-					break;
-				}
-				assert(f->v[j].c == EQUIP_EXPR_SELECTOR);
-				if (! (*f->v[j].s.func)(s->items + i,
-					&f->v[j].s.ex)) {
-					break;
-				}
-				++j;
+			result[i] = true;
+		}
+		for (j = 0; j < f->nv; ++j) {
+			assert(f->v[j].c == EQUIP_EXPR_SELECTOR);
+			(*f->v[j].s.func)(s, &f->v[j].s.ex, term);
+			for (i = 0; i < s->nitems; ++i) {
+				result[i] = result[i] && term[i];
 			}
 		}
 		break;
 
 	case EQUIP_EXPR_OR:
 		for (i = 0; i < s->nitems; ++i) {
-			int j = 0;
-
-			while (1) {
-				if (j >= f->nv) {
-					break;
-				}
-				assert(f->v[j].c == EQUIP_EXPR_SELECTOR);
-				if ((*f->v[j].s.func)(s->items + i, 
-					&f->v[j].s.ex)) {
-					assert(s->nfilt < s->nitems &&
-						s->nfilt < s->nalloc);
-					s->sorted_indices[s->nfilt] = i;
-					++s->nfilt;
-					break;
-				}
-				++j;
+			result[i] = false;
+		}
+		for (j = 0; j < f->nv; ++j) {
+			assert(f->v[j].c == EQUIP_EXPR_SELECTOR);
+			(*f->v[j].s.func)(s, &f->v[j].s.ex, term);
+			for (i = 0; i < s->nitems; ++i) {
+				result[i] = result[i] || term[i];
 			}
 		}
 		break;
@@ -1754,68 +1872,61 @@ static void apply_simple_filter(const struct equippable_filter *f,
 		assert(0);
 	}
 
-	s->sorted_indices[s->nfilt] = -1;
+	select_from_mask(result, s);
+	mem_free(result);
 }
 
 
 static void apply_complex_filter(const struct equippable_filter *f,
 	struct equippable_summary *s)
 {
+	/* Is a stack of masks, each with stride elements. */
 	bool *stack;
-	int nst, i;
+	int stride = MAX(s->nitems, 1);
+	int nst, i, j;
 
 	assert(f->nv > 0);
-	stack = mem_alloc(f->nv * sizeof(*stack));
+	stack = mem_alloc(f->nv * stride * sizeof(*stack));
 	nst = 0;
-	s->nfilt = 0;
-	for (i = 0; i < s->nitems; ++i) {
-		int j = 0;
+	for (j = 0; f->v[j].c != EQUIP_EXPR_TERMINATOR; ++j) {
+		bool *top, *next;
+
+		assert(j < f->nv);
+		switch (f->v[j].c) {
+		case EQUIP_EXPR_SELECTOR:
+			assert(nst < f->nv);
+			(*f->v[j].s.func)(s, &f->v[j].s.ex,
+				stack + nst * stride);
+			++nst;
+			break;
 
-		while (1) {
-			assert(j <= f->nv);
-
-			if (f->v[j].c == EQUIP_EXPR_TERMINATOR) {
-				assert(nst == 1);
-				if (stack[0]) {
-					assert(s->nfilt < s->nitems &&
-						s->nfilt < s->nalloc);
-					s->sorted_indices[s->nfilt] = i;
-					++s->nfilt;
-				}
-				break;
+		case EQUIP_EXPR_AND:
+			assert(nst >= 2);
+			top = stack + (nst - 1) * stride;
+			next = stack + (nst - 2) * stride;
+			for (i = 0; i < s->nitems; ++i) {
+				next[i] = top[i] && next[i];
 			}
+			--nst;
+			break;
 
-			switch (f->v[j].c) {
-			case EQUIP_EXPR_SELECTOR:
-				assert(nst < f->nv);
-				stack[nst] = (*f->v[j].s.func)(s->items + i,
-					&f->v[j].s.ex);
-				++nst;
-				break;
-
-			case EQUIP_EXPR_AND:
-				assert(nst >= 2);
-				stack[nst - 2] =
-					(stack[nst - 1] && stack[nst - 2]);
-				--nst;
-				break;
-
-			case EQUIP_EXPR_OR:
-				assert(nst >= 2);
-				stack[nst - 2] =
-					(stack[nst - 1] || stack[nst - 2]);
-				--nst;
-				break;
-
-			case EQUIP_EXPR_TERMINATOR:
-				assert(0);
+		case EQUIP_EXPR_OR:
+			assert(nst >= 2);
+			top = stack + (nst - 1) * stride;
+			next = stack + (nst - 2) * stride;
+			for (i = 0; i < s->nitems; ++i) {
+				next[i] = top[i] || next[i];
 			}
-			++j;
+			--nst;
+			break;
+
+		case EQUIP_EXPR_TERMINATOR:
+			assert(0);
 		}
 	}
+	assert(nst == 1);
 
-	s->sorted_indices[s->nfilt] = -1;
-
+	select_from_mask(stack, s);
 	mem_free(stack);
 }
 
@@ -1852,35 +1963,75 @@ static void filter_items(struct equippable_summary *s)
 }
 
 
-static int cmp_by_location(const struct equippable *left,
-	const struct equippable *right, int propind)
+static void key_by_location(const struct equippable_summary *s,
+	int propind, int *keys)
 {
-	return (left->src < right->src) ?
-		-1 : ((left->src > right->src) ? 1 : 0);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		keys[i] = (int)s->items[i].src;
+	}
 }
 
 
-static int cmp_by_quality(const struct equippable *left,
-	const struct equippable *right, int propind)
+static void key_by_quality(const struct equippable_summary *s,
+	int propind, int *keys)
 {
-	return (left->qual < right->qual) ?
-		-1 : ((left->qual > right->qual) ? 1 : 0);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		keys[i] = (int)s->items[i].qual;
+	}
 }
 
 
-static int cmp_by_short_name(const struct equippable *left,
-	const struct equippable *right, int propind)
+/* Used by cmp_short_names() */
+static const struct equippable *name_sort_items = NULL;
+
+
+static int cmp_short_names(const void *left, const void *right)
 {
+	return strcmp(name_sort_items[*((const int*) left)].short_name,
+		name_sort_items[*((const int*) right)].short_name);
+}
 
-	return strcmp(left->short_name, right->short_name);
+
+/**
+ * Use the alphabetical rank of the short name as the key; items with the
+ * same name get the same rank.
+ */
+static void key_by_short_name(const struct equippable_summary *s,
+	int propind, int *keys)
+{
+	int *order = mem_alloc(MAX(s->nitems, 1) * sizeof(*order));
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		order[i] = i;
+	}
+	name_sort_items = s->items;
+	sort(order, s->nitems, sizeof(*order), cmp_short_names);
+	name_sort_items = NULL;
+	for (i = 0; i < s->nitems; ++i) {
+		if (i > 0 && streq(s->items[order[i]].short_name,
+				s->items[order[i - 1]].short_name)) {
+			keys[order[i]] = keys[order[i - 1]];
+		} else {
+			keys[order[i]] = i;
+		}
+	}
+	mem_free(order);
 }
 
 
-static int cmp_by_slot(const struct equippable *left,
-	const struct equippable *right, int propind)
+static void key_by_slot(const struct equippable_summary *s,
+	int propind, int *keys)
 {
-	return (left->slot < right->slot) ?
-		-1 : ((left->slot > right->slot) ? 1 : 0);
+	int i;
+
+	for (i = 0; i < s->nitems; ++i) {
+		keys[i] = s->items[i].slot;
+	}
 }
 
 
@@ -1888,29 +2039,53 @@ static int cmp_for_sort_items(const void *left, const void *right)
 {
 	int ileft = *((int*) left);
 	int iright = *((int*) right);
-	int i = 0;
-
-	while (1) {
-		int cres;
+	const int *keys = sort_dat.keys;
+	int i;
 
-		if (sort_dat.arr[i].func == 0) {
-			return 0;
+	for (i = 0; i < sort_dat.nkeys; ++i) {
+		if (keys[ileft] != keys[iright]) {
+			return (keys[ileft] < keys[iright]) ? -1 : 1;
 		}
-		cres = (*sort_dat.arr[i].func)(sort_dat.items + ileft,
-			sort_dat.items + iright, sort_dat.arr[i].propind);
-		if (cres != 0) {
-			return cres;
-		}
-		++i;
+		keys += sort_dat.stride;
 	}
+	return 0;
 }
 
 
+/**
+ * Sort the filtered items.  The keys for the sort are only recomputed when
+ * the items or the sort have changed; anything which changes the items'
+ * names, sources, or qualities has to set sort_keys_stale.
+ */
 static void sort_items(struct equippable_summary *s)
 {
-	sort_dat.items = s->items;
-	sort_dat.arr = (s->config_sort_is_on) ?
+	const struct equippable_arranger *arr = (s->config_sort_is_on) ?
 		s->config_sort.v : s->default_sort.v;
+	int narr = 0;
+
+	while (arr[narr].func) {
+		++narr;
+	}
+	if (s->sort_keys_stale || s->sort_keys_for != arr) {
+		int i;
+
+		if (narr > s->nsort_keys) {
+			mem_free(s->sort_keys);
+			s->sort_keys = mem_alloc(narr * MAX(s->nalloc, 1) *
+				sizeof(*s->sort_keys));
+			s->nsort_keys = narr;
+		}
+		for (i = 0; i < narr; ++i) {
+			(*arr[i].func)(s, arr[i].propind,
+				s->sort_keys + i * s->nalloc);
+		}
+		s->sort_keys_for = arr;
+		s->sort_keys_stale = false;
+	}
+
+	sort_dat.keys = s->sort_keys;
+	sort_dat.nkeys = narr;
+	sort_dat.stride = s->nalloc;
 	sort(s->sorted_indices, s->nfilt, sizeof(*s->sorted_indices),
 		cmp_for_sort_items);
 }
@@ -1982,55 +2157,195 @@ static void count_objects(const struct object *obj, void *closure)
 }
 
 
+/**
+ * Mix the given bytes into a running signature (FNV-1a).
+ */
+static u32b sig_bytes(u32b sig, const void *data, size_t n)
+{
+	const byte *b = data;
+	size_t i;
+
+	for (i = 0; i < n; ++i) {
+		sig = (sig ^ b[i]) * 16777619u;
+	}
+	return sig;
+}
+
+
+/**
+ * Mix the parts of an object that the summary depends on into a signature.
+ */
+static u32b sig_object(u32b sig, const struct object *obj)
+{
+	sig = sig_bytes(sig, &obj->kind, sizeof(obj->kind));
+	sig = sig_bytes(sig, &obj->ego, sizeof(obj->ego));
+	sig = sig_bytes(sig, &obj->artifact, sizeof(obj->artifact));
+	sig = sig_bytes(sig, &obj->pval, sizeof(obj->pval));
+	sig = sig_bytes(sig, &obj->dd, sizeof(obj->dd));
+	sig = sig_bytes(sig, &obj->ds, sizeof(obj->ds));
+	sig = sig_bytes(sig, &obj->ac, sizeof(obj->ac));
+	sig = sig_bytes(sig, &obj->to_a, sizeof(obj->to_a));
+	sig = sig_bytes(sig, &obj->to_h, sizeof(obj->to_h));
+	sig = sig_bytes(sig, &obj->to_d, sizeof(obj->to_d));
+	sig = sig_bytes(sig, obj->flags, sizeof(obj->flags));
+	sig = sig_bytes(sig, obj->modifiers, sizeof(obj->modifiers));
+	sig = sig_bytes(sig, obj->el_info, sizeof(obj->el_info));
+	sig = sig_bytes(sig, &obj->notice, sizeof(obj->notice));
+	sig = sig_bytes(sig, &obj->note, sizeof(obj->note));
+	if (obj->curses) {
+		sig = sig_bytes(sig, obj->curses,
+			z_info->curse_max * sizeof(*obj->curses));
+	}
+	if (obj->brands) {
+		sig = sig_bytes(sig, obj->brands,
+			z_info->brand_max * sizeof(*obj->brands));
+	}
+	if (obj->slays) {
+		sig = sig_bytes(sig, obj->slays,
+			z_info->slay_max * sizeof(*obj->slays));
+	}
+	return sig;
+}
+
+
+/**
+ * Compute the signature for an item in the summary:  if it is the same as
+ * when the item was last added, the item's property values and name are
+ * unchanged.
+ */
+static u32b equippable_signature(const struct object *obj)
+{
+	u32b sig = sig_object(2166136261u, obj);
+	bool aware = object_flavor_is_aware(obj);
+
+	if (obj->known) {
+		sig = sig_object(sig, obj->known);
+	}
+	return sig_bytes(sig, &aware, sizeof(aware));
+}
+
+
+/**
+ * Fill in the damage columns for an item.  These depend on the player as well
+ * as the item, so they are always worked out again; the summary is built in
+ * one calc_bonuses_hold() window, which keeps that cheap.
+ */
+static void set_expected_damage(struct equippable *e, struct player *p)
+{
+	int *brand_dam, *slay_dam;
+	bool nonweap_slay;
+	int i;
+
+	e->dam[0] = -1;
+	e->dam[1] = -1;
+	if (!e->obj->known || (!tval_is_melee_weapon(e->obj) &&
+			(!tval_is_ammo(e->obj) || e->obj->tval != p->state.ammo_tval)))
+		return;
+
+	brand_dam = mem_zalloc(z_info->brand_max * sizeof(*brand_dam));
+	slay_dam = mem_zalloc(z_info->slay_max * sizeof(*slay_dam));
+	(void) attack_expected_damage(p, e->obj, false,
+		&e->dam[0], brand_dam, slay_dam, &nonweap_slay);
+	e->dam[1] = e->dam[0];
+	for (i = 1; i < z_info->brand_max; ++i) {
+		e->dam[1] = MAX(e->dam[1], brand_dam[i]);
+	}
+	for (i = 1; i < z_info->slay_max; ++i) {
+		e->dam[1] = MAX(e->dam[1], slay_dam[i]);
+	}
+	mem_free(slay_dam);
+	mem_free(brand_dam);
+}
+
+
 /**
  * Add an object to the summary of equippable items; intended for use with
  * apply_visitor_to_pile() or apply_visitor_to_equipped().
  */
 struct add_obj_to_summary_closure {
-	const struct player *p;
+	struct player *p;
 	struct equippable_summary *summary;
 	enum equippable_source src;
+	/* Is where to start looking for the object in the previous summary */
+	int iprev;
 };
 static void add_obj_to_summary(const struct object *obj, void *closure)
 {
 	struct add_obj_to_summary_closure *c = closure;
+	struct equippable_summary *s = c->summary;
 	struct equippable *e;
-	struct cached_object_data *cache;
-	int i;
+	u32b sig = equippable_signature(obj);
+	int row, iold, i;
+
+	assert(s->nitems < s->nalloc);
+	row = s->nitems;
+	e = s->items + row;
+	++s->nitems;
+
+	/* Look for the same, unchanged, object in the previous summary. */
+	iold = -1;
+	for (i = 0; i < s->nprev; ++i) {
+		int j = (c->iprev + i) % s->nprev;
+
+		if (s->prev_items[j].obj == obj &&
+				s->prev_items[j].sig == sig) {
+			iold = j;
+			break;
+		}
+	}
 
-	assert(c->summary->nitems < c->summary->nalloc);
-	e = c->summary->items + c->summary->nitems;
-	++c->summary->nitems;
+	if (iold >= 0) {
+		struct equippable *old = s->prev_items + iold;
 
-	if (!e->vals) {
-		e->vals = mem_alloc(c->summary->nprop * sizeof(*e->vals));
-	}
-	if (!e->auxvals) {
-		e->auxvals = mem_alloc(c->summary->nprop *
-			sizeof(*e->auxvals));
-	}
-	cache = NULL;
-	for (i = 0; i < (int)N_ELEMENTS(c->summary->propcats); ++i) {
-		int j;
+		for (i = 0; i < s->nprop; ++i) {
+			s->vals[i * s->nalloc + row] =
+				s->prev_vals[i * s->nalloc + iold];
+			s->auxvals[i * s->nalloc + row] =
+				s->prev_auxvals[i * s->nalloc + iold];
+		}
+		if (s->nshortnm > 0) {
+			string_free(e->short_name);
+			if (old->short_name &&
+					s->prev_nshortnm == s->nshortnm) {
+				e->short_name = old->short_name;
+				old->short_name = NULL;
+			} else {
+				e->short_name = set_short_name(obj,
+					s->nshortnm, c->p);
+			}
+			e->nmlen = (int)strlen(e->short_name);
+		}
+
+		/* Don't match it again. */
+		old->obj = NULL;
+		c->iprev = iold + 1;
+	} else {
+		struct cached_object_data *cache = NULL;
+
+		for (i = 0; i < (int)N_ELEMENTS(s->propcats); ++i) {
+			int j;
 
-		for (j = 0; j < c->summary->propcats[i].n; ++j) {
-			compute_ui_entry_values_for_object(
-				c->summary->propcats[i].entries[j], obj,
-				c->p, &cache,
-				e->vals + j + c->summary->propcats[i].off,
-				e->auxvals + j + c->summary->propcats[i].off);
+			for (j = 0; j < s->propcats[i].n; ++j) {
+				int col = (j + s->propcats[i].off) * s->nalloc;
+
+				compute_ui_entry_values_for_object(
+					s->propcats[i].entries[j], obj,
+					c->p, &cache, s->vals + col + row,
+					s->auxvals + col + row);
+			}
 		}
-	}
-	release_cached_object_data(cache);
+		release_cached_object_data(cache);
 
-	if (c->summary->nshortnm > 0) {
-		string_free(e->short_name);
-		e->short_name = set_short_name(obj, c->summary->nshortnm,
-			c->p);
-		e->nmlen = (int)strlen(e->short_name);
+		if (s->nshortnm > 0) {
+			string_free(e->short_name);
+			e->short_name = set_short_name(obj, s->nshortnm,
+				c->p);
+			e->nmlen = (int)strlen(e->short_name);
+		}
 	}
 
 	e->obj = obj;
+	e->sig = sig;
 	e->src = c->src;
 
 	switch (ignore_level_of(obj)) {
@@ -2062,6 +2377,7 @@ static void add_obj_to_summary(const struct object *obj, void *closure)
 	e->slot = wield_slot(obj);
 	e->ch = object_char(obj);
 	e->at = object_attr(obj);
+	set_expected_damage(e, c->p);
 }
 
 
@@ -2130,11 +2446,13 @@ static int reconfigure_for_term_if_necessary(bool update_names,
 	}
 
 	/*
-	 * Leave a space between the name and the properties.  Don't include
-	 * the core stat modifiers in the first view.
+	 * Leave a space between the name and the damage columns, and after
+	 * each of those.  Don't include the core stat modifiers in the first
+	 * view.
 	 */
 	length = ncol - s->nprop + s->propcats[N_ELEMENTS(s->propcats) - 1].n -
-		1 - s->icol_name;
+		1 - EQUIP_CMP_DAM_COLS * (EQUIP_CMP_DAM_WIDTH + 1) -
+		s->icol_name;
 	if (length < min_length) {
 		/* Try shifting the other modifiers to the second view. */
 		length += s->propcats[N_ELEMENTS(s->propcats) - 2].n;
@@ -2222,6 +2540,7 @@ static int reconfigure_for_term_if_necessary(bool update_names,
 			s->items[i].nmlen =
 				(int)strlen(s->items[i].short_name);
 		}
+		s->sort_keys_stale = true;
 	}
 	s->nshortnm = length;
 
@@ -2344,7 +2663,8 @@ static int initialize_summary(struct player *p,
 {
 	struct obj_visitor_data visitor;
 	struct add_obj_to_summary_closure add_obj_data;
-	int count, i;
+	int count, nshortnm, i;
+	u32b known;
 
 	if (*s == NULL) {
 		const char *categories[] = {
@@ -2358,6 +2678,18 @@ static int initialize_summary(struct player *p,
 
 		*s = mem_alloc(sizeof(**s));
 		(*s)->items = NULL;
+		(*s)->vals = NULL;
+		(*s)->auxvals = NULL;
+		(*s)->prev_items = NULL;
+		(*s)->prev_vals = NULL;
+		(*s)->prev_auxvals = NULL;
+		(*s)->nprev = 0;
+		(*s)->prev_nshortnm = 0;
+		(*s)->prev_known = 0;
+		(*s)->sort_keys = NULL;
+		(*s)->sort_keys_for = NULL;
+		(*s)->nsort_keys = 0;
+		(*s)->sort_keys_stale = true;
 		(*s)->sorted_indices = NULL;
 		(*s)->p_and_eq_vals = NULL;
 		(*s)->p_and_eq_auxvals = NULL;
@@ -2493,13 +2825,13 @@ static int initialize_summary(struct player *p,
 		(*s)->default_sort.nalloc = 5;
 		(*s)->default_sort.v = mem_alloc((*s)->default_sort.nalloc *
 			sizeof(*(*s)->default_sort.v));
-		(*s)->default_sort.v[0].func = cmp_by_slot;
+		(*s)->default_sort.v[0].func = key_by_slot;
 		(*s)->default_sort.v[0].propind = 0;
-		(*s)->default_sort.v[1].func = cmp_by_location;
+		(*s)->default_sort.v[1].func = key_by_location;
 		(*s)->default_sort.v[1].propind = 0;
-		(*s)->default_sort.v[2].func = cmp_by_quality;
+		(*s)->default_sort.v[2].func = key_by_quality;
 		(*s)->default_sort.v[2].propind = 0;
-		(*s)->default_sort.v[3].func = cmp_by_short_name;
+		(*s)->default_sort.v[3].func = key_by_short_name;
 		(*s)->default_sort.v[3].propind = 0;
 		(*s)->default_sort.v[4].func = 0;
 		(*s)->default_sort.v[4].propind = 0;
@@ -2512,7 +2844,11 @@ static int initialize_summary(struct player *p,
 		(*s)->config_sort_is_on = false;
 	}
 
-	/* These need to be redone on a change to the terminal size. */
+	/*
+	 * These need to be redone on a change to the terminal size.  Remember
+	 * the name length for the items from the last time.
+	 */
+	nshortnm = (*s)->nshortnm;
 	if (reconfigure_for_term_if_necessary(false, p, *s)) {
 		return 1;
 	}
@@ -2541,21 +2877,65 @@ static int initialize_summary(struct player *p,
 	visitor.selfunc_closure = NULL;
 	apply_visitor_to_pile(store_home(p)->stock, &visitor);
 
-	/* Allocate storage and add the available items. */
+	/*
+	 * Allocate storage and add the available items.  If the storage is
+	 * large enough, keep what was there from the last time so values for
+	 * unchanged items can be reused.  Leave some room when allocating so
+	 * picking up an item or two doesn't discard everything.
+	 */
 	if (count > (*s)->nalloc) {
+		count += count / 4 + 4;
 		mem_free((*s)->sorted_indices);
 		cleanup_summary_items(*s);
+		mem_free((*s)->prev_items);
 		mem_free((*s)->items);
+		mem_free((*s)->sort_keys);
 		(*s)->items = mem_zalloc(count * sizeof(*(*s)->items));
+		(*s)->prev_items = mem_zalloc(count * sizeof(*(*s)->items));
+		(*s)->vals = mem_alloc(count * (*s)->nprop *
+			sizeof(*(*s)->vals));
+		(*s)->auxvals = mem_alloc(count * (*s)->nprop *
+			sizeof(*(*s)->auxvals));
+		(*s)->prev_vals = mem_alloc(count * (*s)->nprop *
+			sizeof(*(*s)->prev_vals));
+		(*s)->prev_auxvals = mem_alloc(count * (*s)->nprop *
+			sizeof(*(*s)->prev_auxvals));
 		(*s)->sorted_indices =
 			mem_alloc((count + 1) * sizeof(*(*s)->sorted_indices));
+		(*s)->sort_keys = NULL;
+		(*s)->nsort_keys = 0;
+		(*s)->nprev = 0;
 		(*s)->nalloc = count;
+	} else {
+		struct equippable *items = (*s)->prev_items;
+		int *vals = (*s)->prev_vals;
+		int *auxvals = (*s)->prev_auxvals;
+
+		(*s)->prev_items = (*s)->items;
+		(*s)->prev_vals = (*s)->vals;
+		(*s)->prev_auxvals = (*s)->auxvals;
+		(*s)->items = items;
+		(*s)->vals = vals;
+		(*s)->auxvals = auxvals;
+		(*s)->nprev = (*s)->nitems;
+		(*s)->prev_nshortnm = nshortnm;
+	}
+
+	/* A change to the runes known can change any item's values. */
+	known = sig_object(2166136261u, p->obj_k);
+	if (known != (*s)->prev_known) {
+		(*s)->nprev = 0;
+		(*s)->prev_known = known;
 	}
+
 	(*s)->nitems = 0;
+	(*s)->sort_keys_stale = true;
+	calc_bonuses_hold();
 	visitor.usefunc = add_obj_to_summary;
 	visitor.usefunc_closure = &add_obj_data;
 	add_obj_data.p = p;
 	add_obj_data.summary = *s;
+	add_obj_data.iprev = 0;
 	add_obj_data.src = EQUIP_SOURCE_WORN;
 	visitor.selfunc = select_any;
 	visitor.selfunc_closure = NULL;
@@ -2574,6 +2954,7 @@ static int initialize_summary(struct player *p,
 	visitor.selfunc = select_wearable;
 	visitor.selfunc_closure = NULL;
 	apply_visitor_to_pile(store_home(p)->stock, &visitor);
+	calc_bonuses_release();
 
 	compute_player_and_equipment_values(p, *s);
 
@@ -2604,6 +2985,8 @@ static void cleanup_summary(struct equippable_summary *s)
 	mem_free(s->p_and_eq_auxvals);
 	mem_free(s->p_and_eq_vals);
 	mem_free(s->sorted_indices);
+	mem_free(s->sort_keys);
+	mem_free(s->prev_items);
 	mem_free(s->items);
 	mem_free(s->config_sort.v);
 	mem_free(s->default_sort.v);
@@ -2625,9 +3008,16 @@ static void cleanup_summary_items(struct equippable_summary *s)
 
 	for (i = 0; i < s->nalloc; ++i) {
 		string_free(s->items[i].short_name);
-		mem_free(s->items[i].auxvals);
-		mem_free(s->items[i].vals);
+		string_free(s->prev_items[i].short_name);
 	}
+	mem_free(s->prev_auxvals);
+	mem_free(s->prev_vals);
+	mem_free(s->auxvals);
+	mem_free(s->vals);
+	s->prev_auxvals = NULL;
+	s->prev_vals = NULL;
+	s->auxvals = NULL;
+	s->vals = NULL;
 }
 
 
@@ -2694,7 +3084,18 @@ static int display_page(struct equippable_summary *s, const struct player *p,
 	 * done by ui_entry_renderer_apply() so the color of the label can
 	 * alternate between columns.
 	 */
-	rdetails.label_position.x = s->icol_name + s->nshortnm + 1;
+	for (i = 0; i < EQUIP_CMP_DAM_COLS; ++i) {
+		int x = s->icol_name + s->nshortnm + 1 +
+			i * (EQUIP_CMP_DAM_WIDTH + 1);
+		int label_color = (i % 2 == 0) ? COLOUR_WHITE : COLOUR_L_WHITE;
+
+		Term_putstr(x, s->irow_combined_equip - s->nproplab,
+			EQUIP_CMP_DAM_WIDTH, label_color, " Dam");
+		Term_putstr(x, s->irow_combined_equip - s->nproplab + 1,
+			EQUIP_CMP_DAM_WIDTH, label_color, (i == 0) ? " avg" : "best");
+	}
+	rdetails.label_position.x = s->icol_name + s->nshortnm + 1 +
+		EQUIP_CMP_DAM_COLS * (EQUIP_CMP_DAM_WIDTH + 1);
 	rdetails.label_position.y = s->irow_combined_equip - s->nproplab;
 	rdetails.value_position.x = rdetails.label_position.x;
 	rdetails.value_position.y = s->irow_combined_equip;
@@ -2765,7 +3166,21 @@ static int display_page(struct equippable_summary *s, const struct player *p,
 		}
 		Term_putstr(s->icol_name, rdetails.value_position.y,
 			e->nmlen, nmcolor, e->short_name);
-		rdetails.value_position.x = s->icol_name + s->nshortnm + 1;
+		for (j = 0; j < EQUIP_CMP_DAM_COLS; ++j) {
+			char dbuf[EQUIP_CMP_DAM_WIDTH + 1];
+
+			if (e->dam[j] < 0) {
+				continue;
+			}
+			strnfmt(dbuf, sizeof(dbuf), "%*d", EQUIP_CMP_DAM_WIDTH,
+				MIN(e->dam[j] / 10, 9999));
+			Term_putstr(s->icol_name + s->nshortnm + 1 +
+				j * (EQUIP_CMP_DAM_WIDTH + 1),
+				rdetails.value_position.y, EQUIP_CMP_DAM_WIDTH,
+				color, dbuf);
+		}
+		rdetails.value_position.x = s->icol_name + s->nshortnm + 1 +
+			EQUIP_CMP_DAM_COLS * (EQUIP_CMP_DAM_WIDTH + 1);
 		rdetails.alternate_color_first = false;
 		for (j = 0; j < (int)N_ELEMENTS(s->propcats); ++j) {
 			int k;
@@ -2775,12 +3190,13 @@ static int display_page(struct equippable_summary *s, const struct player *p,
 			}
 			for (k = 0; k < s->propcats[j].nvw[s->iview]; ++k) {
 				int koff = k + s->propcats[j].ivw[s->iview];
+				int ival = (koff + s->propcats[j].off) *
+					s->nalloc + isort;
 
 				ui_entry_renderer_apply(
 					get_ui_entry_renderer_index(
 					s->propcats[j].entries[koff]), NULL, 0,
-					e->vals + koff + s->propcats[j].off,
-					e->auxvals + koff + s->propcats[j].off,
+					s->vals + ival, s->auxvals + ival,
 					1, &rdetails);
 				++rdetails.value_position.x;
 				rdetails.alternate_color_first =
@@ -126,6 +126,8 @@ struct cmd_info cmd_action[] =
 	{ "Walk into a trap", { 'W', '-' }, CMD_JUMP, NULL, NULL, 0, NULL, NULL, NULL, 0 },
 	{ "Change shape", { '!' }, CMD_RESHAPE, NULL, NULL, 0, NULL, NULL, NULL, 0  },
 	{ "Move house", { '$' }, CMD_MOVE, NULL, NULL, 0, NULL, NULL, NULL, 0  },
+	{ "Travel to a location", { '%' }, CMD_NULL, textui_travel, NULL, 0, NULL, NULL, NULL, 0 },
+	{ "Explore the level", { '&' }, CMD_EXPLORE, NULL, NULL, 0, NULL, NULL, NULL, 0 },
 };
 
 /**
@@ -273,6 +275,10 @@ struct cmd_info cmd_debug_stats[] =
 	{ "Objects and monsters", { 'S' }, CMD_WIZ_COLLECT_OBJ_MON_STATS, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
 	{ "Pits", { 'P' }, CMD_WIZ_COLLECT_PIT_STATS, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
 	{ "Disconnected levels", { 'D' }, CMD_WIZ_COLLECT_DISCONNECT_STATS, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
+	{ "Store maintenance", { 'B' }, CMD_WIZ_BENCHMARK_STORES, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
+	{ "Object memory", { 'O' }, CMD_WIZ_OBJECT_MEMORY, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
+	{ "Game events", { 'N' }, CMD_WIZ_EVENT_STATS, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
+	{ "Time game functions", { 'Z' }, CMD_WIZ_PROFILE, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
 	{ "Obj/mon alternate key", { 'f' }, CMD_WIZ_COLLECT_OBJ_MON_STATS, NULL, player_can_debug_prereq, 0, NULL, NULL, NULL, 0 },
 };
 
@@ -24,6 +24,7 @@
 
 
 #include "angband.h"
+#include "cave.h"
 #include "game-input.h"
 #include "game-event.h"
 #include "init.h"
@@ -33,6 +34,7 @@
 #include "ui-input.h"
 #include "ui-keymap.h"
 #include "ui-knowledge.h"
+#include "ui-map.h"
 #include "ui-options.h"
 #include "ui-output.h"
 #include "ui-prefs.h"
@@ -113,4 +115,5 @@ void textui_cleanup(void)
 	keymap_free();
 	textui_prefs_free();
 	textui_knowledge_cleanup();
+	display_map_forget();
 }
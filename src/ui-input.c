@@ -232,6 +232,9 @@ ui_event inkey_ex(void)
 
 		/* Hack -- Flush output once when no key ready */
 		if (!done && (0 != Term_inkey(&kk, false, false))) {
+			/* Draw any list updates that were held back */
+			event_deliver_pending();
+
 			/* Hack -- activate proper term */
 			Term_activate(old);
 
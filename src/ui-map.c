@@ -752,6 +752,250 @@ void prt_map(void)
 		}
 }
 
+/**
+ * The small-scale map's record of which grid it shows in each of its cells.
+ * The winner in a cell is the grid with the highest display priority going
+ * only by what the player knows - terrain, objects and traps - with the first
+ * in reading order winning ties.  Monsters are laid over that each time the
+ * map is drawn, and grids whose knowledge changes are picked up from the known
+ * map's journal, so drawing the map only looks at the whole level when the
+ * level or the map's size changes.
+ */
+struct overview_cell {
+	int grid;		/* Index (y * width + x) of the winning grid */
+	byte prio;		/* Its priority, zero for nothing shown */
+};
+
+struct overview {
+	const term *t;
+	const struct chunk *c;
+	u32b generation;	/* map_render_generation() when built */
+	u32b cursor;		/* Position read up to in the journal */
+	int map_hgt, map_wid;
+	int tile_hgt, tile_wid;
+	int *row_lo, *row_hi;	/* First and last level row in each map row */
+	int *col_lo, *col_hi;	/* First and last level column in each map column */
+	struct overview_cell *cells;
+	struct overview_cell *shown;	/* Scratch space for drawing */
+};
+
+/**
+ * One for the main screen and a few subwindows
+ */
+#define OVERVIEW_MAX 4
+
+static struct overview overviews[OVERVIEW_MAX];
+static int overview_oldest;
+
+static void overview_free(struct overview *o)
+{
+	mem_free(o->row_lo);
+	mem_free(o->row_hi);
+	mem_free(o->col_lo);
+	mem_free(o->col_hi);
+	mem_free(o->cells);
+	mem_free(o->shown);
+	memset(o, 0, sizeof(*o));
+}
+
+/**
+ * Forget every small-scale map, as on arriving on a new level.
+ */
+void display_map_forget(void)
+{
+	int i;
+
+	for (i = 0; i < OVERVIEW_MAX; i++)
+		overview_free(&overviews[i]);
+}
+
+/**
+ * Get the map row showing a level row, as display_map() has always done it.
+ */
+static int overview_row(int y, int map_hgt, int cave_hgt)
+{
+	int row = (y * map_hgt) / cave_hgt;
+
+	if (tile_height > 1) row = row - (row % tile_height);
+	return row;
+}
+
+static int overview_col(int x, int map_wid, int cave_wid)
+{
+	int col = (x * map_wid) / cave_wid;
+
+	if (tile_width > 1) col = col - (col % tile_width);
+	return col;
+}
+
+/**
+ * Get how strongly a grid claims its map cell, from what the player knows.
+ */
+static byte overview_priority(struct loc grid)
+{
+	struct grid_data g;
+	int a, ta;
+	wchar_t c, tc;
+
+	map_info(grid, &g);
+	g.m_idx = 0;
+	g.is_player = false;
+	g.lighting = LIGHTING_LIT;
+	grid_data_as_text(&g, &a, &c, &ta, &tc);
+
+	/* Stuff on top of terrain gets higher priority */
+	if ((a != ta) || (c != tc)) return 20;
+	return f_info[g.f_idx].priority;
+}
+
+/**
+ * Work out the winner of one map cell again.
+ */
+static void overview_update_cell(struct overview *o, int row, int col)
+{
+	struct overview_cell *cell = &o->cells[row * o->map_wid + col];
+	int x, y;
+
+	cell->grid = -1;
+	cell->prio = 0;
+	for (y = o->row_lo[row]; y <= o->row_hi[row]; y++) {
+		for (x = o->col_lo[col]; x <= o->col_hi[col]; x++) {
+			byte tp = overview_priority(loc(x, y));
+
+			if (cell->prio < tp) {
+				cell->grid = y * cave->width + x;
+				cell->prio = tp;
+			}
+		}
+	}
+}
+
+/**
+ * Find the small-scale map for the current terminal and level, building it if
+ * there isn't one, and bring it up to date with what the player knows.  When
+ * the render cache has been forgotten (say because of a change to what is
+ * ignored) the map is built again.  Everything that forgets the whole cache
+ * also asks for the map to be redrawn, and the map subwindow is drawn at the
+ * end of every redraw, so it gets here straight afterwards.
+ */
+static struct overview *overview_get(int map_hgt, int map_wid)
+{
+	struct overview *o = NULL;
+	const struct known_change *changes;
+	int i, n, x, y;
+
+	for (i = 0; i < OVERVIEW_MAX; i++) {
+		if (overviews[i].t == Term) {
+			o = &overviews[i];
+			break;
+		}
+	}
+	if (o && (o->c != player->cave || o->map_hgt != map_hgt ||
+			o->map_wid != map_wid || o->tile_hgt != tile_height ||
+			o->tile_wid != tile_width ||
+			o->generation != map_render_generation())) {
+		overview_free(o);
+	} else if (o) {
+		/* Catch up with the journal, or start again if too far behind */
+		if (cave_journal_read(player->cave, &o->cursor, &changes, &n)) {
+			for (i = 0; i < n; i++) {
+				struct loc grid = changes[i].grid;
+
+				overview_update_cell(o,
+					overview_row(grid.y, map_hgt, cave->height),
+					overview_col(grid.x, map_wid, cave->width));
+			}
+			return o;
+		}
+		overview_free(o);
+	} else {
+		o = &overviews[overview_oldest];
+		overview_oldest = (overview_oldest + 1) % OVERVIEW_MAX;
+		overview_free(o);
+	}
+
+	/* Build it */
+	o->t = Term;
+	o->c = player->cave;
+	o->generation = map_render_generation();
+	o->cursor = player->cave->journal.next;
+	o->map_hgt = map_hgt;
+	o->map_wid = map_wid;
+	o->tile_hgt = tile_height;
+	o->tile_wid = tile_width;
+	o->row_lo = mem_alloc(map_hgt * sizeof(int));
+	o->row_hi = mem_alloc(map_hgt * sizeof(int));
+	o->col_lo = mem_alloc(map_wid * sizeof(int));
+	o->col_hi = mem_alloc(map_wid * sizeof(int));
+	o->cells = mem_alloc(map_hgt * map_wid * sizeof(*o->cells));
+	o->shown = mem_alloc(map_hgt * map_wid * sizeof(*o->shown));
+
+	/* Empty rows and columns have lo > hi */
+	for (i = 0; i < map_hgt; i++) {
+		o->row_lo[i] = cave->height;
+		o->row_hi[i] = -1;
+	}
+	for (y = 0; y < cave->height; y++) {
+		int row = overview_row(y, map_hgt, cave->height);
+
+		o->row_lo[row] = MIN(o->row_lo[row], y);
+		o->row_hi[row] = MAX(o->row_hi[row], y);
+	}
+	for (i = 0; i < map_wid; i++) {
+		o->col_lo[i] = cave->width;
+		o->col_hi[i] = -1;
+	}
+	for (x = 0; x < cave->width; x++) {
+		int col = overview_col(x, map_wid, cave->width);
+
+		o->col_lo[col] = MIN(o->col_lo[col], x);
+		o->col_hi[col] = MAX(o->col_hi[col], x);
+	}
+
+	for (i = 0; i < map_hgt * map_wid; i++) {
+		o->cells[i].grid = -1;
+		o->cells[i].prio = 0;
+	}
+	for (y = 0; y < cave->height; y++) {
+		int row = overview_row(y, map_hgt, cave->height);
+
+		for (x = 0; x < cave->width; x++) {
+			int col = overview_col(x, map_wid, cave->width);
+			struct overview_cell *cell = &o->cells[row * map_wid + col];
+			byte tp = overview_priority(loc(x, y));
+
+			if (cell->prio < tp) {
+				cell->grid = y * cave->width + x;
+				cell->prio = tp;
+			}
+		}
+	}
+
+	return o;
+}
+
+/**
+ * Draw one grid in a cell of the small-scale map.
+ */
+static void display_map_grid(struct loc grid, int row, int col)
+{
+	struct grid_data g;
+	int a, ta;
+	wchar_t c, tc;
+
+	map_info(grid, &g);
+
+	/* Hack - make every grid on the map lit */
+	g.lighting = LIGHTING_LIT;
+	grid_data_as_text(&g, &a, &c, &ta, &tc);
+
+	Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
+
+	if ((tile_width > 1) || (tile_height > 1))
+		Term_big_queue_char(Term, col + 1, row + 1, Term->hgt - 1, 255, -1,
+			0, 0);
+}
+
 /**
  * Display a "small-scale" map of the dungeon in the active Term.
  *
@@ -772,38 +1016,21 @@ void display_map(int *cy, int *cx)
 	int map_hgt, map_wid;
 	int row, col;
 
-	int x, y;
+	int x, y, i;
 	struct grid_data g;
 
 	int a, ta;
 	wchar_t c, tc;
 
-	byte tp;
-
 	struct monster_race *race = &r_info[0];
-
-	/* Priority array */
-	byte **mp = mem_zalloc(cave->height * sizeof(byte*));
-	for (y = 0; y < cave->height; y++)
-		mp[y] = mem_zalloc(cave->width * sizeof(byte));
+	struct overview *o;
 
 	/* Desired map height */
 	get_minimap_dimensions(Term, cave, tile_width, tile_height,
 		&map_wid, &map_hgt);
 
 	/* Prevent accidents */
-	if ((map_wid < 1) || (map_hgt < 1)) {
-		for (y = 0; y < cave->height; y++)
-			mem_free(mp[y]);
-		mem_free(mp);
-		return;
-	}
-
-	/* Nothing here */
-	a = COLOUR_WHITE;
-    c = L' ';
-	ta = COLOUR_WHITE;
-	tc = L' ';
+	if ((map_wid < 1) || (map_hgt < 1)) return;
 
 	/* Draw a box around the edge of the term */
 	window_make(0, 0, map_wid + 1, map_hgt + 1);
@@ -820,40 +1047,78 @@ void display_map(int *cy, int *cx)
 		}
 	}
 
-	/* Analyze the actual map */
-	for (y = 0; y < cave->height; y++) {
-		row = (y * map_hgt) / cave->height;
-		if (tile_height > 1) row = row - (row % tile_height);
+	if (player->timed[TMD_IMAGE]) {
+		/* Hallucinations are different every time, so look at every grid */
+		byte **mp = mem_zalloc(map_hgt * sizeof(byte*));
+		for (y = 0; y < map_hgt; y++)
+			mp[y] = mem_zalloc(map_wid * sizeof(byte));
 
-		for (x = 0; x < cave->width; x++) {
-			col = (x * map_wid) / cave->width;
-			if (tile_width > 1) col = col - (col % tile_width);
+		for (y = 0; y < cave->height; y++) {
+			row = overview_row(y, map_hgt, cave->height);
 
-			/* Get the attr/char at that map location */
-			map_info(loc(x, y), &g);
-			grid_data_as_text(&g, &a, &c, &ta, &tc);
+			for (x = 0; x < cave->width; x++) {
+				byte tp;
 
-			/* Get the priority of that attr/char */
-			tp = f_info[g.f_idx].priority;
+				col = overview_col(x, map_wid, cave->width);
 
-			/* Stuff on top of terrain gets higher priority */
-			if ((a != ta) || (c != tc)) tp = 20;
-
-			/* Save "best" */
-			if (mp[row][col] < tp) {
-				/* Hack - make every grid on the map lit */
-				g.lighting = LIGHTING_LIT;
+				/* Get the attr/char at that map location */
+				map_info(loc(x, y), &g);
 				grid_data_as_text(&g, &a, &c, &ta, &tc);
 
-				Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
+				/* Get the priority of that attr/char */
+				tp = f_info[g.f_idx].priority;
 
-				if ((tile_width > 1) || (tile_height > 1))
-					Term_big_queue_char(Term, col + 1,
-						row + 1, Term->hgt - 1,
-						255, -1, 0, 0);
+				/* Stuff on top of terrain gets higher priority */
+				if ((a != ta) || (c != tc)) tp = 20;
 
-				/* Save priority */
-				mp[row][col] = tp;
+				/* Save "best" */
+				if (mp[row][col] < tp) {
+					display_map_grid(loc(x, y), row, col);
+					mp[row][col] = tp;
+				}
+			}
+		}
+
+		for (y = 0; y < map_hgt; y++)
+			mem_free(mp[y]);
+		mem_free(mp);
+	} else {
+		/* Start from what the player knows */
+		o = overview_get(map_hgt, map_wid);
+		memcpy(o->shown, o->cells, map_hgt * map_wid * sizeof(*o->shown));
+
+		/* Lay the visible monsters over it */
+		for (i = 1; i < cave_monster_max(cave); i++) {
+			struct monster *mon = cave_monster(cave, i);
+			struct overview_cell *cell;
+			int grid;
+			byte tp;
+
+			if (!mon->race || !monster_is_visible(mon)) continue;
+			map_info(mon->grid, &g);
+			grid_data_as_text(&g, &a, &c, &ta, &tc);
+			tp = f_info[g.f_idx].priority;
+			if ((a != ta) || (c != tc)) tp = 20;
+
+			row = overview_row(mon->grid.y, map_hgt, cave->height);
+			col = overview_col(mon->grid.x, map_wid, cave->width);
+			cell = &o->shown[row * map_wid + col];
+			grid = mon->grid.y * cave->width + mon->grid.x;
+			if (cell->prio < tp || (cell->prio == tp && grid < cell->grid)) {
+				cell->grid = grid;
+				cell->prio = tp;
+			}
+		}
+
+		/* Draw the winners */
+		for (row = 0; row < map_hgt; row++) {
+			for (col = 0; col < map_wid; col++) {
+				const struct overview_cell *cell =
+					&o->shown[row * map_wid + col];
+
+				if (!cell->prio) continue;
+				display_map_grid(loc(cell->grid % cave->width,
+					cell->grid / cave->width), row, col);
 			}
 		}
 	}
@@ -861,13 +1126,8 @@ void display_map(int *cy, int *cx)
 	/*** Display the player ***/
 
 	/* Player location */
-	row = (player->grid.y * map_hgt / cave->height);
-	col = (player->grid.x * map_wid / cave->width);
-
-	if (tile_width > 1)
-		col = col - (col % tile_width);
-	if (tile_height > 1)
-		row = row - (row % tile_height);
+	row = overview_row(player->grid.y, map_hgt, cave->height);
+	col = overview_col(player->grid.x, map_wid, cave->width);
 
 	/* Get the terrain at the player's spot. */
 	map_info(player->grid, &g);
@@ -888,10 +1148,6 @@ void display_map(int *cy, int *cx)
 	/* Return player location */
 	if (cy != NULL) (*cy) = row + 1;
 	if (cx != NULL) (*cx) = col + 1;
-
-	for (y = 0; y < cave->height; y++)
-		mem_free(mp[y]);
-	mem_free(mp);
 }
 
 static void print_map_name(int place, int row, int col, bool down)
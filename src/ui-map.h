@@ -21,5 +21,6 @@ extern void grid_data_as_text(struct grid_data *g, int *ap, wchar_t *cp,
 extern void move_cursor_relative(int y, int x);
 extern void print_rel(wchar_t c, byte a, int y, int x);
 extern void prt_map(void);
+extern void display_map_forget(void);
 extern void display_map(int *cy, int *cx);
 extern void do_cmd_view_map(void);
@@ -149,7 +149,8 @@ void lore_description(textblock *tb, const struct monster_race *race,
 		textblock_append(tb, "You know everything about this monster.");
 
 	/* Player ghosts may have unique descriptions. */
-	if (rf_has(race->flags, RF_PLAYER_GHOST) && (cave->ghost->string_type == 2))
+	if (rf_has(race->flags, RF_PLAYER_GHOST) && cave && cave->ghost &&
+		(cave->ghost->string_type == 2))
 		textblock_append(tb, format("%s  ", cave->ghost->string));
 
 	/* Notice "Quest" monsters */
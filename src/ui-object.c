@@ -1715,7 +1715,7 @@ void textui_cmd_ignore_menu(struct object *obj)
 		ignore_level[ignore_type] = ignore_value;
 	}
 
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 
 	menu_dynamic_free(m);
 }
@@ -1737,7 +1737,7 @@ void textui_cmd_ignore(void)
 void textui_cmd_toggle_ignore(void)
 {
 	player->unignoring = !player->unignoring;
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 	do_cmd_redraw();
 }
 
@@ -1540,8 +1540,10 @@ static bool quality_action(struct menu *m, const ui_event *event, int oid)
 	evt = menu_select(&menu, 0, true);
 
 	/* Set the new value appropriately */
-	if (evt.type == EVT_SELECT)
+	if (evt.type == EVT_SELECT) {
 		ignore_level[oid] = menu.cursor;
+		ignore_settings_changed(player);
+	}
 
 	/* Load and finish */
 	screen_load();
@@ -1676,7 +1678,7 @@ static bool ignore_sval_menu_action(struct menu *m, const ui_event *event,
 		else
 			kind->ignore ^= IGNORE_IF_UNAWARE;
 
-		player->upkeep->notice |= PN_IGNORE;
+		ignore_settings_changed(player);
 		return true;
 	}
 
@@ -1943,7 +1945,7 @@ void do_cmd_options_item(const char *title, int row)
 	menu_select(&menu, 0, false);
 	screen_load();
 
-	player->upkeep->notice |= PN_IGNORE;
+	ignore_settings_changed(player);
 
 	return;
 }
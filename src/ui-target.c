@@ -905,6 +905,14 @@ void textui_target(void)
 		msg("Target Aborted.");
 }
 
+/**
+ * Pick a location to travel to; 'g' in look mode does the travelling
+ */
+void textui_travel(void)
+{
+	target_set_interactive(TARGET_LOOK, player->grid.x, player->grid.y);
+}
+
 /**
  * Target closest monster.
  *
@@ -1352,8 +1360,8 @@ bool target_set_interactive(int mode, int x, int y)
 			}
 
 		} else if (event_is_key(press, 'g')) {
-			/* Navigate to a location and done */
-			cmdq_push(CMD_PATHFIND);
+			/* Travel to a location and done */
+			cmdq_push(CMD_TRAVEL);
 			cmd_set_arg_point(cmdq_peek(), "point", loc(x, y));
 			done = true;
 
@@ -51,6 +51,7 @@ int target_dir_allow(struct keypress ch, bool allow_5);
 void target_display_help(bool monster, bool object, bool free);
 void textui_target(void);
 void textui_target_closest(void);
+void textui_travel(void);
 bool target_set_interactive(int mode, int x, int y);
 
 #endif /* UI_TARGET_H */
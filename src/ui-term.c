@@ -19,6 +19,7 @@
 #include "h-basic.h"
 #include "ui-term.h"
 #include "z-color.h"
+#include "z-profile.h"
 #include "z-util.h"
 #include "z-virt.h"
 
@@ -1708,6 +1709,8 @@ errr Term_fresh(void)
 		return (1);
 	}
 
+	PROFILE_BEGIN(TERM_FRESH);
+
 
 	/* Paranoia -- use "fake" hooks to prevent core dumps */
 	if (!Term->curs_hook) Term->curs_hook = Term_curs_hack;
@@ -1929,6 +1932,8 @@ errr Term_fresh(void)
 	/* Actually flush the output */
 	Term_xtra(TERM_XTRA_FRESH, 0);
 
+	PROFILE_END(TERM_FRESH);
+
 	/* Success */
 	return (0);
 }
@@ -46,36 +46,78 @@
 
 
 /**
- * The spoiler file being created
+ * Add `n' of the character `c' to a spoiler
  */
-static ang_file *fh = NULL;
+static void spoiler_out_n_chars(textblock *tb, int n, char c)
+{
+	while (--n >= 0) textblock_append(tb, "%c", c);
+}
 
+/**
+ * Add `n' blank lines to a spoiler
+ */
+static void spoiler_blanklines(textblock *tb, int n)
+{
+	spoiler_out_n_chars(tb, n, '\n');
+}
 
 /**
- * Write out `n' of the character `c' to the spoiler file
+ * Add a line to a spoiler and then "underline" it with hypens
  */
-static void spoiler_out_n_chars(int n, char c)
+static void spoiler_underline(textblock *tb, const char *str, char c)
 {
-	while (--n >= 0) file_writec(fh, c);
+	textblock_append(tb, "%s\n", str);
+	spoiler_out_n_chars(tb, strlen(str), c);
+	textblock_append(tb, "\n");
 }
 
 /**
- * Write out `n' blank lines to the spoiler file
+ * Add formatted text to a spoiler, wrapped at 75 columns
  */
-static void spoiler_blanklines(int n)
+static void spoiler_text(textblock *tb, const char *fmt, ...)
 {
-	spoiler_out_n_chars(n, '\n');
+	textblock *text = textblock_new();
+	char buf[1024];
+	va_list vp;
+
+	va_start(vp, fmt);
+	(void)vstrnfmt(buf, sizeof(buf), fmt, vp);
+	va_end(vp);
+
+	textblock_append(text, "%s", buf);
+	textblock_append_wrapped(tb, text, 75);
+	textblock_free(text);
 }
 
 /**
- * Write a line to the spoiler file and then "underline" it with hypens
+ * Write a spoiler to the file `fname' in the user directory
  */
-static void spoiler_underline(const char *str, char c)
+static void spoiler_write(textblock *tb, const char *fname)
 {
-	text_out("%s", str);
-	text_out("\n");
-	spoiler_out_n_chars(strlen(str), c);
-	text_out("\n");
+	char buf[1024];
+	ang_file *fh;
+
+	/* Open the file */
+	path_build(buf, sizeof(buf), ANGBAND_DIR_USER, fname);
+	fh = file_open(buf, MODE_WRITE, FTYPE_TEXT);
+
+	/* Oops */
+	if (!fh) {
+		msg("Cannot create spoiler file.");
+		return;
+	}
+
+	/* The text is already laid out */
+	textblock_to_file(tb, fh, 0, SPOILER_NOWRAP);
+
+	/* Check for errors */
+	if (!file_close(fh)) {
+		msg("Cannot close spoiler file.");
+		return;
+	}
+
+	/* Message */
+	msg("Successfully created a spoiler file.");
 }
 
 
@@ -198,9 +240,9 @@ static void kind_info(char *buf, size_t buf_len, char *dam, size_t dam_len,
 
 
 /**
- * Create a spoiler file for items
+ * Create a spoiler for items
  */
-void spoil_obj_desc(const char *fname)
+textblock *spoil_obj_desc_text(void)
 {
 	int i, k, s, t, n = 0;
 	u16b *who;
@@ -208,26 +250,17 @@ void spoil_obj_desc(const char *fname)
 	char wgt[80];
 	char dam[80];
 	const char *format = "%-51s  %7s%6s%4s%9s\n";
-
-	/* Open the file */
-	path_build(buf, sizeof(buf), ANGBAND_DIR_USER, fname);
-	fh = file_open(buf, MODE_WRITE, FTYPE_TEXT);
-
-	/* Oops */
-	if (!fh) {
-		msg("Cannot create spoiler file.");
-		return;
-	}
+	textblock *tb = textblock_new();
 
 	/* Allocate the "who" array */
 	who = mem_zalloc(z_info->r_max * sizeof(u16b));
 
 	/* Header */
-	file_putf(fh, "Spoiler File -- Basic Items (%s)\n\n\n", buildid);
+	textblock_append(tb, "Spoiler File -- Basic Items (%s)\n\n\n", buildid);
 
 	/* More Header */
-	file_putf(fh, format, "Description", "Dam/AC", "Wgt", "Lev", "Cost");
-	file_putf(fh, format, "----------------------------------------",
+	textblock_append(tb, format, "Description", "Dam/AC", "Wgt", "Lev", "Cost");
+	textblock_append(tb, format, "----------------------------------------",
 	        "------", "---", "---", "----");
 
 	/* List the groups */
@@ -283,12 +316,12 @@ void spoil_obj_desc(const char *fname)
 				 */
 				u8len = utf8_strlen(buf);
 				if (u8len < 51) {
-					file_putf(fh, "  %s%*s", buf,
+					textblock_append(tb, "  %s%*s", buf,
 						(int) (51 - u8len), " ");
 				} else {
-					file_putf(fh, "  %s", buf);
+					textblock_append(tb, "  %s", buf);
 				}
-				file_putf(fh, "%7s%6s%4d%9ld\n", dam, wgt, e,
+				textblock_append(tb, "%7s%6s%4d%9ld\n", dam, wgt, e,
 						  (long)(v));
 			}
 
@@ -299,7 +332,7 @@ void spoil_obj_desc(const char *fname)
 			if (!group_item[i].tval) break;
 
 			/* Start a new set */
-			file_putf(fh, "\n\n%s\n\n", group_item[i].name);
+			textblock_append(tb, "\n\n%s\n\n", group_item[i].name);
 		}
 
 		/* Get legal item types */
@@ -320,14 +353,19 @@ void spoil_obj_desc(const char *fname)
 	/* Free the "who" array */
 	mem_free(who);
 
-	/* Check for errors */
-	if (!file_close(fh)) {
-		msg("Cannot close spoiler file.");
-		return;
-	}
+	return tb;
+}
 
-	/* Message */
-	msg("Successfully created a spoiler file.");
+
+/**
+ * Create a spoiler file for items
+ */
+void spoil_obj_desc(const char *fname)
+{
+	textblock *tb = spoil_obj_desc_text();
+
+	spoiler_write(tb, fname);
+	textblock_free(tb);
 }
 
 
@@ -371,39 +409,25 @@ static const grouper group_artifact[] =
 
 
 /**
- * Create a spoiler file for artifacts
+ * Create a spoiler for artifacts
  */
-void spoil_artifact(const char *fname)
+textblock *spoil_artifact_text(void)
 {
 	int i, j;
-	char buf[1024];
-
-	/* Build the filename */
-	path_build(buf, sizeof(buf), ANGBAND_DIR_USER, fname);
-	fh = file_open(buf, MODE_WRITE, FTYPE_TEXT);
-
-	/* Oops */
-	if (!fh) {
-		msg("Cannot create spoiler file.");
-		return;
-	}
-
-	/* Dump to the spoiler file */
-	text_out_hook = text_out_to_file;
-	text_out_file = fh;
+	textblock *tb = textblock_new();
 
 	/* Dump the header */
-	spoiler_underline(format("Artifact Spoilers for %s", buildid), '=');
+	spoiler_underline(tb, format("Artifact Spoilers for %s", buildid), '=');
 
-	text_out("\n Randart seed is %u\n", seed_randart);
+	spoiler_text(tb, "\nRandart seed is %u\n", seed_randart);
 
 	/* List the artifacts by tval */
 	for (i = 0; group_artifact[i].tval; i++) {
 		/* Write out the group title */
 		if (group_artifact[i].name) {
-			spoiler_blanklines(2);
-			spoiler_underline(group_artifact[i].name, '=');
-			spoiler_blanklines(1);
+			spoiler_blanklines(tb, 2);
+			spoiler_underline(tb, group_artifact[i].name, '=');
+			spoiler_blanklines(tb, 1);
 		}
 
 		/* Now search through all of the artifacts */
@@ -412,6 +436,7 @@ void spoil_artifact(const char *fname)
 			struct artifact artc;
 			char buf2[80];
 			struct object *obj, *known_obj;
+			textblock *info;
 
 			/* We only want objects in the current group */
 			if (art->tval != group_artifact[i].tval) continue;
@@ -442,40 +467,47 @@ void spoil_artifact(const char *fname)
 				ODESC_COMBAT | ODESC_EXTRA | ODESC_SPOIL, NULL);
 
 			/* Print name and underline */
-			spoiler_underline(buf2, '-');
+			spoiler_underline(tb, buf2, '-');
 
-			/* Write out the artifact description to the spoiler file */
-			object_info_spoil(fh, obj, 80);
+			/* Write out the artifact description to the spoiler */
+			info = object_info_spoil(obj);
+			textblock_append_wrapped(tb, info, 80);
+			textblock_free(info);
 
 			/*
 			 * Determine the minimum and maximum depths an
 			 * artifact can appear, its rarity, its weight, and
 			 * its power rating.
 			 */
-			text_out("\nMin Level %u, Max Level %u, Gen chance %u, %d.%d lbs\n",
+			spoiler_text(tb, "\nMin Level %u, Max Level %u, Gen chance %u, %d.%d lbs\n",
 					 art->alloc_min, art->alloc_max, art->alloc_prob,
 					 (art->weight / 10), (art->weight % 10));
 
 			/* Include description for randarts, which gives generation info */
 			if (j >= z_info->a_max - ART_NUM_RANDOM) {
-				text_out("%s.\n", art->text);
+				spoiler_text(tb, "%s.\n", art->text);
 			}
 
 			/* Terminate the entry */
-			spoiler_blanklines(2);
+			spoiler_blanklines(tb, 2);
 			object_delete(NULL, NULL, &known_obj);
 			object_delete(NULL, NULL, &obj);
 		}
 	}
 
-	/* Check for errors */
-	if (!file_close(fh)) {
-		msg("Cannot close spoiler file.");
-		return;
-	}
+	return tb;
+}
 
-	/* Message */
-	msg("Successfully created a spoiler file.");
+
+/**
+ * Create a spoiler file for artifacts
+ */
+void spoil_artifact(const char *fname)
+{
+	textblock *tb = spoil_artifact_text();
+
+	spoiler_write(tb, fname);
+	textblock_free(tb);
 }
 
 
@@ -484,14 +516,12 @@ void spoil_artifact(const char *fname)
  * Brief monster spoilers
  * ------------------------------------------------------------------------ */
 /**
- * Create a brief spoiler file for monsters
+ * Create a brief spoiler for monsters
  */
-void spoil_mon_desc(const char *fname)
+textblock *spoil_mon_desc_text(void)
 {
 	int i, n = 0;
 
-	char buf[1024];
-
 	char nam[80];
 	char lev[80];
 	char rar[80];
@@ -501,25 +531,16 @@ void spoil_mon_desc(const char *fname)
 	char exp[80];
 
 	u16b *who;
-
-	/* Build the filename */
-	path_build(buf, sizeof(buf), ANGBAND_DIR_USER, fname);
-	fh = file_open(buf, MODE_WRITE, FTYPE_TEXT);
-
-	/* Oops */
-	if (!fh) {
-		msg("Cannot create spoiler file.");
-		return;
-	}
+	textblock *tb = textblock_new();
 
 	/* Dump the header */
-	file_putf(fh, "Monster Spoilers for %s\n", buildid);
-	file_putf(fh, "------------------------------------------\n\n");
+	textblock_append(tb, "Monster Spoilers for %s\n", buildid);
+	textblock_append(tb, "------------------------------------------\n\n");
 
 	/* Dump the header */
-	file_putf(fh, "%-40.40s%4s%4s%6s%8s%4s  %11.11s\n",
+	textblock_append(tb, "%-40.40s%4s%4s%6s%8s%4s  %11.11s\n",
 	        "Name", "Lev", "Rar", "Spd", "Hp", "Ac", "Visual Info");
-	file_putf(fh, "%-40.40s%4s%4s%6s%8s%4s  %11.11s\n",
+	textblock_append(tb, "%-40.40s%4s%4s%6s%8s%4s  %11.11s\n",
 	        "----", "---", "---", "---", "--", "--", "-----------");
 
 	/* Allocate the "who" array */
@@ -582,31 +603,36 @@ void spoil_mon_desc(const char *fname)
 		 */
 		u8len = utf8_strlen(nam);
 		if (u8len < 40) {
-			file_putf(fh, "%s%*s", nam, (int) (40 - u8len), " ");
+			textblock_append(tb, "%s%*s", nam, (int) (40 - u8len), " ");
 		} else {
 			if (u8len > 40) {
 				utf8_clipto(nam, 40);
 			}
-			file_putf(fh, "%s", nam);
+			textblock_append(tb, "%s", nam);
 		}
-		file_putf(fh, "%4s%4s%6s%8s%4s  %11.11s\n",
+		textblock_append(tb, "%4s%4s%6s%8s%4s  %11.11s\n",
 		        lev, rar, spd, hp, ac, exp);
 	}
 
 	/* End it */
-	file_putf(fh, "\n");
+	textblock_append(tb, "\n");
 
 	/* Free the "who" array */
 	mem_free(who);
 
-	/* Check for errors */
-	if (!file_close(fh)) {
-		msg("Cannot close spoiler file.");
-		return;
-	}
+	return tb;
+}
 
-	/* Worked */
-	msg("Successfully created a spoiler file.");
+
+/**
+ * Create a brief spoiler file for monsters
+ */
+void spoil_mon_desc(const char *fname)
+{
+	textblock *tb = spoil_mon_desc_text();
+
+	spoiler_write(tb, fname);
+	textblock_free(tb);
 }
 
 
@@ -619,32 +645,29 @@ void spoil_mon_desc(const char *fname)
 
 
 /**
- * Create a spoiler file for monsters (-SHAWN-)
+ * Create a spoiler for monsters (-SHAWN-).  The monsters can be split, in
+ * order, into `parts' pieces, of which this creates piece `part'; the header
+ * is part of the first piece.
  */
-void spoil_mon_info(const char *fname)
+textblock *spoil_mon_info_text(int part, int parts)
 {
-	char buf[1024];
 	int i, n;
 	u16b *who;
 	int count = 0;
+	textblock *out = textblock_new();
 	textblock *tb = NULL;
 
-	/* Open the file */
-	path_build(buf, sizeof(buf), ANGBAND_DIR_USER, fname);
-	fh = file_open(buf, MODE_WRITE, FTYPE_TEXT);
-
-	if (!fh) {
-		msg("Cannot create spoiler file.");
-		return;
-	}
+	assert(part >= 0 && part < parts);
 
 	/* Dump the header */
-	tb = textblock_new();
-	textblock_append(tb, "Monster Spoilers for %s\n", buildid);
-	textblock_append(tb, "------------------------------------------\n\n");
-	textblock_to_file(tb, fh, 0, 75);
-	textblock_free(tb);
-	tb = NULL;
+	if (part == 0) {
+		tb = textblock_new();
+		textblock_append(tb, "Monster Spoilers for %s\n", buildid);
+		textblock_append(tb, "------------------------------------------\n\n");
+		textblock_append_wrapped(out, tb, 75);
+		textblock_free(tb);
+		tb = NULL;
+	}
 
 	/* Allocate the "who" array */
 	who = mem_zalloc(z_info->r_max * sizeof(u16b));
@@ -659,8 +682,8 @@ void spoil_mon_info(const char *fname)
 
 	sort(who, count, sizeof(*who), cmp_monsters);
 
-	/* List all monsters in order. */
-	for (n = 0; n < count; n++) {
+	/* List this part's monsters in order. */
+	for (n = count * part / parts; n < count * (part + 1) / parts; n++) {
 		int r_idx = who[n];
 		const struct monster_race *race = &r_info[r_idx];
 		const struct monster_lore *lore = &l_list[r_idx];
@@ -700,7 +723,7 @@ void spoil_mon_info(const char *fname)
 		lore_description(tb, race, lore, true);
 		textblock_append(tb, "\n");
 
-		textblock_to_file(tb, fh, 0, 75);
+		textblock_append_wrapped(out, tb, 75);
 		textblock_free(tb);
 		tb = NULL;
 	}
@@ -708,11 +731,17 @@ void spoil_mon_info(const char *fname)
 	/* Free the "who" array */
 	mem_free(who);
 
-	/* Check for errors */
-	if (!file_close(fh)) {
-		msg("Cannot close spoiler file.");
-		return;
-	}
+	return out;
+}
 
-	msg("Successfully created a spoiler file.");
+
+/**
+ * Create a spoiler file for monsters (-SHAWN-)
+ */
+void spoil_mon_info(const char *fname)
+{
+	textblock *tb = spoil_mon_info_text(0, 1);
+
+	spoiler_write(tb, fname);
+	textblock_free(tb);
 }
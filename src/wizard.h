@@ -20,6 +20,7 @@
 #define INCLUDED_WIZARD_H
 
 #include "cave.h"
+#include "z-textblock.h"
 
 /* For stat_grid_counter() */
 struct chunk;
@@ -77,6 +78,17 @@ void stat_grid_counter(struct chunk *c, struct grid_counter_pred *gpreds,
 void stat_grid_counter_simple(struct chunk *c, struct grid_counts counts[3]);
 
 /* wiz-spoil.c */
+
+/**
+ * Spoiler text is laid out in lines as it is created, so it should be output
+ * with this as the width to avoid wrapping it again.
+ */
+#define SPOILER_NOWRAP 1024
+
+textblock *spoil_artifact_text(void);
+textblock *spoil_mon_desc_text(void);
+textblock *spoil_mon_info_text(int part, int parts);
+textblock *spoil_obj_desc_text(void);
 void spoil_artifact(const char *fname);
 void spoil_mon_desc(const char *fname);
 void spoil_mon_info(const char *fname);
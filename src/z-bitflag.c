@@ -19,6 +19,62 @@
 #include "z-bitflag.h"
 
 
+/**
+ * Flag sets are worked on a 64-bit word at a time, with single bytes for any
+ * odd bytes at the end.  The words are read and written through memcpy(), so
+ * the sets need no special alignment; compilers turn that into plain loads
+ * and stores.  Only the bitwise operations care about the words, so the byte
+ * order of the machine doesn't matter.
+ */
+#define FLAG_WORD         sizeof(u64b)
+
+static inline u64b flag_load(const bitflag *flags)
+{
+	u64b w;
+
+	memcpy(&w, flags, sizeof(w));
+	return w;
+}
+
+static inline void flag_store(bitflag *flags, u64b w)
+{
+	memcpy(flags, &w, sizeof(w));
+}
+
+/**
+ * Count the set bits in a word.
+ */
+static inline int flag_popcount(u64b w)
+{
+#if defined(__GNUC__)
+	return __builtin_popcountll(w);
+#else
+	w = w - ((w >> 1) & 0x5555555555555555ULL);
+	w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+	w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+	return (int) ((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * Find the lowest set bit in a non-zero bitflag.
+ */
+static inline int flag_lowest(bitflag b)
+{
+#if defined(__GNUC__)
+	return __builtin_ctz(b);
+#else
+	int i = 0;
+
+	while (!(b & 1)) {
+		b >>= 1;
+		i++;
+	}
+	return i;
+#endif
+}
+
+
 /**
  * Tests if a flag is "on" in a bitflag set.
  *
@@ -71,17 +127,26 @@ bool flag_has_dbg(const bitflag *flags, const size_t size, const int flag,
  */
 int flag_next(const bitflag *flags, const size_t size, const int flag)
 {
-	const int max_flags = FLAG_MAX(size);
-	int f, flag_offset, flag_binary;
+	const int f = MAX(flag, FLAG_START);
+	size_t i;
+	bitflag b;
 
-	for (f = flag; f < max_flags; f++) {
-		flag_offset = FLAG_OFFSET(f);
-		flag_binary = FLAG_BINARY(f);
+	if (f >= FLAG_MAX(size)) return FLAG_END;
+
+	/* Finish off the byte holding the starting flag */
+	i = FLAG_OFFSET(f);
+	b = flags[i] & (bitflag) ~(FLAG_BINARY(f) - 1);
 
-		if (flags[flag_offset] & flag_binary) return f;
+	/* Skip empty words, then empty bytes */
+	while (!b) {
+		if (++i >= size) return FLAG_END;
+		while (i + FLAG_WORD <= size && !flag_load(flags + i))
+			i += FLAG_WORD;
+		if (i >= size) return FLAG_END;
+		b = flags[i];
 	}
 
-	return FLAG_END;
+	return FLAG_START + (int) (i * FLAG_WIDTH) + flag_lowest(b);
 }
 
 
@@ -92,16 +157,13 @@ int flag_next(const bitflag *flags, const size_t size, const int flag)
  */
 int flag_count(const bitflag *flags, const size_t size)
 {
-	size_t i, j;
+	size_t i = 0;
 	int count = 0;
 
-	for (i = 0; i < size; i++) {
-		for (j = 1; j <= FLAG_WIDTH; j++) {
-			if (flags[i] & FLAG_BINARY(j)) {
-				count++;
-			}
-		}
-	}
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD)
+		count += flag_popcount(flag_load(flags + i));
+	for (; i < size; i++)
+		count += flag_popcount(flags[i]);
 
 	return count;
 }
@@ -115,9 +177,11 @@ int flag_count(const bitflag *flags, const size_t size)
  */
 bool flag_is_empty(const bitflag *flags, const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (flag_load(flags + i)) return false;
+	for (; i < size; i++)
 		if (flags[i] > 0) return false;
 
 	return true;
@@ -132,9 +196,11 @@ bool flag_is_empty(const bitflag *flags, const size_t size)
  */
 bool flag_is_full(const bitflag *flags, const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (~flag_load(flags + i)) return false;
+	for (; i < size; i++)
 		if (flags[i] != (bitflag) -1) return false;
 
 	return true;
@@ -150,9 +216,11 @@ bool flag_is_full(const bitflag *flags, const size_t size)
 bool flag_is_inter(const bitflag *flags1, const bitflag *flags2,
 				   const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (flag_load(flags1 + i) & flag_load(flags2 + i)) return true;
+	for (; i < size; i++)
 		if (flags1[i] & flags2[i]) return true;
 
 	return false;
@@ -168,9 +236,11 @@ bool flag_is_inter(const bitflag *flags1, const bitflag *flags2,
 bool flag_is_subset(const bitflag *flags1, const bitflag *flags2,
 					const size_t size)
 {
-	size_t i;
+	size_t i = 0;
 
-	for (i = 0; i < size; i++)
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD)
+		if (~flag_load(flags1 + i) & flag_load(flags2 + i)) return false;
+	for (; i < size; i++)
 		if (~flags1[i] & flags2[i]) return false;
 
 	return true;
@@ -284,9 +354,11 @@ void flag_setall(bitflag *flags, const size_t size)
  */
 void flag_negate(bitflag *flags, const size_t size)
 {
-	size_t i;
-	
-	for (i = 0; i < size; i++)
+	size_t i = 0;
+
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD)
+		flag_store(flags + i, ~flag_load(flags + i));
+	for (; i < size; i++)
 		flags[i] = ~flags[i];
 }
 
@@ -312,17 +384,22 @@ void flag_copy(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_union(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-	size_t i;
-	bool delta = false;
+	size_t i = 0;
+	u64b delta = 0;
 
-	for (i = 0; i < size; i++) {
-		/* !flag_is_subset() */
-		if (~flags1[i] & flags2[i]) delta = true;
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD) {
+		u64b w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
 
+		/* !flag_is_subset() */
+		delta |= ~w1 & w2;
+		flag_store(flags1 + i, w1 | w2);
+	}
+	for (; i < size; i++) {
+		delta |= (bitflag) ~flags1[i] & flags2[i];
 		flags1[i] |= flags2[i];
 	}
 
-	return delta;
+	return delta != 0;
 }
 
 
@@ -335,18 +412,22 @@ bool flag_union(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-	size_t i;
-	bool delta = false;
+	size_t i = 0;
+	u64b delta = 0;
 
-	for (i = 0; i < size; i++) {
-		/* !flag_is_equal() */
-		if (!(flags1[i] == flags2[i])) delta = true;
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD) {
+		u64b w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
 
+		/* !flag_is_equal() */
+		delta |= w1 ^ w2;
+		flag_store(flags1 + i, w1 & w2);
+	}
+	for (; i < size; i++) {
+		delta |= flags1[i] ^ flags2[i];
 		flags1[i] &= flags2[i];
 	}
 
-	return delta;
-
+	return delta != 0;
 }
 
 
@@ -359,17 +440,22 @@ bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_diff(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-	size_t i;
-	bool delta = false;
+	size_t i = 0;
+	u64b delta = 0;
 
-	for (i = 0; i < size; i++) {
-		/* flag_is_inter() */
-		if (flags1[i] & flags2[i]) delta = true;
+	for (; i + FLAG_WORD <= size; i += FLAG_WORD) {
+		u64b w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
 
+		/* flag_is_inter() */
+		delta |= w1 & w2;
+		flag_store(flags1 + i, w1 & ~w2);
+	}
+	for (; i < size; i++) {
+		delta |= flags1[i] & flags2[i];
 		flags1[i] &= ~flags2[i];
 	}
 
-	return delta;
+	return delta != 0;
 }
 
 
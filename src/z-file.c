@@ -430,6 +430,41 @@ ang_file *file_open(const char *fname, file_mode mode, file_type ftype)
 }
 
 
+/**
+ * Wrap the open file descriptor 'fd', for instance standard output or one end
+ * of a pipe, in a file handle with mode 'mode'.  Closing the handle closes
+ * the descriptor.
+ * Returns file handle or NULL.
+ */
+ang_file *file_fdopen(int fd, file_mode mode)
+{
+	ang_file *f = mem_zalloc(sizeof(ang_file));
+
+	switch (mode) {
+		case MODE_WRITE:
+			f->fh = fdopen(fd, "wb");
+			break;
+		case MODE_READ:
+			f->fh = fdopen(fd, "rb");
+			break;
+		case MODE_APPEND:
+			f->fh = fdopen(fd, "a+");
+			break;
+		default:
+			assert(0);
+	}
+
+	if (f->fh == NULL) {
+		mem_free(f);
+		return NULL;
+	}
+
+	f->mode = mode;
+
+	return f;
+}
+
+
 /**
  * Close file handle 'f'.
  */
@@ -152,6 +152,14 @@ bool file_newer(const char *first, const char *second);
 ang_file *file_open(const char *buf, file_mode mode, file_type ftype);
 
 
+/**
+ * Wrap the already open file descriptor `fd` in a file handle with mode
+ * `mode`; file_close() will close the descriptor.
+ *
+ * On any kind of error, this function returns NULL.
+ */
+ang_file *file_fdopen(int fd, file_mode mode);
+
 /**
  * Platform hook for file_open.  Used to set filetypes.
  */
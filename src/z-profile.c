@@ -0,0 +1,293 @@
+/**
+ * \file z-profile.c
+ * \brief Counting and timing the busiest parts of the game
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "z-file.h"
+#include "z-profile.h"
+#include "z-util.h"
+#include "z-virt.h"
+
+static const char *zone_names[] = {
+	#define PZ(a, b) b,
+	#include "list-profile-zones.h"
+	#undef PZ
+	NULL
+};
+
+const char *profile_zone_name(enum profile_zone zone)
+{
+	assert(zone >= 0 && zone < PZ_MAX);
+	return zone_names[zone];
+}
+
+#ifdef USE_PROFILE
+
+#include <time.h>
+
+/**
+ * Number of zone timings kept for the trace; older ones are overwritten
+ */
+#define PROFILE_TRACE_MAX 65536
+
+/**
+ * One timing of a zone, in nanoseconds since profiling started
+ */
+struct profile_event {
+	u64b start;
+	u64b length;
+	byte zone;
+};
+
+static bool profiling = false;
+static u64b profile_epoch;
+static struct profile_zone_stats zone_stats[PZ_MAX];
+
+/* Where each zone is up to: how deeply it is nested, when the outermost
+ * call started and how long it has taken this turn */
+static int zone_depth[PZ_MAX];
+static u64b zone_start[PZ_MAX];
+static u64b zone_turn[PZ_MAX];
+static long zone_turn_calls[PZ_MAX];
+
+static struct profile_event *trace;
+static long trace_count;
+
+/**
+ * Get a monotonic time in nanoseconds
+ */
+static u64b profile_now(void)
+{
+#ifdef CLOCK_MONOTONIC
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u64b) ts.tv_sec * 1000000000U + (u64b) ts.tv_nsec;
+#else
+	return (u64b) clock() * (1000000000U / CLOCKS_PER_SEC);
+#endif
+}
+
+void profile_begin(enum profile_zone zone)
+{
+	if (!profiling) return;
+	zone_stats[zone].calls++;
+	zone_turn_calls[zone]++;
+
+	/* Recursive calls are timed as part of the outermost one */
+	if (zone_depth[zone]++) return;
+	zone_start[zone] = profile_now();
+}
+
+void profile_end(enum profile_zone zone)
+{
+	u64b now, length;
+	struct profile_event *event;
+
+	if (!profiling || !zone_depth[zone]) return;
+	if (--zone_depth[zone]) return;
+
+	now = profile_now();
+	length = now - zone_start[zone];
+	zone_stats[zone].total += length;
+	zone_turn[zone] += length;
+
+	event = &trace[trace_count++ % PROFILE_TRACE_MAX];
+	event->start = zone_start[zone] - profile_epoch;
+	event->length = length;
+	event->zone = zone;
+}
+
+/**
+ * Put the time each zone took this game turn into its histogram
+ */
+void profile_turn(void)
+{
+	int i;
+
+	if (!profiling) return;
+	for (i = 0; i < PZ_MAX; i++) {
+		struct profile_zone_stats *stats = &zone_stats[i];
+		u64b micro = zone_turn[i] / 1000;
+		int bucket = 0;
+
+		if (!zone_turn_calls[i]) continue;
+		while (micro > 1 && bucket < PROFILE_BUCKETS - 1) {
+			micro >>= 1;
+			bucket++;
+		}
+		stats->histogram[bucket]++;
+		stats->turns++;
+		stats->worst_turn = MAX(stats->worst_turn, zone_turn[i]);
+		zone_turn[i] = 0;
+		zone_turn_calls[i] = 0;
+	}
+}
+
+bool profile_is_enabled(void)
+{
+	return true;
+}
+
+/**
+ * Throw away what has been measured so far, and start measuring again
+ */
+void profile_start(void)
+{
+	memset(zone_stats, 0, sizeof(zone_stats));
+	memset(zone_depth, 0, sizeof(zone_depth));
+	memset(zone_turn, 0, sizeof(zone_turn));
+	memset(zone_turn_calls, 0, sizeof(zone_turn_calls));
+	if (!trace) trace = mem_alloc(PROFILE_TRACE_MAX * sizeof(*trace));
+	trace_count = 0;
+	profile_epoch = profile_now();
+	profiling = true;
+}
+
+/**
+ * Stop measuring, keeping what has been measured for reports
+ */
+void profile_stop(void)
+{
+	profiling = false;
+}
+
+bool profile_running(void)
+{
+	return profiling;
+}
+
+const struct profile_zone_stats *profile_stats(enum profile_zone zone)
+{
+	assert(zone >= 0 && zone < PZ_MAX);
+	return &zone_stats[zone];
+}
+
+/**
+ * Write the totals and per-turn histograms of every zone to a text file
+ */
+bool profile_write_report(const char *path)
+{
+	ang_file *f = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	int i, j;
+
+	if (!f) return false;
+	for (i = 0; i < PZ_MAX; i++) {
+		const struct profile_zone_stats *stats = &zone_stats[i];
+
+		file_putf(f, "%s: %ld calls on %ld turns, %ld us in all, %ld us at "
+			"most on one turn\n", zone_names[i], stats->calls, stats->turns,
+			(long) (stats->total / 1000),
+			(long) (stats->worst_turn / 1000));
+		for (j = 0; j < PROFILE_BUCKETS; j++) {
+			if (!stats->histogram[j]) continue;
+			if (j == 0) {
+				file_putf(f, "  under 2 us: %ld\n", stats->histogram[j]);
+			} else {
+				file_putf(f, "  %ld to %ld us: %ld\n", 1L << j,
+					1L << (j + 1), stats->histogram[j]);
+			}
+		}
+		file_putf(f, "\n");
+	}
+	return file_close(f);
+}
+
+/**
+ * Write the most recent zone timings as a Chrome trace (JSON), to be looked
+ * at with chrome://tracing or Perfetto
+ */
+bool profile_write_trace(const char *path)
+{
+	ang_file *f = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	long first = MAX(0, trace_count - PROFILE_TRACE_MAX), n;
+
+	if (!f) return false;
+	file_putf(f, "{\"traceEvents\":[\n");
+	for (n = first; n < trace_count; n++) {
+		const struct profile_event *event = &trace[n % PROFILE_TRACE_MAX];
+
+		file_putf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+			"\"ts\":%ld.%03ld,\"dur\":%ld.%03ld}%s\n",
+			zone_names[event->zone],
+			(long) (event->start / 1000), (long) (event->start % 1000),
+			(long) (event->length / 1000), (long) (event->length % 1000),
+			(n + 1 < trace_count) ? "," : "");
+	}
+	file_putf(f, "],\"displayTimeUnit\":\"ns\"}\n");
+	return file_close(f);
+}
+
+void profile_cleanup(void)
+{
+	profiling = false;
+	mem_free(trace);
+	trace = NULL;
+	trace_count = 0;
+}
+
+#else /* USE_PROFILE */
+
+void profile_begin(enum profile_zone zone)
+{
+}
+
+void profile_end(enum profile_zone zone)
+{
+}
+
+void profile_turn(void)
+{
+}
+
+bool profile_is_enabled(void)
+{
+	return false;
+}
+
+void profile_start(void)
+{
+}
+
+void profile_stop(void)
+{
+}
+
+bool profile_running(void)
+{
+	return false;
+}
+
+const struct profile_zone_stats *profile_stats(enum profile_zone zone)
+{
+	static const struct profile_zone_stats none;
+
+	return &none;
+}
+
+bool profile_write_report(const char *path)
+{
+	return false;
+}
+
+bool profile_write_trace(const char *path)
+{
+	return false;
+}
+
+void profile_cleanup(void)
+{
+}
+
+#endif /* USE_PROFILE */
@@ -0,0 +1,78 @@
+/**
+ * \file z-profile.h
+ * \brief Counting and timing the busiest parts of the game
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#ifndef INCLUDED_Z_PROFILE_H
+#define INCLUDED_Z_PROFILE_H
+
+#include "h-basic.h"
+
+/**
+ * The timed parts of the game
+ */
+enum profile_zone {
+	#define PZ(a, b) PZ_##a,
+	#include "list-profile-zones.h"
+	#undef PZ
+	PZ_MAX
+};
+
+/**
+ * Number of histogram buckets; bucket n counts turns on which a zone took
+ * from 2^n to 2^(n+1) microseconds, with the first and last open-ended
+ */
+#define PROFILE_BUCKETS 24
+
+/**
+ * What is known about one zone since profiling was last started
+ */
+struct profile_zone_stats {
+	long calls;			/* Times the zone was entered */
+	long turns;			/* Game turns on which it was entered */
+	u64b total;			/* Nanoseconds spent in it */
+	u64b worst_turn;	/* Most nanoseconds spent in it on one turn */
+	long histogram[PROFILE_BUCKETS];	/* Turns by time spent in it */
+};
+
+/**
+ * Zones are marked with these, which compile to nothing unless the game is
+ * built with USE_PROFILE.  Every PROFILE_BEGIN() needs a PROFILE_END() for
+ * the same zone on every way out.
+ */
+#ifdef USE_PROFILE
+#define PROFILE_BEGIN(zone) profile_begin(PZ_##zone)
+#define PROFILE_END(zone) profile_end(PZ_##zone)
+#define PROFILE_TURN() profile_turn()
+#else
+#define PROFILE_BEGIN(zone) ((void) 0)
+#define PROFILE_END(zone) ((void) 0)
+#define PROFILE_TURN() ((void) 0)
+#endif
+
+void profile_begin(enum profile_zone zone);
+void profile_end(enum profile_zone zone);
+void profile_turn(void);
+
+bool profile_is_enabled(void);
+void profile_start(void);
+void profile_stop(void);
+bool profile_running(void);
+const char *profile_zone_name(enum profile_zone zone);
+const struct profile_zone_stats *profile_stats(enum profile_zone zone);
+bool profile_write_report(const char *path);
+bool profile_write_trace(const char *path);
+void profile_cleanup(void);
+
+#endif /* !INCLUDED_Z_PROFILE_H */
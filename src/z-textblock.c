@@ -304,6 +304,41 @@ size_t textblock_calculate_lines(textblock *tb, size_t **line_starts, size_t **l
 	return total_lines;
 }
 
+/**
+ * Append one textblock to another, laid out in lines of at most `width`
+ * characters, each ending in a newline.  Text wrapped at different widths can
+ * then be kept in the one textblock and output without further wrapping.
+ *
+ * \param tb is the textblock we are appending to.
+ * \param tba is the textblock to append.
+ * \param width is the width to wrap the lines of tba at.
+ */
+void textblock_append_wrapped(textblock *tb, textblock *tba, size_t width)
+{
+	size_t *line_starts = NULL;
+	size_t *line_lengths = NULL;
+	size_t n_lines, i;
+
+	n_lines = textblock_calculate_lines(tba, &line_starts, &line_lengths,
+		width);
+	for (i = 0; i < n_lines; i++) {
+		textblock_resize_if_needed(tb, line_lengths[i] + 2);
+		(void) memcpy(tb->text + tb->strlen, tba->text + line_starts[i],
+			line_lengths[i] * sizeof(*tb->text));
+		(void) memcpy(tb->attrs + tb->strlen, tba->attrs + line_starts[i],
+			line_lengths[i]);
+		tb->strlen += line_lengths[i];
+		tb->text[tb->strlen] = L'\n';
+		tb->attrs[tb->strlen] = COLOUR_WHITE;
+		tb->strlen++;
+		tb->text[tb->strlen] = 0;
+	}
+
+	mem_free(line_starts);
+	mem_free(line_lengths);
+}
+
+
 /**
  * Output a textblock to file.
  */
@@ -40,6 +40,7 @@ const byte *textblock_attrs(textblock *tb);
 size_t textblock_calculate_lines(textblock *tb, size_t **line_starts,
 								 size_t **line_lengths, size_t width);
 
+void textblock_append_wrapped(textblock *tb, textblock *tba, size_t width);
 void textblock_to_file(textblock *tb, ang_file *f, int indent, int wrap_at);
 
 extern ang_file *text_out_file;